@@ -19,6 +19,8 @@
 
 #include "MSSA/MemRegion.h"
 
+#include <atomic>
+
 
 class MSSADEF;
 
@@ -30,8 +32,8 @@ class MRVer {
 public:
     typedef MSSADEF MSSADef;
 private:
-    /// ver ID 0 is reserved
-    static Size_t totalVERNum;
+    /// ver ID 0 is reserved, memory SSA of functions may be built in parallel
+    static std::atomic<Size_t> totalVERNum;
     const MemRegion* mr;
     VERSION version;
     MRVERID vid;
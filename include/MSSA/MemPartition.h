@@ -50,6 +50,42 @@ private:
 
 };
 
+/*!
+ * Intersections (disjoint conditional points-to sets) of a scope,
+ * with an index from each object to the intersections containing it.
+ */
+class IntersectionSet {
+public:
+    typedef MRGenerator::PointsToList PointsToList;
+    typedef std::vector<const PointsTo*> PtsPtrList;
+
+    /// All intersections in the order of PointsToList
+    inline const PointsToList& getInters() const {
+        return inters;
+    }
+    inline bool hasInter(const PointsTo& cpts) const {
+        return inters.find(cpts) != inters.end();
+    }
+
+    /// Add/remove an intersection
+    //@{
+    void addInter(const PointsTo& cpts);
+    void removeInter(const PointsTo& cpts);
+    //@}
+
+    /// Intersections sharing objects with cpts, in the order of PointsToList
+    void getIntersectingInters(const PointsTo& cpts, PtsPtrList& res) const;
+
+    /// Intersections contained in cpts, in the order of PointsToList
+    void getSubInters(const PointsTo& cpts, PtsPtrList& res) const;
+
+private:
+    typedef llvm::DenseMap<NodeID, PtsPtrList> ObjToIntersMap;
+
+    PointsToList inters;
+    ObjToIntersMap objToInters;
+};
+
 /*!
  * Create memory regions which don't have intersections with each other in the same function scope.
  */
@@ -57,7 +93,7 @@ class IntraDisjointMRG : public MRGenerator {
 public:
     typedef std::map<PointsTo, PointsToList> PtsToSubPtsMap;
     typedef std::map<const llvm::Function*, PtsToSubPtsMap> FunToPtsMap;
-    typedef std::map<const llvm::Function*, PointsToList> FunToInterMap;
+    typedef std::map<const llvm::Function*, IntersectionSet> FunToInterMap;
 
     IntraDisjointMRG(BVDataPTAImpl* p) : MRGenerator(p)
     {}
@@ -77,11 +113,11 @@ protected:
      */
     virtual inline void getMRsForLoad(MRSet& aliasMRs, const PointsTo& cpts,
                                       const llvm::Function* fun) {
-        const PointsToList& inters = getIntersList(fun);
+        const IntersectionSet& inters = getIntersList(fun);
         getMRsForLoadFromInterList(aliasMRs, cpts, inters);
     }
 
-    void getMRsForLoadFromInterList(MRSet& mrs, const PointsTo& cpts, const PointsToList& inters);
+    void getMRsForLoadFromInterList(MRSet& mrs, const PointsTo& cpts, const IntersectionSet& inters);
 
     /// Get memory regions to be inserted at a load statement.
     virtual void getMRsForCallSiteRef(MRSet& aliasMRs, const PointsTo& cpts, const llvm::Function* fun);
@@ -90,14 +126,14 @@ protected:
     void createDisjointMR(const llvm::Function* func, const PointsTo& cpts);
 
     /// Compute intersections between cpts and computed cpts intersections before.
-    void computeIntersections(const PointsTo& cpts, PointsToList& inters);
+    void computeIntersections(const PointsTo& cpts, IntersectionSet& inters);
 
 private:
     inline PtsToSubPtsMap& getPtsSubSetMap(const llvm::Function* func) {
         return funcToPtsMap[func];
     }
 
-    inline PointsToList& getIntersList(const llvm::Function* func) {
+    inline IntersectionSet& getIntersList(const llvm::Function* func) {
         return funcToInterMap[func];
     }
 
@@ -137,7 +173,7 @@ protected:
     }
 
 private:
-    PointsToList inters;
+    IntersectionSet inters;
 };
 
 #endif /* DISNCTMRGENERATOR_H_ */
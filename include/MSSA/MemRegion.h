@@ -97,6 +97,59 @@ public:
     }
 };
 
+/*!
+ * Map every inserted points-to set to its representative, a superset of it among the inserted sets.
+ * Representatives never contain each other, so an index from each object to the representatives
+ * containing it finds all subsets and supersets of a new set by counting shared objects,
+ * instead of comparing the new set against every representative.
+ */
+class RepPointsToIndex {
+public:
+    typedef std::map<PointsTo, PointsTo, MemRegion::equalPointsTo > PtsToRepPtsSetMap;
+
+    RepPointsToIndex(): emptyId(~0U), emptyRep(~0U) {}
+
+    /// Insert a set, it is mapped to an existing representative containing it,
+    /// otherwise it becomes a representative of itself and of the representatives it contains
+    void insert(const PointsTo& cpts);
+
+    /// Map every inserted set to its representative in repMap
+    void getRepPointsTo(PtsToRepPtsSetMap& repMap);
+
+    /// Release the index
+    void clear();
+
+private:
+    typedef std::map<PointsTo, u32_t, MemRegion::equalPointsTo> PtsToIdMap;
+    typedef llvm::DenseMap<NodeID, std::vector<u32_t> > ObjToRepsMap;
+
+    /// Representative of a set, the union-find root of its id
+    inline u32_t findRep(u32_t id) {
+        while (repOf[id] != id) {
+            repOf[id] = repOf[repOf[id]];
+            id = repOf[id];
+        }
+        return id;
+    }
+    inline bool isRep(u32_t id) const {
+        return repOf[id] == id;
+    }
+    /// The largest set (in the order of PtsToRepPtsSetMap) mapped to representative rep
+    inline const PointsTo& getMaxPts(u32_t rep) const {
+        return *idToPts[maxPtsOf[rep]];
+    }
+
+    PtsToIdMap ptsToIdMap;              ///< inserted sets and their ids
+    std::vector<const PointsTo*> idToPts;   ///< set of an id, the key in ptsToIdMap
+    std::vector<u32_t> sizeOf;          ///< number of objects of a set
+    std::vector<u32_t> repOf;           ///< parent in the union-find of representatives
+    std::vector<u32_t> maxPtsOf;        ///< largest set mapped to a representative
+    std::vector<u32_t> hits;            ///< objects shared by a representative and the set being inserted
+    ObjToRepsMap objToReps;             ///< representatives containing an object
+    u32_t emptyId;                      ///< id of the empty set if it is inserted
+    u32_t emptyRep;                     ///< set the empty set is mapped to, which may not be a representative
+};
+
 /*!
  * Memory Region Partitioning
  */
@@ -233,6 +286,8 @@ protected:
     MRSet memRegSet;
     /// Map a condition pts to its rep conditional pts (super set points-to)
     PtsToRepPtsSetMap cptsToRepCPtsMap;
+    /// Index finding the rep conditional pts of the cpts sorted by sortPointsTo
+    RepPointsToIndex repPtsIndex;
 
     /// Generate a memory region and put in into functions which use it
     void createMR(const llvm::Function* fun, const PointsTo& cpts);
@@ -249,7 +304,8 @@ protected:
     /// Update aliased regions for loads/stores/callsites
     virtual void updateAliasMRs();
 
-    /// Given a condition pts, insert into cptsToRepCPtsMap for region generation
+    /// Given a condition pts, insert into repPtsIndex for region generation,
+    /// cptsToRepCPtsMap is updated from the index once all cpts are sorted
     virtual void sortPointsTo(const PointsTo& cpts);
 
     /// Whether a region is aliased with a conditional points-to
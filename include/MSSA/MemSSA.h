@@ -24,6 +24,7 @@
 #include <llvm/ADT/DenseMap.h>			// for dense map
 #include <llvm/Analysis/DominanceFrontier.h>
 
+#include <atomic>
 #include <vector>
 
 class PointerAnalysis;
@@ -83,6 +84,10 @@ public:
     /// PAG edge list
     typedef PAG::PAGEdgeList PAGEdgeList;
 
+    /// Functions to build memory SSA for
+    typedef std::vector<const llvm::Function*> FunctionList;
+    typedef std::set<const llvm::Function*> FunctionSet;
+
     /// Statistics
     //@{
     static double timeOfGeneratingMemRegions;	///< Time for allocating regions
@@ -97,6 +102,11 @@ protected:
     llvm::DominanceFrontier* df;
     llvm::DominatorTree* dt;
     MemSSAStat* stat;
+    MemSSA* parent;	///< memory SSA a worker builds functions for, NULL if this is not a worker
+
+    /// Worker building the memory SSA of one function for its parent in parallel,
+    /// it shares the parent's memory regions and has its own maps and version counters
+    MemSSA(MemSSA* p);
 
     /// Create mu chi for candidate regions in a function
     virtual void createMUCHI(const llvm::Function& fun);
@@ -130,9 +140,25 @@ private:
     MRSet varKills;
     //@}
 
+    /// Functions without a reachable return, collected before workers start
+    FunctionSet noRetFuns;
+
     /// Release the memory
     void destroy();
 
+    /// Build memory SSA in parallel
+    //@{
+    /// Make sure lookups of the workers do not insert into shared maps
+    void prepareParallelBuild(const FunctionList& funs);
+    /// Main loop of a worker thread, build the next function until all are taken
+    void runWorker(const FunctionList& funs, std::vector<MemSSA*>& workers, std::atomic<u32_t>& next);
+    /// Move the mus/chis/phis built by a worker into this memory SSA
+    void mergeWorker(MemSSA* worker);
+    /// Build the functions again in sequential with the same regions and compare the mus/chis/phis
+    /// and their versions with the parallel build, return false if they differ
+    bool verifyParallelBuild(const FunctionList& funs);
+    //@}
+
     /// Get previous BB index for phi
     u32_t getPreBBIndex(const llvm::BasicBlock* bb,
                         const llvm::BasicBlock* succb);
@@ -284,6 +310,10 @@ public:
     /// We start from here
     virtual void buildMemSSA(const llvm::Function& fun,llvm::DominanceFrontier*, llvm::DominatorTree*);
 
+    /// Build memory SSA for functions using numOfThreads threads, the result is the same as
+    /// calling buildMemSSA for each of them in order
+    void buildMemSSAInParallel(const FunctionList& funs, u32_t numOfThreads);
+
     /// Perform statistics
     void performStat();
 
@@ -20,6 +20,8 @@
 #include "MSSA/SVFGNode.h"
 #include "MSSA/SVFGEdge.h"
 
+#include <atomic>
+
 class PointerAnalysis;
 class SVFGStat;
 
@@ -58,7 +60,7 @@ public:
     typedef FormalParmSVFGNode::CallPESet CallPESet;
     typedef FormalRetSVFGNode::RetPESet RetPESet;
     typedef SVFGEdge::SVFGEdgeSetTy SVFGEdgeSetTy;
-    typedef SVFGEdge::SVFGEdgeSetTy::iterator SVFGNodeIter;
+    typedef SVFGNode::iterator SVFGNodeIter;
     typedef SVFGNodeIDToNodeMapTy::iterator iterator;
     typedef SVFGNodeIDToNodeMapTy::const_iterator const_iterator;
     typedef MemSSA::MUSet MUSet;
@@ -88,6 +90,7 @@ protected:
     FunctionToFormalINsMapTy funToFormalINMap;
     FunctionToFormalOUTsMapTy funToFormalOUTMap;
     StoreNodeSet globalStore;	///< set of global store SVFG nodes
+    PointsToPool ptsPool;	///< points-to sets of indirect edges
     SVFGStat * stat;
     SVFGK kind;
     MemSSA* mssa;
@@ -113,6 +116,11 @@ public:
         return stat;
     }
 
+    /// Return the pool of points-to sets on indirect edges
+    inline const PointsToPool& getPointsToPool() const {
+        return ptsPool;
+    }
+
     /// Return PAG
     inline PAG* getPAG() {
         return PAG::getPAG();
@@ -259,6 +267,8 @@ protected:
     inline void removeSVFGEdge(SVFGEdge* edge) {
         edge->getDstNode()->removeIncomingEdge(edge);
         edge->getSrcNode()->removeOutgoingEdge(edge);
+        if (IndirectSVFGEdge* indEdge = llvm::dyn_cast<IndirectSVFGEdge>(edge))
+            indEdge->releasePointsTo(ptsPool);
         delete edge;
     }
     /// Remove a SVFGNode
@@ -290,6 +300,15 @@ protected:
         return addRetDirectVFEdge(src->getId(),dst->getId(),csId);
     }
 
+    /// Points-to of an inter indirect (call or ret) edge from src to dst, return false if they share no object
+    inline bool getInterIndirectVFPts(const MRSVFGNode* src, const MRSVFGNode* dst, PointsTo& cpts) const {
+        if (!src->getPointsTo().intersects(dst->getPointsTo()))
+            return false;
+        cpts = src->getPointsTo();
+        cpts &= dst->getPointsTo();
+        return true;
+    }
+
     /// Add inter VF edge from callsite mu to function entry chi
     SVFGEdge* addInterIndirectVFCallEdge(const ActualINSVFGNode* src, const FormalINSVFGNode* dst,CallSiteID csId);
 
@@ -423,6 +442,36 @@ protected:
     /// Connect indirect SVFG edges from global initializers (store) to main function entry
     void connectFromGlobalToProgEntry();
 
+    /*!
+     * An edge found when connecting the SVFG. The edges of every node are collected
+     * first (possibly by several threads), then added to the graph in node order.
+     */
+    struct PendingVFEdge {
+        PendingVFEdge(SVFGEdge::SVFGEdgeK k, NodeID s, NodeID d, CallSiteID cs = 0, const PointsTo* pts = NULL):
+            kind(k), src(s), dst(d), csId(cs), mrPts(pts) {}
+        SVFGEdge::SVFGEdgeK kind;
+        NodeID src;
+        NodeID dst;
+        CallSiteID csId;
+        const PointsTo* mrPts;	///< points-to of the memory region of an intra indirect edge
+        PointsTo cpts;		///< points-to of an inter indirect edge
+    };
+    typedef std::vector<PendingVFEdge> PendingVFEdgeList;
+    typedef std::vector<const SVFGNode*> SVFGNodeList;
+    typedef void (SVFG::*VFEdgeCollector)(const SVFGNode* node, PendingVFEdgeList& edges) const;
+
+    /// Collect the edges from the definitions of a node, they only read the graph and memory SSA
+    //@{
+    void collectDirectVFEdges(const SVFGNode* node, PendingVFEdgeList& edges) const;
+    void collectIndirectVFEdges(const SVFGNode* node, PendingVFEdgeList& edges) const;
+    //@}
+    /// Collect the edges of nodes[i] into edgeLists[i] by svfg-threads threads
+    void collectVFEdges(const SVFGNodeList& nodes, std::vector<PendingVFEdgeList>& edgeLists, VFEdgeCollector collector) const;
+    void collectVFEdgesWorker(const SVFGNodeList& nodes, std::vector<PendingVFEdgeList>& edgeLists,
+                              VFEdgeCollector collector, std::atomic<u32_t>& next) const;
+    /// Add the collected edges to the graph
+    void addPendingVFEdges(const PendingVFEdgeList& edges);
+
     inline bool isPhiCopyEdge(const CopyPE* copy) const {
         return mssa->getPAG()->isPhiNode(copy->getDstNode());
     }
@@ -442,38 +491,38 @@ protected:
     /// Add Dummy SVFG node for null pointer definition
     /// To be noted for black hole pointer it has already has address edge connected
     inline void addNullPtrSVFGNode(const PAGNode* pagNode) {
-        NullPtrSVFGNode* sNode = new NullPtrSVFGNode(totalSVFGNode++,pagNode);
+        NullPtrSVFGNode* sNode = new (arena) NullPtrSVFGNode(totalSVFGNode++,pagNode);
         addSVFGNode(sNode);
         setDef(pagNode,sNode);
     }
     /// Add Address SVFG node
     inline void addAddrSVFGNode(const AddrPE* addr) {
-        AddrSVFGNode* sNode = new AddrSVFGNode(totalSVFGNode++,addr);
+        AddrSVFGNode* sNode = new (arena) AddrSVFGNode(totalSVFGNode++,addr);
         addStmtSVFGNode(sNode);
         setDef(addr->getDstNode(),sNode);
     }
     /// Add Copy SVFG node
     inline void addCopySVFGNode(const CopyPE* copy) {
-        CopySVFGNode* sNode = new CopySVFGNode(totalSVFGNode++,copy);
+        CopySVFGNode* sNode = new (arena) CopySVFGNode(totalSVFGNode++,copy);
         addStmtSVFGNode(sNode);
         setDef(copy->getDstNode(),sNode);
     }
     /// Add Gep SVFG node
     inline void addGepSVFGNode(const GepPE* gep) {
-        GepSVFGNode* sNode = new GepSVFGNode(totalSVFGNode++,gep);
+        GepSVFGNode* sNode = new (arena) GepSVFGNode(totalSVFGNode++,gep);
         addStmtSVFGNode(sNode);
         setDef(gep->getDstNode(),sNode);
     }
     /// Add Load SVFG node
     void addLoadSVFGNode(LoadPE* load) {
-        LoadSVFGNode* sNode = new LoadSVFGNode(totalSVFGNode++,load);
+        LoadSVFGNode* sNode = new (arena) LoadSVFGNode(totalSVFGNode++,load);
         addStmtSVFGNode(sNode);
         setDef(load->getDstNode(),sNode);
     }
     /// Add Store SVFG node,
     /// To be noted store does not create a new pointer, we do not set def for any PAG node
     void addStoreSVFGNode(StorePE* store) {
-        StoreSVFGNode* sNode = new StoreSVFGNode(totalSVFGNode++,store);
+        StoreSVFGNode* sNode = new (arena) StoreSVFGNode(totalSVFGNode++,store);
         addStmtSVFGNode(sNode);
         for(CHISet::iterator pi = mssa->getCHISet(store).begin(), epi = mssa->getCHISet(store).end(); pi!=epi; ++pi) {
             setDef((*pi)->getResVer(),sNode);
@@ -487,14 +536,14 @@ protected:
     /// To be noted that multiple actual parameters may have same value (PAGNode)
     /// So we need to make a pair <PAGNodeID,CallSiteID> to find the right SVFGParmNode
     inline void addActualParmSVFGNode(const PAGNode* aparm, llvm::CallSite cs) {
-        ActualParmSVFGNode* sNode = new ActualParmSVFGNode(totalSVFGNode++,aparm,cs);
+        ActualParmSVFGNode* sNode = new (arena) ActualParmSVFGNode(totalSVFGNode++,aparm,cs);
         addSVFGNode(sNode);
         PAGNodeToActualParmMap[std::make_pair(aparm->getId(),cs)] = sNode;
         /// do not set def here, this node is not a variable definition
     }
     /// Add formal parameter SVFG node
     inline void addFormalParmSVFGNode(const PAGNode* fparm, const llvm::Function* fun, CallPESet& callPEs) {
-        FormalParmSVFGNode* sNode = new FormalParmSVFGNode(totalSVFGNode++,fparm,fun);
+        FormalParmSVFGNode* sNode = new (arena) FormalParmSVFGNode(totalSVFGNode++,fparm,fun);
         addSVFGNode(sNode);
         for(CallPESet::const_iterator it = callPEs.begin(), eit=callPEs.end();
                 it!=eit; ++it)
@@ -507,7 +556,7 @@ protected:
     /// To be noted that here we assume returns of a procedure have already been unified into one
     /// Otherwise, we need to handle formalRet using <PAGNodeID,CallSiteID> pair to find FormalRetSVFG node same as handling actual parameters
     inline void addFormalRetSVFGNode(const PAGNode* ret, const llvm::Function* fun, RetPESet& retPEs) {
-        FormalRetSVFGNode* sNode = new FormalRetSVFGNode(totalSVFGNode++,ret,fun);
+        FormalRetSVFGNode* sNode = new (arena) FormalRetSVFGNode(totalSVFGNode++,ret,fun);
         addSVFGNode(sNode);
         for(RetPESet::const_iterator it = retPEs.begin(), eit=retPEs.end();
                 it!=eit; ++it)
@@ -518,14 +567,14 @@ protected:
     }
     /// Add callsite Receive SVFG node
     inline void addActualRetSVFGNode(const PAGNode* ret,llvm::CallSite cs) {
-        ActualRetSVFGNode* sNode = new ActualRetSVFGNode(totalSVFGNode++,ret,cs);
+        ActualRetSVFGNode* sNode = new (arena) ActualRetSVFGNode(totalSVFGNode++,ret,cs);
         addSVFGNode(sNode);
         setDef(ret,sNode);
         PAGNodeToActualRetMap[ret] = sNode;
     }
     /// Add llvm PHI SVFG node
     inline void addIntraPHISVFGNode(const PAGNode* phiResNode, PAG::PNodeBBPairList& oplist) {
-        IntraPHISVFGNode* sNode = new IntraPHISVFGNode(totalSVFGNode++,phiResNode);
+        IntraPHISVFGNode* sNode = new (arena) IntraPHISVFGNode(totalSVFGNode++,phiResNode);
         addSVFGNode(sNode);
         u32_t pos = 0;
         for(PAG::PNodeBBPairList::const_iterator it = oplist.begin(), eit=oplist.end(); it!=eit; ++it,++pos)
@@ -534,33 +583,33 @@ protected:
     }
     /// Add memory Function entry chi SVFG node
     inline void addFormalINSVFGNode(const MemSSA::ENTRYCHI* chi) {
-        FormalINSVFGNode* sNode = new FormalINSVFGNode(totalSVFGNode++,chi);
+        FormalINSVFGNode* sNode = new (arena) FormalINSVFGNode(totalSVFGNode++,chi);
         addSVFGNode(sNode);
         setDef(chi->getResVer(),sNode);
         funToFormalINMap[chi->getFunction()].set(sNode->getId());
     }
     /// Add memory Function return mu SVFG node
     inline void addFormalOUTSVFGNode(const MemSSA::RETMU* mu) {
-        FormalOUTSVFGNode* sNode = new FormalOUTSVFGNode(totalSVFGNode++,mu);
+        FormalOUTSVFGNode* sNode = new (arena) FormalOUTSVFGNode(totalSVFGNode++,mu);
         addSVFGNode(sNode);
         funToFormalOUTMap[mu->getFunction()].set(sNode->getId());
     }
     /// Add memory callsite mu SVFG node
     inline void addActualINSVFGNode(const MemSSA::CALLMU* mu) {
-        ActualINSVFGNode* sNode = new ActualINSVFGNode(totalSVFGNode++,mu, mu->getCallSite());
+        ActualINSVFGNode* sNode = new (arena) ActualINSVFGNode(totalSVFGNode++,mu, mu->getCallSite());
         addSVFGNode(sNode);
         callSiteToActualINMap[mu->getCallSite()].set(sNode->getId());
     }
     /// Add memory callsite chi SVFG node
     inline void addActualOUTSVFGNode(const MemSSA::CALLCHI* chi) {
-        ActualOUTSVFGNode* sNode = new ActualOUTSVFGNode(totalSVFGNode++,chi,chi->getCallSite());
+        ActualOUTSVFGNode* sNode = new (arena) ActualOUTSVFGNode(totalSVFGNode++,chi,chi->getCallSite());
         addSVFGNode(sNode);
         setDef(chi->getResVer(),sNode);
         callSiteToActualOUTMap[chi->getCallSite()].set(sNode->getId());
     }
     /// Add memory SSA PHI SVFG node
     inline void addIntraMSSAPHISVFGNode(const MemSSA::PHI* phi) {
-        IntraMSSAPHISVFGNode* sNode = new IntraMSSAPHISVFGNode(totalSVFGNode++,phi);
+        IntraMSSAPHISVFGNode* sNode = new (arena) IntraMSSAPHISVFGNode(totalSVFGNode++,phi);
         addSVFGNode(sNode);
         for(MemSSA::PHI::OPVers::const_iterator it = phi->opVerBegin(), eit=phi->opVerEnd(); it!=eit; ++it)
             sNode->setOpVer(it->first,it->second);
@@ -19,6 +19,7 @@
 
 
 #include "MSSA/MemSSA.h"
+#include "Util/PointsToPool.h"
 
 class SVFGNode;
 
@@ -26,7 +27,7 @@ class SVFGNode;
  * Sparse Value Flow Graph Edge, representing the value-flow dependence between two SVFG nodes
  */
 typedef GenericEdge<SVFGNode> GenericSVFGEdgeTy;
-class SVFGEdge : public GenericSVFGEdgeTy {
+class SVFGEdge : public GenericSVFGEdgeTy, public GraphArenaObject {
 
 public:
     /// seven kinds of SVFG edge
@@ -211,26 +212,31 @@ public:
     typedef std::set<const MRVer*> MRVerSet;
 private:
     MRVerSet mrs;
-    PointsTo cpts;
+    PointsToPool::Handle cpts;	///< interned in the pool of the SVFG, shared with other edges
 public:
     /// Constructor
-    IndirectSVFGEdge(SVFGNode* s, SVFGNode* d, GEdgeFlag k): SVFGEdge(s,d,k) {
+    IndirectSVFGEdge(SVFGNode* s, SVFGNode* d, GEdgeFlag k): SVFGEdge(s,d,k), cpts(NULL) {
     }
     /// Handle memory region
     //@{
-    inline bool addPointsTo(const PointsTo& c) {
-        return (cpts |= c);
+    inline bool addPointsTo(const PointsTo& c, PointsToPool& pool) {
+        return pool.add(cpts, c);
     }
     inline const PointsTo& getPointsTo() const {
-        return cpts;
+        return PointsToPool::getPointsTo(cpts);
+    }
+    /// Drop the points-to set before the edge is removed from the graph
+    inline void releasePointsTo(PointsToPool& pool) {
+        pool.release(cpts);
+        cpts = NULL;
     }
 
     inline MRVerSet& getMRVer() {
         return mrs;
     }
-    inline bool addMrVer(const MRVer* mr) {
+    inline bool addMrVer(const MRVer* mr, PointsToPool& pool) {
         // collect memory regions' pts to edge;
-        cpts |= mr->getMR()->getPointsTo();
+        pool.add(cpts, mr->getMR()->getPointsTo());
         return mrs.insert(mr).second;
     }
     //@}
@@ -26,7 +26,7 @@
  * including top-level pointers (ValPN) and address-taken objects (ObjPN)
  */
 typedef GenericNode<SVFGNode,SVFGEdge> GenericSVFGNodeTy;
-class SVFGNode : public GenericSVFGNodeTy {
+class SVFGNode : public GenericSVFGNodeTy, public GraphArenaObject {
 
 public:
     /// five kinds of SVFG node
@@ -37,8 +37,8 @@ public:
         AParm, APIN, APOUT, FParm, FPIN, FPOUT, NPtr
     };
 
-    typedef SVFGEdge::SVFGEdgeSetTy::iterator iterator;
-    typedef SVFGEdge::SVFGEdgeSetTy::const_iterator const_iterator;
+    typedef GenericSVFGNodeTy::iterator iterator;
+    typedef GenericSVFGNodeTy::const_iterator const_iterator;
     typedef std::set<const CallPE*> CallPESet;
     typedef std::set<const RetPE*> RetPESet;
 
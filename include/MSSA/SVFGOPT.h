@@ -255,14 +255,14 @@ private:
 
     /// Add inter PHI SVFG node for formal parameter
     inline InterPHISVFGNode* addInterPHIForFP(const FormalParmSVFGNode* fp) {
-        InterPHISVFGNode* sNode = new InterPHISVFGNode(totalSVFGNode++,fp);
+        InterPHISVFGNode* sNode = new (arena) InterPHISVFGNode(totalSVFGNode++,fp);
         addSVFGNode(sNode);
         resetDef(fp->getParam(),sNode);
         return sNode;
     }
     /// Add inter PHI SVFG node for actual return
     inline InterPHISVFGNode* addInterPHIForAR(const ActualRetSVFGNode* ar) {
-        InterPHISVFGNode* sNode = new InterPHISVFGNode(totalSVFGNode++,ar);
+        InterPHISVFGNode* sNode = new (arena) InterPHISVFGNode(totalSVFGNode++,ar);
         addSVFGNode(sNode);
         resetDef(ar->getRev(),sNode);
         return sNode;
@@ -334,14 +334,18 @@ private:
         removeInEdges(node);
         removeOutEdges(node);
     }
+    /// Edges are collected first and removed from the back of the node's sorted edge set,
+    /// so that no removal shifts the edges left in it
     inline void removeInEdges(const SVFGNode* node) {
         /// remove incoming edges
-        while (node->hasIncomingEdge())
-            removeSVFGEdge(*(node->InEdgeBegin()));
+        std::vector<SVFGEdge*> edges(node->InEdgeBegin(), node->InEdgeEnd());
+        for (std::vector<SVFGEdge*>::reverse_iterator it = edges.rbegin(), eit = edges.rend(); it != eit; ++it)
+            removeSVFGEdge(*it);
     }
     inline void removeOutEdges(const SVFGNode* node) {
-        while (node->hasOutgoingEdge())
-            removeSVFGEdge(*(node->OutEdgeBegin()));
+        std::vector<SVFGEdge*> edges(node->OutEdgeBegin(), node->OutEdgeEnd());
+        for (std::vector<SVFGEdge*>::reverse_iterator it = edges.rbegin(), eit = edges.rend(); it != eit; ++it)
+            removeSVFGEdge(*it);
     }
     //@}
 
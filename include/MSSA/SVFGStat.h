@@ -64,7 +64,7 @@ public:
     }
     virtual void performStat();
 
-    virtual void printStat();
+    virtual void printStat(std::string statname = "Stat");
 
 private:
     MemSSA* mssa;
@@ -86,7 +86,7 @@ public:
 
     virtual void performStat();
 
-    virtual void printStat();
+    virtual void printStat(std::string statname = "Stat");
 
     virtual void performSCCStat(SVFGEdgeSet insensitiveCalRetEdges);
 
@@ -98,6 +98,11 @@ public:
         connectDirSVFGEdgeTimeEnd = CLOCK_IN_MS();
     }
 
+    /// Edges of every node have been collected, the rest of the phase adds them to the graph
+    void dirVFEdgeCollected() {
+        collectDirSVFGEdgeTimeEnd = CLOCK_IN_MS();
+    }
+
     void indVFEdgeStart() {
         connectIndSVFGEdgeTimeStart = CLOCK_IN_MS();
     }
@@ -106,6 +111,10 @@ public:
         connectIndSVFGEdgeTimeEnd = CLOCK_IN_MS();
     }
 
+    void indVFEdgeCollected() {
+        collectIndSVFGEdgeTimeEnd = CLOCK_IN_MS();
+    }
+
     void TLVFNodeStart() {
         addTopLevelNodeTimeStart = CLOCK_IN_MS();
     }
@@ -194,9 +203,11 @@ private:
 
     double connectDirSVFGEdgeTimeStart;
     double connectDirSVFGEdgeTimeEnd;
+    double collectDirSVFGEdgeTimeEnd;
 
     double connectIndSVFGEdgeTimeStart;
     double connectIndSVFGEdgeTimeEnd;
+    double collectIndSVFGEdgeTimeEnd;
 
     double svfgOptTimeStart;
     double svfgOptTimeEnd;
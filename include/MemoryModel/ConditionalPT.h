@@ -531,10 +531,10 @@ public:
                     if (lpts.count() < rpts.count())
                         return true;
                     else if (lpts.count() == rpts.count()) {
-                        llvm::SparseBitVector<>::iterator bit = lpts.begin();
-                        llvm::SparseBitVector<>::iterator eit = lpts.end();
-                        llvm::SparseBitVector<>::iterator rbit = rpts.begin();
-                        llvm::SparseBitVector<>::iterator reit = rpts.end();
+                        PointsTo::iterator bit = lpts.begin();
+                        PointsTo::iterator eit = lpts.end();
+                        PointsTo::iterator rbit = rpts.begin();
+                        PointsTo::iterator reit = rpts.end();
                         for (; bit != eit && rbit != reit; bit++, rbit++) {
                             if (*bit < *rbit)
                                 return true;
@@ -596,7 +596,7 @@ public:
         for (; it != eit; it++) {
             const PointsTo& pts = it->second;
             str += "pts{";
-            for (llvm::SparseBitVector<>::iterator ii = pts.begin(), ie = pts.end();
+            for (PointsTo::iterator ii = pts.begin(), ie = pts.end();
                     ii != ie; ii++) {
                 char int2str[16];
                 sprintf(int2str, "%d", *ii);
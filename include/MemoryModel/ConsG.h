@@ -29,14 +29,20 @@ class ConstraintGraph :  public GenericGraph<ConstraintNode,ConstraintEdge> {
 
 public:
     typedef llvm::DenseMap<NodeID, ConstraintNode *> ConstraintNodeIDToNodeMapTy;
-    typedef ConstraintEdge::ConstraintEdgeSetTy::iterator ConstraintNodeIter;
-    typedef llvm::DenseMap<NodeID, NodeID> NodeToRepMap;
-    typedef llvm::DenseMap<NodeID, NodeBS> NodeToSubsMap;
-    typedef FIFOWorkList<NodeID> WorkList;
+    typedef ConstraintNode::iterator ConstraintNodeIter;
+    typedef DenseFIFOWorkList<NodeID> WorkList;
+    typedef std::vector<NodePair> NodePairVector;
 private:
     PAG*pag;
-    NodeToRepMap nodeToRepMap;
-    NodeToSubsMap nodeToSubsMap;
+
+    /// Merged nodes form disjoint sets kept by union-find, indexed by NodeID.
+    /// A node not covered by the arrays has not been merged with any other node.
+    //@{
+    std::vector<NodeID> repParent;	///< parent in the union-find tree, a root is its own parent
+    std::vector<unsigned char> repRank;	///< rank of a root
+    std::vector<NodeID> rootToRep;	///< rep node of the set of a root, chosen by setRep()
+    std::vector<NodeID> nextSubNode;	///< nodes of a set are linked in a circle
+    //@}
 
     ConstraintEdge::ConstraintEdgeSetTy AddrCGEdgeSet;
     ConstraintEdge::ConstraintEdgeSetTy directEdgeSet;
@@ -47,8 +53,32 @@ private:
 
     WorkList nodesToBeCollapsed;
 
+    bool recordNewDirectEdges;	///< whether to record direct edges added
+    NodePairVector newDirectEdges;	///< direct edges added since the last clearNewDirectEdges
+
     void buildCG();
 
+    /// Record a direct edge added, if asked for
+    inline void addNewDirectEdge(NodeID src, NodeID dst) {
+        if (recordNewDirectEdges)
+            newDirectEdges.push_back(std::make_pair(src, dst));
+    }
+
+    /// Union-find helpers
+    //@{
+    /// Root of the set of id. Paths are not compressed here so that lookups
+    /// have no side effect, union by rank keeps them logarithmic.
+    inline NodeID findRepRoot(NodeID id) const {
+        while (repParent[id] != id)
+            id = repParent[id];
+        return id;
+    }
+    /// Root of the set of id, pointing every node on the way directly to the root
+    NodeID compressRepPath(NodeID id);
+    /// Make the arrays cover node id
+    void growRepArrays(NodeID id);
+    //@}
+
     void destroy();
 
     /// Wappers used internally, not expose to Andernsen Pass
@@ -68,7 +98,7 @@ private:
 
 public:
     /// Constructor
-    ConstraintGraph(PAG* p): pag(p), edgeIndex(0) {
+    ConstraintGraph(PAG* p): pag(p), edgeIndex(0), recordNewDirectEdges(false) {
         buildCG();
     }
     /// Destructor
@@ -110,6 +140,27 @@ public:
         return false;
     }
 
+    /// Return the edge of src, dst and kind, NULL if there is no such edge
+    inline ConstraintEdge* getEdge(ConstraintNode* src, ConstraintNode* dst, ConstraintEdge::ConstraintEdgeK kind) {
+        ConstraintEdge edge(src,dst,kind);
+        ConstraintEdge::ConstraintEdgeSetTy* edgeSet;
+        if(kind == ConstraintEdge::Copy ||
+                kind == ConstraintEdge::NormalGep || kind == ConstraintEdge::VariantGep)
+            edgeSet = &directEdgeSet;
+        else if(kind == ConstraintEdge::Addr)
+            edgeSet = &AddrCGEdgeSet;
+        else if(kind == ConstraintEdge::Store)
+            edgeSet = &StoreCGEdgeSet;
+        else if(kind == ConstraintEdge::Load)
+            edgeSet = &LoadCGEdgeSet;
+        else {
+            assert(false && "no other kind!");
+            return NULL;
+        }
+        ConstraintEdge::ConstraintEdgeSetTy::const_iterator it = edgeSet->find(&edge);
+        return it == edgeSet->end() ? NULL : *it;
+    }
+
     ///Add a PAG edge into Edge map
     //@{
     /// Add Address edge
@@ -164,23 +215,26 @@ public:
     /// SCC rep/sub nodes methods
     //@{
     inline NodeID sccRepNode(NodeID id) const {
-        NodeToRepMap::const_iterator it = nodeToRepMap.find(id);
-        if(it==nodeToRepMap.end())
+        if (id >= repParent.size())
             return id;
-        else
-            return it->second;
-    }
-    inline NodeBS& sccSubNodes(NodeID id) {
-        if(0==nodeToSubsMap.count(id))
-            nodeToSubsMap[id].set(id);
-        return nodeToSubsMap[id];
-    }
-    inline void setRep(NodeID node, NodeID rep) {
-        nodeToRepMap[node] = rep;
-    }
-    inline void setSubs(NodeID node, NodeBS& subs) {
-        nodeToSubsMap[node] |= subs;
-    }
+        return rootToRep[findRepRoot(id)];
+    }
+    /// All nodes merged with id, including id itself
+    inline NodeBS sccSubNodes(NodeID id) const {
+        NodeBS subs;
+        subs.set(id);
+        if (id < nextSubNode.size()) {
+            for (NodeID sub = nextSubNode[id]; sub != id; sub = nextSubNode[sub])
+                subs.set(sub);
+        }
+        return subs;
+    }
+    /// Whether any other node has been merged with id
+    inline bool hasSubNodes(NodeID id) const {
+        return id < nextSubNode.size() && nextSubNode[id] != id;
+    }
+    /// Merge node and all nodes merged with it into the set of rep, whose rep node stays
+    void setRep(NodeID node, NodeID rep);
     //@}
 
     /// Move incoming direct edges of a sub node which is outside the SCC to its rep node
@@ -201,6 +255,28 @@ public:
         return (gepIn || gepOut);
     }
 
+    /// Direct edges added, used to update SCCs incrementally
+    //@{
+    inline void setRecordNewDirectEdges(bool record) {
+        recordNewDirectEdges = record;
+        newDirectEdges.clear();
+    }
+    inline const NodePairVector& getNewDirectEdges() const {
+        return newDirectEdges;
+    }
+    inline void clearNewDirectEdges() {
+        newDirectEdges.clear();
+    }
+    /// Return true if src and dst are connected by a copy or gep edge
+    inline bool hasDirectEdge(NodeID src, NodeID dst) {
+        ConstraintNode* srcNode = getConstraintNode(src);
+        ConstraintNode* dstNode = getConstraintNode(dst);
+        return hasEdge(srcNode, dstNode, ConstraintEdge::Copy)
+               || hasEdge(srcNode, dstNode, ConstraintEdge::NormalGep)
+               || hasEdge(srcNode, dstNode, ConstraintEdge::VariantGep);
+    }
+    //@}
+
     /// Parameter passing
     void connectCaller2CalleeParams(llvm::CallSite cs, const llvm::Function *F, NodePairSet& cpySrcNodes);
 
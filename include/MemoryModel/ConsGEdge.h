@@ -33,7 +33,7 @@ class ConstraintNode;
  * including add/remove/re-target, but all the operations do not affect original PAG Edges
  */
 typedef GenericEdge<ConstraintNode> GenericConsEdgeTy;
-class ConstraintEdge : public GenericConsEdgeTy {
+class ConstraintEdge : public GenericConsEdgeTy, public GraphArenaObject {
 
 public:
     /// five kinds of constraint graph edges
@@ -24,24 +24,25 @@ typedef GenericNode<ConstraintNode,ConstraintEdge> GenericConsNodeTy;
 class ConstraintNode : public GenericConsNodeTy {
 
 public:
-    typedef ConstraintEdge::ConstraintEdgeSetTy::iterator iterator;
-    typedef ConstraintEdge::ConstraintEdgeSetTy::const_iterator const_iterator;
+    typedef GenericConsNodeTy::GNodeEdgeSetTy ConstraintEdgeSetTy;
+    typedef GenericConsNodeTy::iterator iterator;
+    typedef GenericConsNodeTy::const_iterator const_iterator;
 private:
     bool _isPWCNode;
 
-    ConstraintEdge::ConstraintEdgeSetTy loadInEdges; ///< all incoming load edge of this node
-    ConstraintEdge::ConstraintEdgeSetTy loadOutEdges; ///< all outgoing load edge of this node
+    ConstraintEdgeSetTy loadInEdges; ///< all incoming load edge of this node
+    ConstraintEdgeSetTy loadOutEdges; ///< all outgoing load edge of this node
 
-    ConstraintEdge::ConstraintEdgeSetTy storeInEdges; ///< all incoming store edge of this node
-    ConstraintEdge::ConstraintEdgeSetTy storeOutEdges; ///< all outgoing store edge of this node
+    ConstraintEdgeSetTy storeInEdges; ///< all incoming store edge of this node
+    ConstraintEdgeSetTy storeOutEdges; ///< all outgoing store edge of this node
 
     /// Copy/call/ret/gep incoming edge of this node,
     /// To be noted: this set is only used when SCC detection, and node merges
-    ConstraintEdge::ConstraintEdgeSetTy directInEdges;
-    ConstraintEdge::ConstraintEdgeSetTy directOutEdges;
+    ConstraintEdgeSetTy directInEdges;
+    ConstraintEdgeSetTy directOutEdges;
 
-    ConstraintEdge::ConstraintEdgeSetTy addressInEdges; ///< all incoming address edge of this node
-    ConstraintEdge::ConstraintEdgeSetTy addressOutEdges; ///< all outgoing address edge of this node
+    ConstraintEdgeSetTy addressInEdges; ///< all incoming address edge of this node
+    ConstraintEdgeSetTy addressOutEdges; ///< all outgoing address edge of this node
 
 public:
 
@@ -95,10 +96,10 @@ public:
         return directInEdges.end();
     }
 
-    ConstraintEdge::ConstraintEdgeSetTy& incomingAddrEdges() {
+    ConstraintEdgeSetTy& incomingAddrEdges() {
         return addressInEdges;
     }
-    ConstraintEdge::ConstraintEdgeSetTy& outgoingAddrEdges() {
+    ConstraintEdgeSetTy& outgoingAddrEdges() {
         return addressOutEdges;
     }
 
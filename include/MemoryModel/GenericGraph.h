@@ -18,6 +18,8 @@
 #define GENERICGRAPH_H_
 
 #include "Util/AnalysisUtil.h"
+#include "Util/SortedVectorSet.h"
+#include "Util/GraphArena.h"
 #include <llvm/ADT/STLExtras.h>			// for mapped_iter
 
 
@@ -110,18 +112,20 @@ public:
     /// Edge kind
     typedef s32_t GNodeK;
     typedef std::set<EdgeType*, typename GenericEdge<NodeType>::equalGEdge> GEdgeSetTy;
+    /// Edges of a node are kept in a sorted vector, which is compact and fast to iterate
+    typedef SortedVectorSet<EdgeType*, typename GenericEdge<NodeType>::equalGEdge> GNodeEdgeSetTy;
     /// Edge iterator
     ///@{
-    typedef typename GEdgeSetTy::iterator iterator;
-    typedef typename GEdgeSetTy::const_iterator const_iterator;
+    typedef typename GNodeEdgeSetTy::iterator iterator;
+    typedef typename GNodeEdgeSetTy::const_iterator const_iterator;
     ///@}
 
 private:
     NodeID id;		///< Node ID
     GNodeK nodeKind;	///< Node kind
 
-    GEdgeSetTy InEdges; ///< all incoming edge of this node
-    GEdgeSetTy OutEdges; ///< all outgoing edge of this node
+    GNodeEdgeSetTy InEdges; ///< all incoming edge of this node
+    GNodeEdgeSetTy OutEdges; ///< all outgoing edge of this node
 
 public:
     /// Constructor
@@ -147,10 +151,10 @@ public:
 
     /// Get incoming/outgoing edge set
     ///@{
-    inline const GEdgeSetTy& getOutEdges() const {
+    inline const GNodeEdgeSetTy& getOutEdges() const {
         return OutEdges;
     }
-    inline const GEdgeSetTy& getInEdges() const {
+    inline const GNodeEdgeSetTy& getInEdges() const {
         return InEdges;
     }
     ///@}
@@ -361,8 +365,14 @@ public:
         edgeNum++;
     }
 
+    /// Arena of the nodes and edges of this graph allocated as GraphArenaObject
+    inline GraphArena& getArena() {
+        return arena;
+    }
+
 protected:
     IDToNodeMapTy IDToNodeMap; ///< node map
+    GraphArena arena; ///< released after all nodes are deleted in the destructor
 
 public:
     Size_t edgeNum;		///< total num of node
@@ -433,6 +443,12 @@ struct GraphTraits<Inverse<GenericNode<NodeTy,EdgeTy>* > > {
     static inline ChildIteratorType child_end(const NodeType* N) {
         return map_iterator(N->InEdgeEnd(), DerefEdge(edgeDereference));
     }
+    static inline ChildIteratorType direct_child_begin(const NodeType *N) {
+        return map_iterator(N->directInEdgeBegin(), DerefEdge(edgeDereference));
+    }
+    static inline ChildIteratorType direct_child_end(const NodeType *N) {
+        return map_iterator(N->directInEdgeEnd(), DerefEdge(edgeDereference));
+    }
 
     static inline NodeType* edgeDereference(EdgeType* edge) {
         return edge->getSrcNode();
@@ -154,6 +154,9 @@ public:
 
     void addElemNumStridePair(const NodePair& pair);
 
+    /// Options of the location sets, part of the keys of results cached on disk
+    static std::string getOptionKey();
+
     /// Return TRUE if this is a constant location set.
     inline bool isConstantOffset() const {
         return (numStridePair.size() == 0);
@@ -408,6 +408,9 @@ public:
     }
     //@}
 
+    /// Options of the memory model, part of the keys of results cached on disk
+    static std::string getOptionKey();
+
     /// Singleton design here to make sure we only have one instance during any analysis
     //@{
     static SymbolTableInfo* Symbolnfo();
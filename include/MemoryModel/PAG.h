@@ -27,6 +27,7 @@
  * SymID and NodeID are equal here (same numbering).
  */
 class PAG : public GenericGraph<PAGNode,PAGEdge> {
+    friend class PAGSnapshot;
 
 public:
     typedef std::set<llvm::CallSite> CallSiteSet;
@@ -121,6 +122,9 @@ public:
     }
     //@}
 
+    /// Options of PAG construction and of the memory model, part of the keys of results cached on disk
+    static std::string getOptionKey();
+
     /// Destructor
     virtual ~PAG() {
         destroy();
@@ -386,6 +390,10 @@ public:
     inline NodeID getFIObjNode(const MemObj* obj) const {
         return obj->getSymId();
     }
+    /// Whether the field object of base at ls has been created, ls must be reduced by getModulusOffset
+    inline bool hasGepObjNode(NodeID base, const LocationSet& ls) const {
+        return GepObjNodeMap.find(std::make_pair(base, ls)) != GepObjNodeMap.end();
+    }
     inline NodeID getFIObjNode(NodeID id) const {
         PAGNode* node = pag->getPAGNode(id);
         assert(llvm::isa<ObjPN>(node) && "need an object node");
@@ -49,6 +49,7 @@ public:
     /// Initialize nodes and edges
     //@{
     void initalNode();
+    void addSymbolNodes();
     void addEdge(NodeID src, NodeID dst, PAGEdge::PEDGEK kind,
                  Size_t offset = 0, llvm::Instruction* cs = NULL);
     // @}
@@ -33,7 +33,7 @@ class PAGNode;
  * PAG edge between nodes
  */
 typedef GenericEdge<PAGNode> GenericPAGEdgeTy;
-class PAGEdge : public GenericPAGEdgeTy {
+class PAGEdge : public GenericPAGEdgeTy, public GraphArenaObject {
 
 public:
     /// Ten kinds of PAG edges
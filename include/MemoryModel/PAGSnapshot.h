@@ -0,0 +1,73 @@
+//===- PAGSnapshot.h -- Binary snapshot of PAG--------------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PAGSnapshot.h
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  A PAG is saved as fixed-size records (nodes, edges, phis, and function/callsite
+ *  argument and return maps) into <cache dir>/<module hash>.pag, together with the
+ *  memory model options it was built with. A later run on the same module with the
+ *  same options maps the file into memory and rebuilds the PAG from the records
+ *  instead of visiting the IR.
+ */
+
+#ifndef PAGSNAPSHOT_H_
+#define PAGSNAPSHOT_H_
+
+#include "MemoryModel/PAG.h"
+
+class PAGSnapshot {
+
+public:
+    typedef llvm::DenseMap<const llvm::Value*, u32_t> ValueToIndexMap;
+
+    /// Constructor
+    PAGSnapshot(const std::string& dir, llvm::Module& m);
+
+    /// Return file name
+    inline const std::string& getFileName() const {
+        return file;
+    }
+
+    /// Rebuild the PAG from the snapshot, return NULL if there is no valid snapshot of this module
+    PAG* read();
+
+    /// Write the PAG into the snapshot, return false if the PAG can not be saved
+    bool write(PAG* pag);
+
+private:
+    /// Number functions, basic blocks and instructions in module order (starting from 1, 0 means none)
+    void numberValues();
+
+    inline u32_t getIndex(const ValueToIndexMap& map, const llvm::Value* val) const {
+        if (val == NULL)
+            return 0;
+        ValueToIndexMap::const_iterator it = map.find(val);
+        assert(it != map.end() && "value not numbered?");
+        return it->second;
+    }
+
+    llvm::Module& module;
+    std::string hash;
+    std::string file;
+
+    /// Numbered values
+    //@{
+    std::vector<const llvm::Function*> funs;
+    std::vector<const llvm::BasicBlock*> bbs;
+    std::vector<const llvm::Instruction*> insts;
+    ValueToIndexMap funToIndex;
+    ValueToIndexMap bbToIndex;
+    ValueToIndexMap instToIndex;
+    //@}
+};
+
+#endif /* PAGSNAPSHOT_H_ */
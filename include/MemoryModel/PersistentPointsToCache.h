@@ -0,0 +1,134 @@
+//===- PersistentPointsToCache.h -- Interned points-to sets -------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PersistentPointsToCache.h
+ *
+ *  Hash-consed points-to sets. Every distinct set is stored once and is
+ *  referred to by a PointsToID, so that pointers with equal points-to sets
+ *  share their storage and two sets are equal iff their IDs are equal.
+ *  Unions are memoized on the pair of operand IDs.
+ */
+
+#ifndef PERSISTENTPOINTSTOCACHE_H_
+#define PERSISTENTPOINTSTOCACHE_H_
+
+#include "Util/BasicTypes.h"
+#include <llvm/ADT/DenseMap.h>
+#include <unordered_set>
+
+typedef unsigned PointsToID;
+
+template<class Data>
+class PersistentPointsToCache {
+
+public:
+    typedef std::pair<PointsToID, PointsToID> IDPair;
+    typedef llvm::DenseMap<IDPair, PointsToID> OpCache;
+
+    /// ID of the empty set
+    static const PointsToID EmptyPtsID = 0;
+
+    PersistentPointsToCache() : idSet(16, IDHash(this), IDEqual(this)), unionHits(0), unionMisses(0) {
+        idToPts.push_back(Data());
+        idSet.insert(EmptyPtsID);
+    }
+
+    /// Return the ID of pts, interning it if it has not been seen before
+    PointsToID emplacePts(const Data& pts) {
+        if (pts.empty())
+            return EmptyPtsID;
+
+        /// Append pts tentatively so that it can be looked up by ID
+        PointsToID newID = idToPts.size();
+        idToPts.push_back(pts);
+        std::pair<typename IDSet::iterator, bool> res = idSet.insert(newID);
+        if (!res.second)
+            idToPts.pop_back();
+        return *res.first;
+    }
+
+    /// Return the points-to set of an ID. The reference stays valid as sets are never removed.
+    inline const Data& getActualPts(PointsToID id) const {
+        assert(id < idToPts.size() && "unknown points-to ID");
+        return idToPts[id];
+    }
+
+    /// Return the ID of lhs U rhs
+    PointsToID unionPts(PointsToID lhs, PointsToID rhs) {
+        if (lhs == rhs || rhs == EmptyPtsID)
+            return lhs;
+        if (lhs == EmptyPtsID)
+            return rhs;
+
+        /// union is commutative
+        IDPair key = lhs < rhs ? IDPair(lhs, rhs) : IDPair(rhs, lhs);
+        OpCache::const_iterator it = unionCache.find(key);
+        if (it != unionCache.end()) {
+            unionHits++;
+            return it->second;
+        }
+        unionMisses++;
+
+        Data result = getActualPts(lhs);
+        PointsToID resultID = (result |= getActualPts(rhs)) ? emplacePts(result) : lhs;
+        unionCache[key] = resultID;
+        return resultID;
+    }
+
+    /// Number of distinct sets including the empty set
+    inline u32_t getNumOfSets() const {
+        return idToPts.size();
+    }
+    inline u32_t getUnionHits() const {
+        return unionHits;
+    }
+    inline u32_t getUnionMisses() const {
+        return unionMisses;
+    }
+
+private:
+    /// Hash and compare the sets referred to by IDs
+    //@{
+    struct IDHash {
+        IDHash(const PersistentPointsToCache* c) : cache(c) {}
+        size_t operator()(PointsToID id) const {
+            const Data& pts = cache->getActualPts(id);
+            size_t h = pts.count();
+            for (typename Data::iterator it = pts.begin(), eit = pts.end(); it != eit; ++it)
+                h = h * 31 + *it;
+            return h;
+        }
+        const PersistentPointsToCache* cache;
+    };
+    struct IDEqual {
+        IDEqual(const PersistentPointsToCache* c) : cache(c) {}
+        bool operator()(PointsToID lhs, PointsToID rhs) const {
+            return lhs == rhs || cache->getActualPts(lhs) == cache->getActualPts(rhs);
+        }
+        const PersistentPointsToCache* cache;
+    };
+    typedef std::unordered_set<PointsToID, IDHash, IDEqual> IDSet;
+    //@}
+
+    /// Copying would leave the hash functors pointing at the original cache
+    PersistentPointsToCache(const PersistentPointsToCache&);
+    void operator=(const PersistentPointsToCache&);
+
+    std::deque<Data> idToPts;	///< interned sets, indexed by ID (deque keeps references stable)
+    IDSet idSet;	///< IDs of all interned sets, hashed on the set contents
+    OpCache unionCache;	///< memoized unions
+    u32_t unionHits;
+    u32_t unionMisses;
+};
+
+template<class Data>
+const PointsToID PersistentPointsToCache<Data>::EmptyPtsID;
+
+#endif /* PERSISTENTPOINTSTOCACHE_H_ */
@@ -28,6 +28,8 @@
 #include <llvm/Analysis/AliasAnalysis.h>
 #include <llvm/Analysis/CallGraph.h>	// call graph
 
+#include <unordered_map>
+
 class PTAStat;
 /*
  * Pointer Analysis Base Class
@@ -42,6 +44,7 @@ public:
         AndersenLCD_WPA,	///< Lazy cycle detection andersen-style WPA
         AndersenWave_WPA,	///< Wave propagation andersen-style WPA
         AndersenWaveDiff_WPA,	///< Diff wave propagation andersen-style WPA
+        AndersenParallel_WPA,	///< Parallel work-stealing andersen-style WPA
         CSCallString_WPA,	///< Call string based context sensitive WPA
         CSSummary_WPA,		///< Summary based context sensitive WPA
         FSDATAFLOW_WPA,	///< Traditional Dataflow-based flow sensitive WPA
@@ -69,19 +72,26 @@ public:
     typedef PAG::CallSiteToFunPtrMap CallSiteToFunPtrMap;
     typedef	std::set<const llvm::Function*> FunctionSet;
     typedef std::map<llvm::CallSite, FunctionSet> CallEdgeMap;
+    typedef std::map<llvm::CallSite, PointsTo> CallSiteToPtsMap;
     typedef SCCDetection<PTACallGraph*> CallGraphSCC;
     //@}
 
+    /// Batch alias queries, the i-th result answers the i-th query
+    //@{
+    typedef std::pair<const llvm::Value*, const llvm::Value*> AliasQuery;
+    typedef std::vector<AliasQuery> AliasQueryList;
+    typedef std::vector<llvm::AliasResult> AliasResultList;
+    //@}
+
     /// Statistic numbers
     //@{
     Size_t numOfIteration;
     //@}
 
-private:
+protected:
     /// Release the memory
     void destroy();
 
-protected:
 
     /// User input flags
     //@{
@@ -103,6 +113,8 @@ protected:
     PTACallGraph* ptaCallGraph;
     /// SCC for CallGraph
     CallGraphSCC* callGraphSCC;
+    /// Function pointer targets of each indirect callsite which have been resolved
+    CallSiteToPtsMap csToResolvedPtsMap;
 
 public:
     /// Return number of resolved indirect call edges
@@ -136,6 +148,9 @@ public:
     }
     //@}
 
+    /// Options affecting the results of pointer analysis, part of the keys of results cached on disk
+    static std::string getOptionKey();
+
     /// Get PTA stat
     inline PTAStat* getStat() const {
         return stat;
@@ -175,6 +190,9 @@ public:
     /// Interface exposed to users of our pointer analysis, given PAGNodeID
     virtual llvm::AliasResult alias(NodeID node1, NodeID node2) = 0;
 
+    /// Interface exposed to users of our pointer analysis, given a batch of Value pairs
+    virtual void alias(const AliasQueryList& queries, AliasResultList& results);
+
 protected:
     /// Return all indirect callsites
     inline const CallSiteToFunPtrMap& getIndirectCallsites() const {
@@ -202,10 +220,10 @@ public:
 
     /// Determine whether a points-to contains a black hole or constant node
     //@{
-    inline bool containBlackHoleNode(PointsTo& pts) {
+    inline bool containBlackHoleNode(const PointsTo& pts) {
         return pts.test(pag->getBlackHoleNode());
     }
-    inline bool containConstantNode(PointsTo& pts) {
+    inline bool containConstantNode(const PointsTo& pts) {
         return pts.test(pag->getConstantNode());
     }
     inline bool isBlkObjOrConstantObj(NodeID ptd) const {
@@ -316,6 +334,10 @@ public:
 
     /// Get points-to targets of a pointer. It needs to be implemented in child class
     virtual PointsTo& getPts(NodeID ptr) = 0;
+    /// Get points-to targets of a pointer for reading only
+    virtual const PointsTo& getConstPts(NodeID ptr) {
+        return getPts(ptr);
+    }
 
     /// Clear points-to data
     virtual void clearPts() {
@@ -345,6 +367,7 @@ public:
     typedef DiffPTData<NodeID,PointsTo,EdgeID> DiffPTDataTy;	/// Points-to data structure type
     typedef DFPTData<NodeID,PointsTo> DFPTDataTy;	/// Points-to data structure type
     typedef IncDFPTData<NodeID,PointsTo> IncDFPTDataTy;	/// Points-to data structure type
+    typedef PersistentPTData<NodeID,PointsTo> PersistentPTDataTy;	/// Points-to data structure type
 
     /// Constructor
     BVDataPTAImpl(PointerAnalysis::PTATY type);
@@ -365,11 +388,34 @@ public:
     virtual inline PointsTo& getPts(NodeID id) {
         return ptD->getPts(id);
     }
+    /// Points-to set for reading only, persistent points-to data returns its shared set without copying
+    virtual inline const PointsTo& getConstPts(NodeID id) {
+        return ptD->getConstPts(id);
+    }
+    /// Reverse points-to kept selectively during solving is materialized on the first query
     virtual inline PointsTo& getRevPts(NodeID nodeId) {
+        if (ptD->isSelectiveRevPts())
+            ptD->materializeRevPts();
         return ptD->getRevPts(nodeId);
     }
     //@}
 
+    /// Finalize analysis, points-to sets do not change and alias queries are cached from now on
+    virtual void finalize();
+
+    /// Memoize the field-expanded points-to sets of alias queries,
+    /// only enabled when points-to sets are not changed any more
+    //@{
+    inline void enableAliasCache() {
+        expandedPtsMap.clear();
+        aliasCacheEnabled = true;
+    }
+    inline void disableAliasCache() {
+        expandedPtsMap.clear();
+        aliasCacheEnabled = false;
+    }
+    //@}
+
 protected:
 
     /// Get points-to data structure
@@ -401,16 +447,34 @@ protected:
     virtual inline void clearPts() {
         ptD->clear();
     }
+    /// Remove element from the points-to set of id
+    virtual inline void clearPts(NodeID id, NodeID element) {
+        ptD->clearPts(id, element);
+    }
 
-    /// On the fly call graph construction
+    /// On the fly call graph construction, only the targets of function pointers added since the last round are resolved
     virtual void onTheFlyCallGraphSolve(const CallSiteToFunPtrMap& callsites, CallEdgeMap& newEdges,llvm::CallGraph* callgraph = NULL);
 
     /// Expand FI objects
     void expandFIObjs(const PointsTo& pts, PointsTo& expandedPts);
 
+    /// Node holding the points-to set returned by getPts(id), pointers of the same node have the same points-to set
+    virtual inline NodeID getPtsRepNode(NodeID id) {
+        return id;
+    }
+
 private:
+    typedef std::unordered_map<NodeID, PointsTo> NodeToPtsMap;
+
+    /// Field-expanded points-to set of a rep node, memoized in expandedPtsMap
+    const PointsTo& getExpandedPts(NodeID rep);
+
     /// Points-to data
     PTDataTy* ptD;
+    /// Field-expanded points-to sets of rep nodes queried by alias
+    NodeToPtsMap expandedPtsMap;
+    /// Whether expandedPtsMap is used
+    bool aliasCacheEnabled;
 
 public:
     /// Interface expose to users of our pointer analysis, given Location infos
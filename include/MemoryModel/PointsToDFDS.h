@@ -178,6 +178,10 @@ protected:
     inline bool unionPts(Data& dstData, const Data& srcData) {
         return dstData |= srcData;
     }
+    /// Add an element into points-to set
+    inline bool addPts(Data &d, const Key& e) {
+        return d.test_and_set(e);
+    }
 
 public:
     /// Dump the DF IN/OUT set information for debugging purpose
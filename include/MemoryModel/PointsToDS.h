@@ -20,6 +20,7 @@
 #define POINTSTO_H_
 
 #include "MemoryModel/ConditionalPT.h"
+#include "MemoryModel/PersistentPointsToCache.h"
 #include "Util/AnalysisUtil.h"
 
 /// Overloading operator << for dumping conditional variable
@@ -53,10 +54,11 @@ public:
         DFPTD,
         IncDFPTD,
         DiffPTD,
+        PersistentPTD,
         Default
     };
     /// Constructor
-    PTData(PTDataTY ty = Default): ptdTy(ty) {
+    PTData(PTDataTY ty = Default): selectiveRevPts(false), ptdTy(ty) {
     }
 
     /// Destructor
@@ -67,6 +69,7 @@ public:
     virtual void clear() {
         ptsMap.clear();
         revPtsMap.clear();
+        revPtsObjs.clear();
     }
 
     /// Get the type of a points-to data structure
@@ -74,16 +77,22 @@ public:
         return ptdTy;
     }
 
-    /// Return Points-to map
+    /// Return Points-to map, persistent points-to sets are not kept in it
     inline const PtsMap& getPtsMap() const {
+        assert(ptdTy != PersistentPTD && "persistent points-to data has no points-to map");
         return ptsMap;
     }
 
     // Get conditional points-to set of the pointer
-    inline Data& getPts(const Key& var) {
+    virtual inline Data& getPts(const Key& var) {
         return ptsMap[var];
     }
 
+    /// Get the points-to set of var for reading only
+    virtual inline const Data& getConstPts(const Key& var) {
+        return getPts(var);
+    }
+
     // Get conditional reverse points-to set of the pointer
     inline Data& getRevPts(const Key& var) {
         return revPtsMap[var];
@@ -91,24 +100,69 @@ public:
 
     /// Union/add points-to, used internally
     //@{
-    inline bool addPts(const Key &dstKey, const Key& srcKey) {
-        addSingleRevPts(getRevPts(srcKey),dstKey);
+    virtual inline bool addPts(const Key &dstKey, const Key& srcKey) {
+        if (isRevPtsTracked(srcKey))
+            addSingleRevPts(getRevPts(srcKey),dstKey);
         return addPts(getPts(dstKey),srcKey);
     }
-    inline bool unionPts(const Key& dstKey, const Key& srcKey) {
+    virtual inline bool unionPts(const Key& dstKey, const Key& srcKey) {
         addRevPts(getPts(srcKey),dstKey);
         return unionPts(getPts(dstKey),getPts(srcKey));
     }
-    inline bool unionPts(const Key& dstKey, const Data& srcData) {
+    virtual inline bool unionPts(const Key& dstKey, const Data& srcData) {
         addRevPts(srcData,dstKey);
         return unionPts(getPts(dstKey),srcData);
     }
+    //@}
+
+    /// Remove element from the points-to set of var
+    virtual inline void clearPts(const Key& var, const Key& element) {
+        getPts(var).reset(element);
+    }
+
+    /// Remove all elements from the points-to set of var, and var from their reverse points-to
+    virtual inline void clearFullPts(const Key& var) {
+        Data& pts = getPts(var);
+        removeRevPts(pts, var);
+        pts.clear();
+    }
+
+    /// Record var in the reverse points-to of every target in its points-to set.
+    /// Used by solvers which update points-to sets directly and defer the reverse side.
+    inline void updateRevPts(const Key& var) {
+        addRevPts(getConstPts(var),var);
+    }
+
+    /// Selective reverse points-to.
+    /// By default the reverse points-to of every object is kept up to date on each union.
+    /// In selective mode it is only kept for objects marked by trackRevPts, and the
+    /// reverse points-to of all objects can be rebuilt in one pass by materializeRevPts.
+    //@{
+    inline void setSelectiveRevPts(bool selective) {
+        selectiveRevPts = selective;
+    }
+    inline bool isSelectiveRevPts() const {
+        return selectiveRevPts;
+    }
+    inline void trackRevPts(const Key& obj) {
+        revPtsObjs.set(obj);
+    }
+    inline bool isRevPtsTracked(const Key& obj) const {
+        return !selectiveRevPts || revPtsObjs.test(obj);
+    }
+    /// Rebuild the reverse points-to of all objects and leave selective mode
+    virtual void materializeRevPts() {
+        revPtsMap.clear();
+        selectiveRevPts = false;
+        for (PtsMapConstIter it = ptsMap.begin(), eit = ptsMap.end(); it != eit; ++it)
+            addRevPts(it->second, it->first);
+    }
+    //@}
 
 protected:
     PtsMap ptsMap;
     PtsMap revPtsMap;
 
-private:
     /// Union/add points-to
     //@{
     inline bool unionPts(Data& dstData, const Data& srcData) {
@@ -120,12 +174,30 @@ private:
     inline void addSingleRevPts(Data &revData, const Key& tgr) {
         addPts(revData,tgr);
     }
+    inline void removeRevPts(const Data &ptsData, const Key& tgr) {
+        for(iterator it = ptsData.begin(), eit = ptsData.end(); it!=eit; ++it) {
+            if (isRevPtsTracked(*it))
+                getRevPts(*it).reset(tgr);
+        }
+    }
     inline void addRevPts(const Data &ptsData, const Key& tgr) {
+        if (selectiveRevPts) {
+            if (revPtsObjs.empty())
+                return;
+            for(iterator it = ptsData.begin(), eit = ptsData.end(); it!=eit; ++it) {
+                if (revPtsObjs.test(*it))
+                    addSingleRevPts(getRevPts(*it),tgr);
+            }
+            return;
+        }
         for(iterator it = ptsData.begin(), eit = ptsData.end(); it!=eit; ++it)
             addSingleRevPts(getRevPts(*it),tgr);
     }
     //@}
 
+private:
+    bool selectiveRevPts;	///< whether reverse points-to is only kept for revPtsObjs
+    Data revPtsObjs;	///< objects whose reverse points-to is kept in selective mode
     PTDataTY ptdTy;
 
 public:
@@ -237,4 +309,135 @@ private:
     CahcePtsMap CacheMap;	///< points-to processed at load/store edge
 };
 
+/*!
+ * Persistent points-to data
+ * Each key holds the ID of its points-to set in a PersistentPointsToCache instead of a private copy,
+ * so that keys with equal points-to sets share one set and the union of equal sets is O(1).
+ * Keys are dense IDs (NodeID) indexing a vector of points-to IDs.
+ * getConstPts returns the shared set and getPts must not be called, points-to sets are only
+ * changed via unionPts/addPts/clearPts.
+ * Reverse points-to sets are not shared and kept in the base class.
+ */
+template<class Key, class Data>
+class PersistentPTData : public PTData<Key,Data> {
+public:
+    typedef typename PTData<Key,Data>::PtsMap PtsMap;
+    typedef typename PTData<Key,Data>::PTDataTY PTDataTy;
+    typedef std::vector<PointsToID> PtsIDMap;
+    typedef PersistentPointsToCache<Data> PtsCache;
+
+    /// Constructor
+    PersistentPTData(PTDataTy ty = (PTData<Key,Data>::PersistentPTD)): PTData<Key,Data>(ty) {
+    }
+
+    /// Destructor
+    virtual ~PersistentPTData() {}
+
+    /// Clear maps, interned sets are kept for later use
+    virtual void clear() {
+        PTData<Key,Data>::clear();
+        ptsIDMap.clear();
+    }
+
+    /// Interned sets are shared and can not be changed in place,
+    /// read them with getConstPts and change them with addPts/unionPts/clearPts
+    virtual inline Data& getPts(const Key& var) {
+        assert(false && "persistent points-to sets are immutable, use getConstPts");
+        abort();
+    }
+
+    /// Get the shared points-to set of var
+    virtual inline const Data& getConstPts(const Key& var) {
+        return ptsCache.getActualPts(getPtsID(var));
+    }
+
+    /// Union/add points-to
+    //@{
+    virtual inline bool addPts(const Key &dstKey, const Key& srcKey) {
+        if (this->isRevPtsTracked(srcKey))
+            this->addSingleRevPts(this->getRevPts(srcKey),dstKey);
+        Data srcData;
+        srcData.set(srcKey);
+        return unionPtsID(dstKey, ptsCache.emplacePts(srcData));
+    }
+    virtual inline bool unionPts(const Key& dstKey, const Key& srcKey) {
+        PointsToID srcID = getPtsID(srcKey);
+        this->addRevPts(ptsCache.getActualPts(srcID),dstKey);
+        return unionPtsID(dstKey, srcID);
+    }
+    virtual inline bool unionPts(const Key& dstKey, const Data& srcData) {
+        this->addRevPts(srcData,dstKey);
+        return unionPtsID(dstKey, ptsCache.emplacePts(srcData));
+    }
+    //@}
+
+    /// Remove element from the points-to set of var
+    virtual inline void clearPts(const Key& var, const Key& element) {
+        PointsToID id = getPtsID(var);
+        if (!ptsCache.getActualPts(id).test(element))
+            return;
+        Data pts = ptsCache.getActualPts(id);
+        pts.reset(element);
+        ptsIDMap[var] = ptsCache.emplacePts(pts);
+    }
+
+    /// Remove all elements from the points-to set of var, and var from their reverse points-to
+    virtual inline void clearFullPts(const Key& var) {
+        this->removeRevPts(ptsCache.getActualPts(getPtsID(var)), var);
+        if (var < ptsIDMap.size())
+            ptsIDMap[var] = PtsCache::EmptyPtsID;
+    }
+
+    /// Rebuild the reverse points-to of all objects and leave selective mode
+    virtual void materializeRevPts() {
+        this->revPtsMap.clear();
+        this->setSelectiveRevPts(false);
+        for (Key var = 0; var < ptsIDMap.size(); ++var)
+            this->addRevPts(ptsCache.getActualPts(ptsIDMap[var]), var);
+    }
+
+    /// Return the interned set store
+    inline const PtsCache& getPtsCache() const {
+        return ptsCache;
+    }
+
+    /// Methods for support type inquiry through isa, cast, and dyn_cast:
+    //@{
+    static inline bool classof(const PersistentPTData<Key,Data> *) {
+        return true;
+    }
+    static inline bool classof(const PTData<Key,Data>* ptd) {
+        return ptd->getPTDTY() == PTData<Key,Data>::PersistentPTD;
+    }
+    //@}
+
+    /// Debugging functions
+    virtual inline void dumpPTData() {
+        PtsMap ptsMap;
+        for (Key var = 0; var < ptsIDMap.size(); ++var)
+            ptsMap[var] = ptsCache.getActualPts(ptsIDMap[var]);
+        this->dumpPts(ptsMap);
+    }
+
+private:
+    inline PointsToID getPtsID(const Key& var) const {
+        return var < ptsIDMap.size() ? ptsIDMap[var] : PtsCache::EmptyPtsID;
+    }
+
+    /// Point dstKey to the union of its set and srcID, return true if its set is changed
+    inline bool unionPtsID(const Key& dstKey, PointsToID srcID) {
+        if (dstKey >= ptsIDMap.size())
+            ptsIDMap.resize(dstKey + 1, PtsCache::EmptyPtsID);
+        PointsToID& dstID = ptsIDMap[dstKey];
+        PointsToID newID = ptsCache.unionPts(dstID, srcID);
+        if (newID == dstID)
+            return false;
+        dstID = newID;
+        return true;
+    }
+
+    PtsIDMap ptsIDMap;	///< ID of the points-to set of each key
+    PtsCache ptsCache;	///< interned points-to sets
+};
+
 #endif /* POINTSTO_H_ */
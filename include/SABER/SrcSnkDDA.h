@@ -23,6 +23,9 @@
 #include "SABER/SaberSVFGBuilder.h"
 #include "WPA/Andersen.h"
 
+#include <atomic>
+#include <unordered_set>
+
 typedef CFLSolver<SVFG*,CxtDPItem> CFLSrcSnkSolver;
 
 /*!
@@ -35,24 +38,47 @@ public:
     typedef std::map<const SVFGNode*,ProgSlice*> SVFGNodeToSliceMap;
     typedef SVFGNodeSet::iterator SVFGNodeSetIter;
     typedef CxtDPItem DPIm;
-    typedef std::set<DPIm> DPImSet;							///< dpitem set
-    typedef std::map<const SVFGNode*, DPImSet> SVFGNodeToDPItemsMap; 	///< map a SVFGNode to its visited dpitems
+    typedef std::unordered_set<DPIm> DPImSet;					///< dpitem set
+    typedef FIFOWorkList<DPIm, DPImSet> DPImWorkList;		///< worklist of hashed dpitems
+    typedef std::vector<const SVFGNode*> SVFGNodeList;
+    typedef std::vector<ProgSlice*> ProgSliceList;
+
+    /*!
+     * State of analysing the slice of a source. Each thread analysing sources has its own
+     * worklist, visited dpitems, call strings and path condition allocator (with its own BDD manager).
+     */
+    struct SliceState {
+        SliceState(PathCondAllocator* pa): slice(NULL), pathAllocator(pa) {}
+        ProgSlice* slice;		///<  current program slice
+        DPImWorkList worklist;	///<  worklist of forward and backward traversal
+        DPImSet forwardVisitedSet;	///<  record forward visited dpitems (the node of an item is where it is visited)
+        SVFGNodeSet visitedSet;	///<  record backward visited nodes
+        CallStringTable callStrs;	///<  call strings of the dpitems, kept across slices
+        PathCondAllocator* pathAllocator;
+    };
 
 private:
-    ProgSlice* _curSlice;		/// current program slice
     SVFGNodeSet sources;		/// source nodes
     SVFGNodeSet sinks;		/// source nodes
     PathCondAllocator* pathCondAllocator;
-    SVFGNodeToDPItemsMap nodeToDPItemsMap;	///<  record forward visited dpitems
-    SVFGNodeSet visitedSet;	///<  record backward visited nodes
+    SliceState mainState;	///<  state of the sequential analysis and bug reporting
     SaberSVFGBuilder memSSA;
     SVFG* svfg;
     PTACallGraph* ptaCallGraph;
+
+    /// BDD statistics summed over the managers of the worker threads, collected before they are released
+    //@{
+    u32_t workerBDDMemUsage;
+    u32_t workerBDDNum;
+    u32_t workerBDDMaxLiveNum;
+    //@}
+
+    static thread_local SliceState* curState;	///<  state of the slice analysed by this thread
 public:
 
     /// Constructor
-    SrcSnkDDA() : _curSlice(NULL), svfg(NULL), ptaCallGraph(NULL) {
-        pathCondAllocator = new PathCondAllocator();
+    SrcSnkDDA() : pathCondAllocator(new PathCondAllocator()), mainState(pathCondAllocator), svfg(NULL), ptaCallGraph(NULL),
+        workerBDDMemUsage(0), workerBDDNum(0), workerBDDMaxLiveNum(0) {
     }
     /// Destructor
     virtual ~SrcSnkDDA() {
@@ -72,6 +98,9 @@ public:
     /// Start analysis here
     virtual void analyze(llvm::Module& module);
 
+    /// Analyse the slice of a source, the bug is reported by the caller
+    void analyzeSlice(const SVFGNode* src);
+
     /// Initialize analysis
     virtual void initialize(llvm::Module& module) {
         ptaCallGraph = new PTACallGraph(&module);
@@ -106,23 +135,23 @@ public:
     void setCurSlice(const SVFGNode* src);
 
     inline ProgSlice* getCurSlice() const {
-        return _curSlice;
+        return getSliceState()->slice;
     }
     inline void addSinkToCurSlice(const SVFGNode* node) {
-        _curSlice->addToSinks(node);
+        getCurSlice()->addToSinks(node);
         addToCurForwardSlice(node);
     }
     inline bool isInCurForwardSlice(const SVFGNode* node) {
-        return _curSlice->inForwardSlice(node);
+        return getCurSlice()->inForwardSlice(node);
     }
     inline bool isInCurBackwardSlice(const SVFGNode* node) {
-        return _curSlice->inBackwardSlice(node);
+        return getCurSlice()->inBackwardSlice(node);
     }
     inline void addToCurForwardSlice(const SVFGNode* node) {
-        _curSlice->addToForwardSlice(node);
+        getCurSlice()->addToForwardSlice(node);
     }
     inline void addToCurBackwardSlice(const SVFGNode* node) {
-        _curSlice->addToBackwardSlice(node);
+        getCurSlice()->addToBackwardSlice(node);
     }
     //@}
 
@@ -173,12 +202,40 @@ public:
     }
 
 protected:
+    /// State of the slice analysed by the current thread
+    inline SliceState* getSliceState() const {
+        assert(curState && "no slice is being analysed by this thread");
+        return curState;
+    }
+    /// Analyse sources by several threads, bugs are reported in the order of sources
+    void analyzeInParallel(llvm::Module& module, u32_t numOfThreads);
+    void runSliceWorker(const SVFGNodeList& srcs, ProgSliceList& slices, SliceState* state,
+                        u32_t end, std::atomic<u32_t>& next);
+
+    /// Traverse with the worklist of the current thread
+    //@{
+    virtual void forwardTraverse(DPIm& it);
+    virtual void backwardTraverse(DPIm& it);
+    //@}
+    /// Worklist operations on the worklist of the current thread, hiding those of CFLSolver
+    //@{
+    inline DPIm popFromWorklist() {
+        return getSliceState()->worklist.pop();
+    }
+    inline bool pushIntoWorklist(DPIm& item) {
+        return getSliceState()->worklist.push(item);
+    }
+    inline bool isWorklistEmpty() {
+        return getSliceState()->worklist.empty();
+    }
+    //@}
+
     /// Forward traverse
     virtual inline void forwardProcess(const DPIm& item) {
         const SVFGNode* node = getNode(item.getCurNodeID());
         if(isSink(node)) {
             addSinkToCurSlice(node);
-            _curSlice->setPartialReachable();
+            getCurSlice()->setPartialReachable();
         }
         else
             addToCurForwardSlice(node);
@@ -197,24 +254,24 @@ protected:
     /// Whether has been visited or not, in order to avoid recursion on SVFG
     //@{
     inline bool forwardVisited(const SVFGNode* node, const DPIm& item) {
-        SVFGNodeToDPItemsMap::iterator it = nodeToDPItemsMap.find(node);
-        if(it!=nodeToDPItemsMap.end())
-            return it->second.find(item)!=it->second.end();
-        else
-            return false;
+        assert(node->getId() == item.getCurNodeID() && "dpitem not at the visited node");
+        const DPImSet& visitedSet = getSliceState()->forwardVisitedSet;
+        return visitedSet.find(item)!=visitedSet.end();
     }
     inline void addForwardVisited(const SVFGNode* node, const DPIm& item) {
-        nodeToDPItemsMap[node].insert(item);
+        assert(node->getId() == item.getCurNodeID() && "dpitem not at the visited node");
+        getSliceState()->forwardVisitedSet.insert(item);
     }
     inline bool backwardVisited(const SVFGNode* node) {
+        const SVFGNodeSet& visitedSet = getSliceState()->visitedSet;
         return visitedSet.find(node)!=visitedSet.end();
     }
     inline void addBackwardVisited(const SVFGNode* node) {
-        visitedSet.insert(node);
+        getSliceState()->visitedSet.insert(node);
     }
     inline void clearVisitedMap() {
-        nodeToDPItemsMap.clear();
-        visitedSet.clear();
+        getSliceState()->forwardVisitedSet.clear();
+        getSliceState()->visitedSet.clear();
     }
     //@}
 
@@ -230,11 +287,11 @@ protected:
     //@}
     /// Whether it is all path reachable from a source
     virtual bool isAllPathReachable() {
-        return _curSlice->isAllReachable();
+        return getCurSlice()->isAllReachable();
     }
     /// Whether it is some path reachable from a source
     virtual bool isSomePathReachable() {
-        return _curSlice->isPartialReachable();
+        return getCurSlice()->isPartialReachable();
     }
     /// Dump SVFG with annotated slice informaiton
     //@{
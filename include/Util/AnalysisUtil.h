@@ -388,13 +388,13 @@ std::string  getSourceLocOfFunction(const llvm::Function *F);
 //@}
 
 /// Dump sparse bitvector set
-void dumpSet(llvm::SparseBitVector<> To, llvm::raw_ostream & O = llvm::outs());
+void dumpSet(PointsTo To, llvm::raw_ostream & O = llvm::outs());
 
 /// Dump points-to set
-void dumpPointsToSet(unsigned node, llvm::SparseBitVector<> To) ;
+void dumpPointsToSet(unsigned node, PointsTo To) ;
 
 /// Dump alias set
-void dumpAliasSet(unsigned node, llvm::SparseBitVector<> To) ;
+void dumpAliasSet(unsigned node, PointsTo To) ;
 
 /// Print successful message by converting a string into green string output
 std::string sucMsg(std::string msg);
@@ -422,6 +422,18 @@ bool getMemoryUsageKB(u32_t* vmrss_kb, u32_t* vmsize_kb);
 /// Increase the stack size limit
 void increaseStackSize();
 
+/// Return the MD5 hash of a module (as a hex string of its printed IR), used as the key of cached analysis data
+std::string getModuleHash(const llvm::Module& module);
+
+/// Cached analysis data may be read by other processes while it is written, so it is written
+/// into a temporary file next to it which then replaces it by a rename
+//@{
+/// Create a unique temporary file for file, return NULL if it can not be created
+llvm::raw_fd_ostream* createTempFile(const std::string& file, llvm::SmallVectorImpl<char>& tempFile);
+/// Close and delete os, and rename its temporary file to file, which is removed if it can not be written
+bool commitTempFile(llvm::raw_fd_ostream* os, const llvm::SmallVectorImpl<char>& tempFile, const std::string& file);
+//@}
+
 /*!
  * Compare two PointsTo according to their size and points-to elements.
  * 1. PointsTo with smaller size is smaller than the other;
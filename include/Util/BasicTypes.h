@@ -19,13 +19,14 @@
 
 #include <llvm/ADT/SmallVector.h>		// for small vector
 #include <llvm/ADT/DenseSet.h>		// for dense map, set
-#include <llvm/ADT/SparseBitVector.h>	// for points-to
+#include "Util/PointsTo.h"	// for points-to
 #include <vector>
 #include <list>
 #include <set>
 #include <map>
 #include <stack>
 #include <deque>
+#include <chrono>
 
 typedef unsigned NodeID;
 typedef unsigned EdgeID;
@@ -37,7 +38,6 @@ typedef unsigned long long u64_t;
 typedef signed s32_t;
 typedef signed long Size_t;
 
-typedef llvm::SparseBitVector<> PointsTo;
 typedef PointsTo NodeBS;
 typedef PointsTo AliasSet;
 
@@ -80,11 +80,11 @@ typedef SmallVector16 CallStrCxt;
 #define DMTA "mta"
 
 /*
- * Number of clock ticks per second. A clock tick is the unit by which
- * processor time is measured and is returned by 'clock'.
+ * Number of ms per second. CLOCK_IN_MS is the monotonic wall clock in ms, the
+ * processor time returned by 'clock' adds up the time of all threads.
  */
 #define TIMEINTERVAL 1000
-#define CLOCK_IN_MS() (clock() / (CLOCKS_PER_SEC / TIMEINTERVAL))
+#define CLOCK_IN_MS() (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count())
 
 class BddCond;
 
@@ -0,0 +1,126 @@
+//===- CallStringTable.h -- Interned call-string contexts---------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * CallStringTable.h
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  Call strings of at most a given length interned as IDs of a trie, whose
+ *  node of a string is the child of the node of the string without its last
+ *  callsite. Equal strings have equal IDs. Matching a return goes to the parent
+ *  and pushing a call follows a memoized transition, so both are O(1) instead
+ *  of copying a vector. A string at the length limit drops its oldest callsite
+ *  when a callsite is pushed, as ContextCond::pushContext does.
+ */
+
+#ifndef CALLSTRINGTABLE_H_
+#define CALLSTRINGTABLE_H_
+
+#include "Util/BasicTypes.h"
+#include <llvm/ADT/DenseMap.h>
+#include <algorithm>
+#include <vector>
+
+typedef unsigned CallStrID;
+
+class CallStringTable {
+public:
+    static const CallStrID EmptyCxt = 0;	///< ID of the empty call string
+
+    CallStringTable(u32_t maxLen = 0) : maxCxtLen(maxLen) {
+        clear();
+    }
+
+    /// Set the length limit, the interned strings are dropped
+    inline void setMaxCxtLen(u32_t maxLen) {
+        maxCxtLen = maxLen;
+        clear();
+    }
+    inline u32_t getMaxCxtLen() const {
+        return maxCxtLen;
+    }
+
+    /// The string of cxt followed by cs (without its oldest callsite at the length limit)
+    inline CallStrID push(CallStrID cxt, CallSiteID cs) {
+        TransitionMap::const_iterator it = transitions.find(std::make_pair(cxt, cs));
+        if (it != transitions.end())
+            return it->second;
+        /// computing a push at the limit pushes other strings, which may rehash the map
+        CallStrID res = computePush(cxt, cs);
+        transitions[std::make_pair(cxt, cs)] = res;
+        return res;
+    }
+
+    /// Match a return to cs: pop cs if it is the last callsite, an empty string matches any return
+    inline bool match(CallStrID& cxt, CallSiteID cs) const {
+        if (cxt == EmptyCxt)
+            return true;
+        const Entry& entry = entries[cxt];
+        if (entry.cs != cs)
+            return false;
+        cxt = entry.parent;
+        return true;
+    }
+
+    inline u32_t getCxtSize(CallStrID cxt) const {
+        return entries[cxt].depth;
+    }
+
+    /// The callsites of cxt from the oldest one
+    inline void getCallStr(CallStrID cxt, CallStrCxt& callStr) const {
+        callStr.clear();
+        for (; cxt != EmptyCxt; cxt = entries[cxt].parent)
+            callStr.push_back(entries[cxt].cs);
+        std::reverse(callStr.begin(), callStr.end());
+    }
+
+    /// Number of interned strings
+    inline u32_t size() const {
+        return entries.size();
+    }
+
+    inline void clear() {
+        entries.clear();
+        entries.push_back(Entry(EmptyCxt, 0, 0));
+        transitions.clear();
+    }
+
+private:
+    struct Entry {
+        Entry(CallStrID p, CallSiteID c, u32_t d) : parent(p), cs(c), depth(d) {}
+        CallStrID parent;	///< string without the last callsite
+        CallSiteID cs;	///< last callsite
+        u32_t depth;	///< length of the string
+    };
+    typedef llvm::DenseMap<std::pair<CallStrID, CallSiteID>, CallStrID> TransitionMap;
+
+    CallStrID computePush(CallStrID cxt, CallSiteID cs) {
+        u32_t depth = entries[cxt].depth;
+        if (depth < maxCxtLen) {
+            entries.push_back(Entry(cxt, cs, depth + 1));
+            return entries.size() - 1;
+        }
+        /// a string at the limit keeps its callsites after the oldest one (no push with limit 0)
+        if (depth == 0)
+            return cxt;
+        CallStrCxt callStr;
+        getCallStr(cxt, callStr);
+        CallStrID res = EmptyCxt;
+        for (u32_t i = 1; i < callStr.size(); i++)
+            res = push(res, callStr[i]);
+        return push(res, cs);
+    }
+
+    u32_t maxCxtLen;
+    std::vector<Entry> entries;	///< interned strings, indexed by ID
+    TransitionMap transitions;	///< memoized pushes
+};
+
+#endif /* CALLSTRINGTABLE_H_ */
@@ -20,8 +20,11 @@
 #include "Util/PathCondAllocator.h"
 #include "MemoryModel/ConditionalPT.h"
 #include "MSSA/SVFGNode.h"
+#include "Util/CallStringTable.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>    // std::sort
+#include <atomic>
+#include <functional>
 
 /*!
  * Dynamic programming item for CFL researchability search
@@ -274,7 +277,7 @@ private:
     static u32_t maximumCxtLen;
     bool concreteCxt;
 public:
-    static u32_t maximumCxt;
+    static std::atomic<u32_t> maximumCxt;	///< updated by threads analysing different slices
 };
 
 /*!
@@ -583,18 +586,16 @@ public:
 
 
 /*!
- * Context DPItem
+ * Context DPItem, whose call string is interned in a CallStringTable
  */
 typedef CondVar<ContextCond> CxtVar;
 class CxtDPItem : public DPItem {
 private:
-    ContextCond context;
+    CallStrID context;
 
 public:
     /// Constructor
-    CxtDPItem(NodeID c, const ContextCond& cxt) : DPItem(c),context(cxt) {
-    }
-    CxtDPItem(const CxtVar& var) : DPItem(var.get_id()),context(var.get_cond()) {
+    CxtDPItem(NodeID c, CallStrID cxt = CallStringTable::EmptyCxt) : DPItem(c),context(cxt) {
     }
     /// Copy constructor
     CxtDPItem(const CxtDPItem& dps) :
@@ -605,29 +606,46 @@ public:
     }
 
     /// Get context
-    inline const ContextCond& getContexts() const {
+    inline CallStrID getContexts() const {
         return context;
     }
     /// Push context
-    inline void pushContext(NodeID cxt) {
-        context.pushContext(cxt);
+    inline void pushContext(CallStringTable& table, CallSiteID cxt) {
+        context = table.push(context, cxt);
     }
 
     /// Match context
-    inline virtual bool matchContext(NodeID cxt) {
-        return context.matchContext(cxt);
+    inline bool matchContext(const CallStringTable& table, CallSiteID cxt) {
+        return table.match(context, cxt);
     }
 
     /// Enable compare operator to avoid duplicated item insertion in map or set
-    /// to be noted that two vectors can also overload operator()
     inline bool operator< (const CxtDPItem& rhs) const {
         if (cur != rhs.cur)
             return cur < rhs.cur;
         else
             return context < rhs.context;
     }
+    /// Overloading operator==
+    inline bool operator== (const CxtDPItem& rhs) const {
+        return cur == rhs.cur && context == rhs.context;
+    }
+    /// Overloading operator!=
+    inline bool operator!= (const CxtDPItem& rhs) const {
+        return !(*this == rhs);
+    }
 
 };
 
+/// Hash of a context DPItem for unordered sets
+namespace std {
+template<>
+struct hash<CxtDPItem> {
+    size_t operator()(const CxtDPItem& item) const {
+        return std::hash<u64_t>()(((u64_t)item.getContexts() << 32) | item.getCurNodeID());
+    }
+};
+}
+
 
 #endif /* DPITEM_H_ */
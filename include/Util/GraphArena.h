@@ -0,0 +1,156 @@
+//===- GraphArena.h -- Arena allocator for graph nodes and edges-------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * GraphArena.h
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  Graph nodes and edges are allocated by bumping a pointer in large slabs owned
+ *  by their graph instead of one malloc call each. An object deleted before its
+ *  graph (e.g. an edge removed when merging SCCs or bypassing a node) goes into
+ *  a free list of its size and is reused by the next object of that size. The
+ *  slabs are returned to the system all at once when the graph is destroyed.
+ *
+ *  A slab is aligned to its size and starts with a pointer to its arena, so a
+ *  deleted object finds its arena from its own address.
+ */
+
+#ifndef GRAPHARENA_H_
+#define GRAPHARENA_H_
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+class GraphArena {
+
+public:
+    enum {
+        SlabSize = 64 * 1024,	///< size and alignment of a slab
+        Alignment = 16,		///< alignment of every object, as malloc
+        MaxObjectSize = 1024	///< objects are far smaller than a slab
+    };
+
+    GraphArena(): cur(NULL), end(NULL), numOfBytes(0) {
+        memset(freeLists, 0, sizeof(freeLists));
+    }
+
+    ~GraphArena() {
+        release();
+    }
+
+    /// Allocate an object of size bytes, reuse a deleted object of the same size if any
+    inline void* allocate(size_t size) {
+        size = roundUp(size);
+        assert(size <= MaxObjectSize && "object too large for graph arena");
+        FreeObject*& head = freeLists[size / Alignment];
+        if (head) {
+            FreeObject* obj = head;
+            head = obj->next;
+            return obj;
+        }
+        if ((size_t)(end - cur) < size)
+            allocateSlab();
+        void* obj = cur;
+        cur += size;
+        numOfBytes += size;
+        return obj;
+    }
+
+    /// Put a deleted object into the free list of its size
+    inline void deallocate(void* obj, size_t size) {
+        FreeObject*& head = freeLists[roundUp(size) / Alignment];
+        FreeObject* freeObj = static_cast<FreeObject*>(obj);
+        freeObj->next = head;
+        head = freeObj;
+    }
+
+    /// Return all slabs, objects allocated from this arena must not be used afterwards
+    void release() {
+        for (std::vector<void*>::iterator it = slabs.begin(), eit = slabs.end(); it != eit; ++it)
+            free(*it);
+        slabs.clear();
+        memset(freeLists, 0, sizeof(freeLists));
+        cur = end = NULL;
+        numOfBytes = 0;
+    }
+
+    /// The arena an object is allocated from
+    static inline GraphArena* getArena(const void* obj) {
+        const SlabHeader* slab = reinterpret_cast<const SlabHeader*>((uintptr_t)obj & ~(uintptr_t)(SlabSize - 1));
+        return slab->arena;
+    }
+
+    /// Number of slabs and bytes handed out to objects (not counting reuse)
+    //@{
+    inline size_t getSlabNum() const {
+        return slabs.size();
+    }
+    inline size_t getAllocatedBytes() const {
+        return numOfBytes;
+    }
+    //@}
+
+private:
+    struct SlabHeader {
+        GraphArena* arena;
+    };
+    struct FreeObject {
+        FreeObject* next;
+    };
+
+    static inline size_t roundUp(size_t size) {
+        return (size + Alignment - 1) & ~(size_t)(Alignment - 1);
+    }
+
+    void allocateSlab() {
+        void* slab = NULL;
+        if (posix_memalign(&slab, SlabSize, SlabSize) != 0) {
+            assert(false && "out of memory for graph arena");
+            abort();
+        }
+        slabs.push_back(slab);
+        static_cast<SlabHeader*>(slab)->arena = this;
+        cur = static_cast<char*>(slab) + roundUp(sizeof(SlabHeader));
+        end = static_cast<char*>(slab) + SlabSize;
+    }
+
+    /// An arena owns the memory of its objects, it can not be copied
+    GraphArena(const GraphArena&);
+    void operator=(const GraphArena&);
+
+    std::vector<void*> slabs;
+    char* cur;
+    char* end;
+    size_t numOfBytes;
+    FreeObject* freeLists[MaxObjectSize / Alignment + 1];
+};
+
+/*!
+ * Base class of objects allocated from a GraphArena, e.g. new (graph->getArena()) CopyCGEdge(src, dst, id).
+ * Deleting such an object puts its memory back to its arena.
+ */
+class GraphArenaObject {
+
+public:
+    static inline void* operator new(size_t size, GraphArena& arena) {
+        return arena.allocate(size);
+    }
+    static inline void operator delete(void* obj, size_t size) {
+        GraphArena::getArena(obj)->deallocate(obj, size);
+    }
+    /// Only called if a constructor throws, the memory is reclaimed when the arena is released
+    static inline void operator delete(void*, GraphArena&) {
+    }
+};
+
+#endif /* GRAPHARENA_H_ */
@@ -0,0 +1,359 @@
+//===- IncrementalSCC.h -- Incremental SCC detection--------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * IncrementalSCC.h
+ *
+ *  Created on: Oct 16, 2026
+ *
+ * Maintain the SCCs and a topological order of a graph while edges are added,
+ * using the dynamic topological order algorithm of Pearce and Kelly
+ * ("A Dynamic Topological Sort Algorithm for Directed Acyclic Graphs", JEA 2006).
+ *
+ * The order starts from the result of a full SCCDetection. When an edge src->dst
+ * is added with ord(dst) < ord(src), the nodes reachable from dst (F) and the nodes
+ * reaching src (B) are searched within [ord(dst), ord(src)] only. If src is in F,
+ * the nodes in both F and B form a new SCC, which is collapsed into one rep node.
+ * The nodes in B are then moved before those in F, reusing their own positions.
+ *
+ * The graph is not changed here: nodes of a new SCC are merged by the client later
+ * on, edges of all nodes of an SCC are followed until then. Edges must go from a rep
+ * to a rep when they are added. Removing edges never breaks the order. Any other
+ * change (e.g. nodes merged by the client itself) needs invalidate() and a full
+ * detection followed by reset().
+ */
+
+#ifndef INCREMENTALSCC_H_
+#define INCREMENTALSCC_H_
+
+#include "Util/BasicTypes.h"	// for NodeBS, NodeStack
+#include <llvm/ADT/GraphTraits.h>
+#include <llvm/ADT/DenseMap.h>
+#include <limits.h>
+#include <algorithm>
+#include <vector>
+
+template<class GraphType>
+class IncrementalSCCDetection {
+
+private:
+    typedef llvm::GraphTraits<GraphType> GTraits;
+    typedef typename GTraits::NodeType GNODE;
+    typedef typename GTraits::nodes_iterator node_iterator;
+    typedef typename GTraits::ChildIteratorType child_iterator;
+    typedef llvm::GraphTraits<llvm::Inverse<GNODE*> > InvGTraits;
+    typedef typename InvGTraits::ChildIteratorType inv_child_iterator;
+
+public:
+    typedef llvm::DenseMap<NodeID, NodeBS> RepToSubsMap;
+
+    IncrementalSCCDetection(const GraphType &GT)
+        : _graph(GT), _valid(false), _epoch(0), _visits(0)
+    {}
+
+    /// Start from the topological order of a full SCC detection (rep nodes, the top comes first)
+    void reset(const NodeStack& topoStack) {
+        _ord.assign(_ord.size(), UINT_MAX);
+        _rep.assign(_rep.size(), UINT_MAX);
+        _nodeAt.clear();
+        _newSCCs.clear();
+        NodeStack topo(topoStack);
+        while (!topo.empty()) {
+            position(topo.top());
+            topo.pop();
+        }
+        _visits = 0;
+        _valid = true;
+    }
+
+    /// Whether the order is still valid, a full detection and reset() are needed if not
+    //@{
+    inline bool isValid() const {
+        return _valid;
+    }
+    inline void invalidate() {
+        _valid = false;
+    }
+    //@}
+
+    /// Number of nodes visited by the searches since the last reset/resetNumOfVisits
+    //@{
+    inline Size_t getNumOfVisits() const {
+        return _visits;
+    }
+    inline void resetNumOfVisits() {
+        _visits = 0;
+    }
+    //@}
+
+    /// Rep node of a node, itself if it is not in any SCC found here
+    inline NodeID repNode(NodeID n) const {
+        while (n < _rep.size() && _rep[n] != UINT_MAX)
+            n = _rep[n];
+        return n;
+    }
+
+    /// SCCs found by addEdge() and not merged yet, from rep nodes to all nodes in the SCCs
+    //@{
+    inline const RepToSubsMap& getNewSCCs() const {
+        return _newSCCs;
+    }
+    inline void clearNewSCCs() {
+        _newSCCs.clear();
+    }
+    //@}
+
+    /// Edge src->dst has been added into the graph, update the order and SCCs
+    void addEdge(NodeID src, NodeID dst) {
+        assert(_valid && "order is not valid, reset it first");
+        src = repNode(src);
+        dst = repNode(dst);
+        if (src == dst)
+            return;
+
+        u32_t srcPos = position(src);
+        u32_t dstPos = position(dst);
+        if (srcPos < dstPos)
+            return;
+
+        _epoch++;
+        _F.clear();
+        _B.clear();
+        bool cycle = searchForward(dst, src, dstPos, srcPos);
+        searchBackward(src, dstPos, srcPos);
+
+        /// positions taken by F and B are reused by them after reordering
+        _slots.clear();
+        for (std::vector<NodeID>::const_iterator it = _F.begin(), eit = _F.end(); it != eit; ++it)
+            _slots.push_back(_ord[*it]);
+        for (std::vector<NodeID>::const_iterator it = _B.begin(), eit = _B.end(); it != eit; ++it) {
+            if (_fwdMark[*it] != _epoch)
+                _slots.push_back(_ord[*it]);
+        }
+        std::sort(_slots.begin(), _slots.end());
+
+        /// nodes on both sides are on a cycle through src->dst
+        NodeID sccRep = UINT_MAX;
+        if (cycle)
+            sccRep = mergeCycle();
+
+        reorder(sccRep);
+    }
+
+    /// Topological order of all rep nodes on the graph, the top comes first
+    NodeStack& topoNodeStack() {
+        assert(_valid && "order is not valid, reset it first");
+        while (!_T.empty())
+            _T.pop();
+
+        /// nodes added into the graph after reset() have no edges ordered, append them
+        _epoch++;
+        node_iterator I = GTraits::nodes_begin(_graph);
+        node_iterator E = GTraits::nodes_end(_graph);
+        for (; I != E; ++I) {
+            NodeID n = GTraits::getNodeID(*I);
+            if (repNode(n) != n)
+                continue;
+            position(n);
+            _fwdMark[n] = _epoch;
+        }
+
+        for (u32_t i = _nodeAt.size(); i > 0; i--) {
+            NodeID n = _nodeAt[i - 1];
+            if (n != UINT_MAX && _fwdMark[n] == _epoch)
+                _T.push(n);
+        }
+        return _T;
+    }
+
+    const inline GraphType & graph() {
+        return _graph;
+    }
+
+private:
+    const GraphType &   _graph;
+    bool                _valid;
+    std::vector<u32_t>  _ord;	///< position of a node in the order, UINT_MAX if not ordered
+    std::vector<NodeID> _nodeAt;	///< node at a position, UINT_MAX if the node has been merged
+    std::vector<NodeID> _rep;	///< rep of a node merged here, UINT_MAX if none
+    std::vector<u32_t>  _fwdMark;	///< epoch in which a node is reached from dst
+    std::vector<u32_t>  _bwdMark;	///< epoch in which a node is found to reach src
+    u32_t               _epoch;
+    Size_t              _visits;
+    std::vector<NodeID> _F;
+    std::vector<NodeID> _B;
+    std::vector<NodeID> _stack;
+    std::vector<u32_t>  _slots;
+    RepToSubsMap        _newSCCs;
+    NodeStack           _T;
+
+    /// Grow the per-node vectors to cover node n
+    inline void ensure(NodeID n) {
+        if (n >= _ord.size()) {
+            u32_t size = std::max<u32_t>(n + 1, _ord.size() * 2);
+            _ord.resize(size, UINT_MAX);
+            _rep.resize(size, UINT_MAX);
+            _fwdMark.resize(size, 0);
+            _bwdMark.resize(size, 0);
+        }
+    }
+
+    /// Position of node n, a node not ordered yet is appended
+    inline u32_t position(NodeID n) {
+        ensure(n);
+        if (_ord[n] == UINT_MAX) {
+            _ord[n] = _nodeAt.size();
+            _nodeAt.push_back(n);
+        }
+        return _ord[n];
+    }
+
+    /// Whether a node is ordered within [lb, ub], nodes not ordered have no edge added yet
+    inline bool inRange(NodeID n, u32_t lb, u32_t ub) const {
+        return n < _ord.size() && _ord[n] != UINT_MAX && _ord[n] >= lb && _ord[n] <= ub;
+    }
+
+    /// Visit succs (or preds) of all nodes in the SCC of rep
+    template<class Traits, class ChildIter>
+    inline void pushChildren(NodeID rep, std::vector<u32_t>& mark, u32_t lb, u32_t ub) {
+        typename RepToSubsMap::const_iterator sit = _newSCCs.find(rep);
+        if (sit == _newSCCs.end()) {
+            pushChildrenOfNode<Traits, ChildIter>(rep, mark, lb, ub);
+        }
+        else {
+            for (NodeBS::iterator it = sit->second.begin(), eit = sit->second.end(); it != eit; ++it)
+                pushChildrenOfNode<Traits, ChildIter>(*it, mark, lb, ub);
+        }
+    }
+    template<class Traits, class ChildIter>
+    inline void pushChildrenOfNode(NodeID n, std::vector<u32_t>& mark, u32_t lb, u32_t ub) {
+        GNODE* node = GTraits::getNode(_graph, n);
+        ChildIter EI = Traits::direct_child_begin(node);
+        ChildIter EE = Traits::direct_child_end(node);
+        for (; EI != EE; ++EI) {
+            NodeID w = repNode(GTraits::getNodeID(*EI));
+            if (inRange(w, lb, ub) && mark[w] != _epoch) {
+                mark[w] = _epoch;
+                _stack.push_back(w);
+            }
+        }
+    }
+
+    /// Collect nodes reachable from dst into F, return true if src is reached
+    bool searchForward(NodeID dst, NodeID src, u32_t lb, u32_t ub) {
+        _fwdMark[dst] = _epoch;
+        _stack.push_back(dst);
+        while (!_stack.empty()) {
+            NodeID n = _stack.back();
+            _stack.pop_back();
+            _F.push_back(n);
+            _visits++;
+            pushChildren<GTraits, child_iterator>(n, _fwdMark, lb, ub);
+        }
+        return _fwdMark[src] == _epoch;
+    }
+
+    /// Collect nodes reaching src into B
+    void searchBackward(NodeID src, u32_t lb, u32_t ub) {
+        _bwdMark[src] = _epoch;
+        _stack.push_back(src);
+        while (!_stack.empty()) {
+            NodeID n = _stack.back();
+            _stack.pop_back();
+            _B.push_back(n);
+            _visits++;
+            pushChildren<InvGTraits, inv_child_iterator>(n, _bwdMark, lb, ub);
+        }
+    }
+
+    /// Collapse nodes in both F and B into the one with the smallest ID, return the rep
+    NodeID mergeCycle() {
+        NodeID sccRep = UINT_MAX;
+        for (std::vector<NodeID>::const_iterator it = _F.begin(), eit = _F.end(); it != eit; ++it) {
+            if (_bwdMark[*it] == _epoch && *it < sccRep)
+                sccRep = *it;
+        }
+        assert(sccRep != UINT_MAX && "cycle not found?");
+
+        NodeBS& subs = _newSCCs[sccRep];
+        subs.set(sccRep);
+        for (std::vector<NodeID>::const_iterator it = _F.begin(), eit = _F.end(); it != eit; ++it) {
+            NodeID n = *it;
+            if (_bwdMark[n] != _epoch || n == sccRep)
+                continue;
+            _rep[n] = sccRep;
+            _ord[n] = UINT_MAX;
+            typename RepToSubsMap::iterator sit = _newSCCs.find(n);
+            if (sit != _newSCCs.end()) {
+                /// subs may be moved when the map grows, look it up again
+                NodeBS nSubs = sit->second;
+                _newSCCs.erase(sit);
+                _newSCCs[sccRep] |= nSubs;
+            }
+            else
+                _newSCCs[sccRep].set(n);
+        }
+        return sccRep;
+    }
+
+    /// Compare two nodes by their positions
+    struct OrdLess {
+        OrdLess(const std::vector<u32_t>& o) : ord(o) {}
+        bool operator()(NodeID lhs, NodeID rhs) const {
+            return ord[lhs] < ord[rhs];
+        }
+        const std::vector<u32_t>& ord;
+    };
+
+    /// Move B (then the new SCC) before F using the positions they took. Nodes of B only
+    /// move backwards and nodes of F only move forwards, so edges from and to the nodes
+    /// outside stay in order. Positions left by nodes merged into the new SCC become empty.
+    void reorder(NodeID sccRep) {
+        removeMerged(_B, sccRep);
+        removeMerged(_F, sccRep);
+        std::sort(_B.begin(), _B.end(), OrdLess(_ord));
+        std::sort(_F.begin(), _F.end(), OrdLess(_ord));
+
+        u32_t lo = 0;
+        for (std::vector<NodeID>::const_iterator it = _B.begin(), eit = _B.end(); it != eit; ++it)
+            place(*it, _slots[lo++]);
+        u32_t hi = _slots.size() - _F.size();
+        for (std::vector<NodeID>::const_iterator it = _F.begin(), eit = _F.end(); it != eit; ++it)
+            place(*it, _slots[hi++]);
+        hi = _slots.size() - _F.size();
+        if (sccRep != UINT_MAX)
+            place(sccRep, _slots[--hi]);
+        for (; lo < hi; lo++)
+            _nodeAt[_slots[lo]] = UINT_MAX;
+    }
+
+    /// Remove the nodes of the new SCC, including its rep which is placed separately
+    inline void removeMerged(std::vector<NodeID>& nodes, NodeID sccRep) {
+        if (sccRep == UINT_MAX)
+            return;
+        u32_t j = 0;
+        for (u32_t i = 0; i < nodes.size(); i++) {
+            NodeID n = nodes[i];
+            if (n != sccRep && _rep[n] == UINT_MAX)
+                nodes[j++] = n;
+        }
+        nodes.resize(j);
+    }
+
+    inline void place(NodeID n, u32_t slot) {
+        _ord[n] = slot;
+        _nodeAt[slot] = n;
+    }
+
+    /// Not copyable
+    IncrementalSCCDetection(const IncrementalSCCDetection&);
+    void operator=(const IncrementalSCCDetection&);
+};
+
+#endif /* INCREMENTALSCC_H_ */
@@ -128,8 +128,8 @@ class PTACallGraphNode : public GenericCallGraphNodeTy {
 
 public:
     typedef PTACallGraphEdge::CallGraphEdgeSet CallGraphEdgeSet;
-    typedef PTACallGraphEdge::CallGraphEdgeSet::iterator iterator;
-    typedef PTACallGraphEdge::CallGraphEdgeSet::const_iterator const_iterator;
+    typedef GenericCallGraphNodeTy::iterator iterator;
+    typedef GenericCallGraphNodeTy::const_iterator const_iterator;
 
 private:
     const llvm::Function* fun;
@@ -164,7 +164,7 @@ public:
     typedef std::map<CallSiteID, CallSitePair> IdToCallSiteMap;
     typedef	std::set<const llvm::Function*> FunctionSet;
     typedef std::map<llvm::CallSite, FunctionSet> CallEdgeMap;
-    typedef CallGraphEdgeSet::iterator CallGraphNodeIter;
+    typedef PTACallGraphNode::iterator CallGraphNodeIter;
 
 private:
     llvm::Module* mod;
@@ -125,7 +125,8 @@ public:
 
     virtual void performStat();
 
-    virtual void printStat();
+    /// Print the maps and record them under statname in the profile report
+    virtual void printStat(std::string statname = "Stat");
 
     virtual void performStatPerQuery(NodeID ptr) {}
 
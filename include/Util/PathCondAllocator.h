@@ -39,9 +39,10 @@ public:
     typedef std::map<const llvm::BasicBlock*, Condition*> BBToCondMap;	///< map a basic block to its condition during control-flow guard computation
     typedef FIFOWorkList<const llvm::BasicBlock*> CFWorkList;	///< worklist for control-flow guard computation
 
-    /// Constructor
-    PathCondAllocator() {
-        getBddCondManager();
+    /// Constructor, conditions are created in the BDD manager shared by all allocators
+    /// unless ownCondMgr is set, e.g. for an allocator used by a single thread
+    PathCondAllocator(bool ownCondMgr = false): numOfOwnConds(0), ownsCondMgr(ownCondMgr) {
+        condMgr = ownCondMgr ? new BddCondManager() : getBddCondManager();
     }
     /// Destructor
     virtual ~PathCondAllocator() {
@@ -94,40 +95,53 @@ public:
     /// Condition operations
     //@{
     inline Condition* condAnd(Condition* lhs, Condition* rhs) {
-        return bddCondMgr->AND(lhs,rhs);
+        return condMgr->AND(lhs,rhs);
     }
     inline Condition* condOr(Condition* lhs, Condition* rhs) {
-        return bddCondMgr->OR(lhs,rhs);
+        return condMgr->OR(lhs,rhs);
     }
     inline Condition* condNeg(Condition* cond) {
-        return bddCondMgr->NEG(cond);
+        return condMgr->NEG(cond);
     }
+    /// Statistics of the BDD manager used by this allocator
+    //@{
+    inline u32_t getCondMgrMemUsage() const {
+        return condMgr->getBDDMemUsage();
+    }
+    inline u32_t getCondMgrCondNum() const {
+        return condMgr->getCondNumber();
+    }
+    inline u32_t getCondMgrMaxLiveCondNumber() const {
+        return condMgr->getMaxLiveCondNumber();
+    }
+    //@}
+
     inline Condition* getTrueCond() const {
-        return bddCondMgr->getTrueCond();
+        return condMgr->getTrueCond();
     }
     inline Condition* getFalseCond() const {
-        return bddCondMgr->getFalseCond();
+        return condMgr->getFalseCond();
     }
     /// Given an index, get its condition
     inline Condition* getCond(u32_t i) const {
-        return bddCondMgr->getCond(i);
+        return condMgr->getCond(i);
     }
     /// Iterator every element of the bdd
     inline NodeBS exactCondElem(Condition* cond) {
         NodeBS elems;
-        bddCondMgr->BddSupport(cond,elems);
+        condMgr->BddSupport(cond,elems);
         return elems;
     }
     /// Decrease reference counting for the bdd
     inline void markForRelease(Condition* cond) {
-        bddCondMgr->markForRelease(cond);
+        condMgr->markForRelease(cond);
     }
     /// Print debug information for this condition
     inline void printDbg(Condition* cond) {
-        bddCondMgr->printDbg(cond);
+        condMgr->printDbg(cond);
     }
     inline std::string dumpCond(Condition* cond) const {
-        return bddCondMgr->dumpStr(cond);
+        return condMgr->dumpStr(cond);
     }
     //@}
 
@@ -227,7 +241,8 @@ private:
 
     /// Allocate a new condition
     inline Condition* newCond(const llvm::TerminatorInst* inst) {
-        Condition* cond = bddCondMgr->createNewCond(totalCondNum++);
+        u32_t index = ownsCondMgr ? numOfOwnConds++ : totalCondNum++;
+        Condition* cond = condMgr->createNewCond(index);
         assert(condToInstMap.find(cond)==condToInstMap.end() && "this should be a fresh condition");
         condToInstMap[cond] = inst;
         return cond;
@@ -247,6 +262,9 @@ private:
     FunToExitBBsMap funToExitBBsMap;		///< map a function to all its basic blocks calling program exit
     BBToCondMap bbToCondMap;				///< map a basic block to its path condition starting from root
     const llvm::Value* curEvalVal;			///< current llvm value to evaluate branch condition when computing guards
+    BddCondManager* condMgr;				///< bdd manager of this allocator
+    u32_t numOfOwnConds;					///< number of conditions created in an own bdd manager
+    bool ownsCondMgr;						///< whether condMgr is owned by this allocator
 
 protected:
     static BddCondManager* bddCondMgr;		///< bbd manager
@@ -0,0 +1,441 @@
+//===- PointsTo.h -- Hybrid points-to set------------------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PointsTo.h
+ *
+ *  Hybrid points-to set: small sets are stored inline in a sorted array and
+ *  promoted to a sparse bit vector once they grow beyond SmallSize elements.
+ *  The interface follows llvm::SparseBitVector so that it can be used in place of it.
+ */
+
+#ifndef POINTSTOSET_H_
+#define POINTSTOSET_H_
+
+#include <llvm/ADT/SparseBitVector.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
+#include <utility>
+#include <assert.h>
+
+class PointsTo {
+
+public:
+    typedef unsigned ElemTy;
+    typedef llvm::SparseBitVector<> BitVector;
+
+    /// Maximum number of elements stored inline
+    static const unsigned SmallSize = 4;
+
+    /*!
+     * Iterator over the elements in ascending order
+     * It refers to its set and the current element rather than to the inline array, so elements
+     * may be added while iterating (e.g., test_and_set or |= of the set being iterated), even if
+     * that promotes the set; elements added before the current one are not visited.
+     * Elements added after the current one are visited only while the set is inline. A promoted
+     * set is iterated as a SparseBitVector, whose iterator caches the bits of the current word,
+     * so such elements may or may not be visited. It must not shrink while iterating.
+     */
+    class iterator {
+    public:
+        /// Iterator at the first element of p, or at its end
+        iterator(const PointsTo* p, bool atEnd) : pts(p), cur(0), idx(0), large(p->isLarge()), end(atEnd) {
+            if (end)
+                return;
+            if (large) {
+                bvIt = pts->bv->begin();
+                syncBV();
+            }
+            else {
+                end = (pts->num == 0);
+                if (!end)
+                    cur = pts->inl[0];
+            }
+        }
+
+        inline ElemTy operator*() const {
+            return cur;
+        }
+        inline iterator& operator++() {
+            if (large && pts->isLarge()) {
+                ++bvIt;
+                syncBV();
+            }
+            else if (!pts->isLarge())
+                nextInline();
+            else {
+                /// the set has been promoted since the last step, continue after cur in the bit vector
+                ElemTy prev = cur;
+                large = true;
+                for (bvIt = pts->bv->begin(), syncBV(); !end && cur <= prev; syncBV())
+                    ++bvIt;
+            }
+            return *this;
+        }
+        inline iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        inline bool operator==(const iterator& rhs) const {
+            return end == rhs.end && (end || cur == rhs.cur);
+        }
+        inline bool operator!=(const iterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+    private:
+        /// Update cur and end from the bit vector iterator
+        inline void syncBV() {
+            end = (bvIt == pts->bv->end());
+            if (!end)
+                cur = *bvIt;
+        }
+        /// Move to the first inline element after cur, idx is the position of cur unless elements have moved
+        inline void nextInline() {
+            large = false;
+            const ElemTy* first = pts->inl;
+            const ElemTy* last = first + pts->num;
+            const ElemTy* pos = (idx < pts->num && first[idx] == cur) ? first + idx + 1 : std::upper_bound(first, last, cur);
+            end = (pos == last);
+            if (!end) {
+                idx = pos - first;
+                cur = *pos;
+            }
+        }
+
+        const PointsTo* pts;
+        ElemTy cur;	///< current element
+        unsigned idx;	///< position of cur in an inline set
+        BitVector::iterator bvIt;	///< position in a promoted set, only set in large mode
+        bool large;
+        bool end;
+    };
+    typedef iterator const_iterator;
+
+    /// Constructors
+    //@{
+    PointsTo() : num(0) {}
+
+    PointsTo(const PointsTo& rhs) : num(0) {
+        *this = rhs;
+    }
+
+    PointsTo(const BitVector& rhs) : num(0) {
+        *this = rhs;
+    }
+
+    PointsTo(PointsTo&& rhs) noexcept : num(0) {
+        *this = std::move(rhs);
+    }
+    //@}
+
+    /// Destructor
+    ~PointsTo() {
+        if (isLarge())
+            delete bv;
+    }
+
+    /// Assignments
+    //@{
+    PointsTo& operator=(const PointsTo& rhs) {
+        if (this == &rhs)
+            return *this;
+        if (rhs.isLarge())
+            assignBV(*rhs.bv);
+        else {
+            if (isLarge())
+                delete bv;
+            num = rhs.num;
+            std::copy(rhs.inl, rhs.inl + rhs.num, inl);
+        }
+        return *this;
+    }
+
+    /// Take over the bit vector of a promoted rhs, rhs is left empty
+    PointsTo& operator=(PointsTo&& rhs) noexcept {
+        if (this == &rhs)
+            return *this;
+        if (isLarge())
+            delete bv;
+        num = rhs.num;
+        if (rhs.isLarge())
+            bv = rhs.bv;
+        else
+            std::copy(rhs.inl, rhs.inl + rhs.num, inl);
+        rhs.num = 0;
+        return *this;
+    }
+
+    PointsTo& operator=(const BitVector& rhs) {
+        assignBV(rhs);
+        return *this;
+    }
+    //@}
+
+    /// Whether the set has been promoted to a bit vector
+    inline bool isLarge() const {
+        return num == LargeTag;
+    }
+
+    inline iterator begin() const {
+        return iterator(this, false);
+    }
+    inline iterator end() const {
+        return iterator(this, true);
+    }
+
+    inline bool empty() const {
+        return isLarge() ? bv->empty() : num == 0;
+    }
+
+    inline unsigned count() const {
+        return isLarge() ? bv->count() : num;
+    }
+
+    /// Return the first element or -1 if the set is empty
+    inline int find_first() const {
+        if (isLarge())
+            return bv->find_first();
+        return num == 0 ? -1 : (int)inl[0];
+    }
+
+    /// Remove all elements, a promoted set is turned back to the inline form
+    inline void clear() {
+        if (isLarge())
+            delete bv;
+        num = 0;
+    }
+
+    inline bool test(ElemTy e) const {
+        if (isLarge())
+            return bv->test(e);
+        return std::binary_search(inl, inl + num, e);
+    }
+
+    inline void set(ElemTy e) {
+        test_and_set(e);
+    }
+
+    /// Add e into the set, return true if it was not in the set before
+    inline bool test_and_set(ElemTy e) {
+        if (isLarge())
+            return bv->test_and_set(e);
+
+        ElemTy* pos = std::lower_bound(inl, inl + num, e);
+        if (pos != inl + num && *pos == e)
+            return false;
+        if (num == SmallSize) {
+            promote();
+            bv->set(e);
+            return true;
+        }
+        std::copy_backward(pos, inl + num, inl + num + 1);
+        *pos = e;
+        num++;
+        return true;
+    }
+
+    inline void reset(ElemTy e) {
+        if (isLarge()) {
+            bv->reset(e);
+            return;
+        }
+        ElemTy* pos = std::lower_bound(inl, inl + num, e);
+        if (pos != inl + num && *pos == e) {
+            std::copy(pos + 1, inl + num, pos);
+            num--;
+        }
+    }
+
+    /// Union rhs into this set, return true if this set is changed
+    bool operator|=(const PointsTo& rhs) {
+        if (rhs.isLarge()) {
+            if (!isLarge())
+                promote();
+            return *bv |= *rhs.bv;
+        }
+        bool changed = false;
+        for (unsigned i = 0; i < rhs.num; i++)
+            changed |= test_and_set(rhs.inl[i]);
+        return changed;
+    }
+
+    /// Intersect this set with rhs, return true if this set is changed
+    bool operator&=(const PointsTo& rhs) {
+        if (isLarge() && rhs.isLarge())
+            return *bv &= *rhs.bv;
+        if (isLarge()) {
+            /// the result is no larger than rhs, hence is stored inline
+            PointsTo result;
+            for (unsigned i = 0; i < rhs.num; i++) {
+                if (bv->test(rhs.inl[i]))
+                    result.inl[result.num++] = rhs.inl[i];
+            }
+            bool changed = (result.num != bv->count());
+            *this = result;
+            return changed;
+        }
+        return removeIf(rhs, false);
+    }
+
+    /// Remove elements of rhs from this set, return true if this set is changed
+    bool intersectWithComplement(const PointsTo& rhs) {
+        if (isLarge() && rhs.isLarge())
+            return bv->intersectWithComplement(*rhs.bv);
+        if (isLarge()) {
+            bool changed = false;
+            for (unsigned i = 0; i < rhs.num; i++) {
+                if (bv->test(rhs.inl[i])) {
+                    bv->reset(rhs.inl[i]);
+                    changed = true;
+                }
+            }
+            return changed;
+        }
+        return removeIf(rhs, true);
+    }
+
+    /// This set = lhs - rhs
+    void intersectWithComplement(const PointsTo& lhs, const PointsTo& rhs) {
+        if (this == &rhs) {
+            PointsTo tmp(rhs);
+            intersectWithComplement(lhs, tmp);
+            return;
+        }
+        *this = lhs;
+        intersectWithComplement(rhs);
+    }
+
+    /// Return true if this set and rhs share any element
+    bool intersects(const PointsTo& rhs) const {
+        if (isLarge() && rhs.isLarge())
+            return bv->intersects(*rhs.bv);
+        const PointsTo& small = isLarge() ? rhs : *this;
+        const PointsTo& other = isLarge() ? *this : rhs;
+        for (unsigned i = 0; i < small.num; i++) {
+            if (other.test(small.inl[i]))
+                return true;
+        }
+        return false;
+    }
+
+    /// Return true if every element of rhs is in this set
+    bool contains(const PointsTo& rhs) const {
+        if (isLarge() && rhs.isLarge())
+            return bv->contains(*rhs.bv);
+        for (iterator it = rhs.begin(), eit = rhs.end(); it != eit; ++it) {
+            if (!test(*it))
+                return false;
+        }
+        return true;
+    }
+
+    bool operator==(const PointsTo& rhs) const {
+        if (isLarge() && rhs.isLarge())
+            return *bv == *rhs.bv;
+        if (!isLarge() && !rhs.isLarge())
+            return num == rhs.num && std::equal(inl, inl + num, rhs.inl);
+        /// a promoted set may have shrunk back to SmallSize elements or fewer
+        const PointsTo& small = isLarge() ? rhs : *this;
+        const PointsTo& large = isLarge() ? *this : rhs;
+        if (small.num != large.bv->count())
+            return false;
+        return large.contains(small);
+    }
+
+    inline bool operator!=(const PointsTo& rhs) const {
+        return !(*this == rhs);
+    }
+
+    /// Return the elements in a sparse bit vector
+    BitVector toBitVector() const {
+        if (isLarge())
+            return *bv;
+        BitVector result;
+        for (unsigned i = 0; i < num; i++)
+            result.set(inl[i]);
+        return result;
+    }
+
+private:
+    /// Tag of num if the set has been promoted
+    static const unsigned LargeTag = ~0U;
+
+    /// Move inline elements into a newly allocated bit vector
+    void promote() {
+        assert(!isLarge() && "already promoted");
+        BitVector* newBV = new BitVector();
+        for (unsigned i = 0; i < num; i++)
+            newBV->set(inl[i]);
+        bv = newBV;
+        num = LargeTag;
+    }
+
+    void assignBV(const BitVector& rhs) {
+        if (isLarge()) {
+            if (bv != &rhs)
+                *bv = rhs;
+            return;
+        }
+        bv = new BitVector(rhs);
+        num = LargeTag;
+    }
+
+    /// Remove inline elements which are (remove == true) or are not (remove == false) in rhs
+    bool removeIf(const PointsTo& rhs, bool remove) {
+        assert(!isLarge() && "expect inline elements");
+        unsigned newNum = 0;
+        for (unsigned i = 0; i < num; i++) {
+            if (rhs.test(inl[i]) != remove)
+                inl[newNum++] = inl[i];
+        }
+        bool changed = (newNum != num);
+        num = newNum;
+        return changed;
+    }
+
+    unsigned num;	///< number of inline elements, LargeTag if promoted
+    union {
+        ElemTy inl[SmallSize];	///< inline elements in ascending order
+        BitVector* bv;	///< elements after promotion
+    };
+};
+
+/// Set operations returning a new set
+//@{
+inline PointsTo operator|(const PointsTo& lhs, const PointsTo& rhs) {
+    PointsTo result(lhs);
+    result |= rhs;
+    return result;
+}
+inline PointsTo operator&(const PointsTo& lhs, const PointsTo& rhs) {
+    PointsTo result(lhs);
+    result &= rhs;
+    return result;
+}
+inline PointsTo operator-(const PointsTo& lhs, const PointsTo& rhs) {
+    PointsTo result;
+    result.intersectWithComplement(lhs, rhs);
+    return result;
+}
+//@}
+
+/// Dump a points-to set in the same format as llvm::dump(SparseBitVector)
+inline void dump(const PointsTo& pts, llvm::raw_ostream& out) {
+    out << "[";
+    for (PointsTo::iterator it = pts.begin(), eit = pts.end(); it != eit; ++it) {
+        if (it != pts.begin())
+            out << " ";
+        out << *it;
+    }
+    out << "]\n";
+}
+
+#endif /* POINTSTOSET_H_ */
@@ -0,0 +1,164 @@
+//===- PointsToPool.h -- Hash-consed points-to sets---------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PointsToPool.h
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  A pool keeping one copy of every distinct points-to set. Users hold a handle
+ *  to an immutable interned set, so objects (e.g. indirect SVFG edges) carrying
+ *  the points-to set of the same memory region share it. A handle is grown by
+ *  copy-on-write: the set is only modified in place if nobody else holds it.
+ */
+
+#ifndef POINTSTOPOOL_H_
+#define POINTSTOPOOL_H_
+
+#include "Util/PointsTo.h"
+#include "Util/BasicTypes.h"
+
+#include <unordered_map>
+
+class PointsToPool {
+
+public:
+    /*!
+     * An interned points-to set and the number of handles to it
+     */
+    class Entry {
+        friend class PointsToPool;
+    public:
+        inline const PointsTo& getPointsTo() const {
+            return pts;
+        }
+    private:
+        Entry(const PointsTo& p, size_t h): pts(p), hash(h), refs(0) {}
+        PointsTo pts;
+        size_t hash;
+        u32_t refs;
+    };
+    typedef const Entry* Handle;
+
+    PointsToPool() {}
+
+    ~PointsToPool() {
+        for (HashToEntryMap::iterator it = entries.begin(), eit = entries.end(); it != eit; ++it)
+            delete it->second;
+    }
+
+    /// The empty set, which is the points-to set of a NULL handle
+    static inline const PointsTo& emptyPointsTo() {
+        static const PointsTo empty;
+        return empty;
+    }
+    static inline const PointsTo& getPointsTo(Handle h) {
+        return h ? h->getPointsTo() : emptyPointsTo();
+    }
+
+    /// Union pts into the set of handle h, return true if the set is changed.
+    /// h then refers to the interned result, other handles to the old set are not affected.
+    bool add(Handle& h, const PointsTo& pts) {
+        if (pts.empty())
+            return false;
+        if (h == NULL) {
+            h = acquire(pts, hashOf(pts));
+            return true;
+        }
+        if (h->pts.contains(pts))
+            return false;
+
+        Entry* entry = const_cast<Entry*>(h);
+        if (entry->refs == 1) {
+            /// nobody else holds the set, grow it in place
+            erase(entry);
+            entry->pts |= pts;
+            entry->hash = hashOf(entry->pts);
+            if (Entry* same = find(entry->pts, entry->hash)) {
+                delete entry;
+                same->refs++;
+                h = same;
+            }
+            else
+                entries.insert(std::make_pair(entry->hash, entry));
+            return true;
+        }
+
+        PointsTo merged = entry->pts;
+        merged |= pts;
+        release(h);
+        h = acquire(merged, hashOf(merged));
+        return true;
+    }
+
+    /// Drop a handle, the set is removed from the pool once it has no handle
+    void release(Handle h) {
+        if (h == NULL)
+            return;
+        Entry* entry = const_cast<Entry*>(h);
+        assert(entry->refs > 0 && "releasing a set without handle");
+        if (--entry->refs == 0) {
+            erase(entry);
+            delete entry;
+        }
+    }
+
+    /// Number of distinct sets in the pool
+    inline size_t size() const {
+        return entries.size();
+    }
+
+private:
+    typedef std::unordered_multimap<size_t, Entry*> HashToEntryMap;
+
+    static size_t hashOf(const PointsTo& pts) {
+        size_t hash = pts.count();
+        for (PointsTo::iterator it = pts.begin(), eit = pts.end(); it != eit; ++it)
+            hash = hash * 31 + *it;
+        return hash;
+    }
+
+    Entry* find(const PointsTo& pts, size_t hash) const {
+        std::pair<HashToEntryMap::const_iterator, HashToEntryMap::const_iterator> range = entries.equal_range(hash);
+        for (HashToEntryMap::const_iterator it = range.first; it != range.second; ++it) {
+            if (it->second->pts == pts)
+                return it->second;
+        }
+        return NULL;
+    }
+
+    Entry* acquire(const PointsTo& pts, size_t hash) {
+        Entry* entry = find(pts, hash);
+        if (entry == NULL) {
+            entry = new Entry(pts, hash);
+            entries.insert(std::make_pair(hash, entry));
+        }
+        entry->refs++;
+        return entry;
+    }
+
+    void erase(Entry* entry) {
+        std::pair<HashToEntryMap::iterator, HashToEntryMap::iterator> range = entries.equal_range(entry->hash);
+        for (HashToEntryMap::iterator it = range.first; it != range.second; ++it) {
+            if (it->second == entry) {
+                entries.erase(it);
+                return;
+            }
+        }
+        assert(false && "set not in the pool");
+    }
+
+    /// The pool owns its sets, it can not be copied
+    PointsToPool(const PointsToPool&);
+    void operator=(const PointsToPool&);
+
+    HashToEntryMap entries;
+};
+
+#endif /* POINTSTOPOOL_H_ */
@@ -0,0 +1,107 @@
+//===- Profiler.h -- Wall-clock phase and counter profiling-------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * Profiler.h
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  Scoped wall-clock timers and counters enabled by -profile. A ProfileScope
+ *  opens a phase nested in the phases open on the same thread, so every thread
+ *  builds its own tree of phase paths (e.g. FlowSensitive/solve/load) and its
+ *  own counters without locking. Profiler::report merges the threads, prints a
+ *  summary and writes it together with the statistics of PTAStat as JSON to
+ *  the file of -profile-json. Without -profile a counter only tests a flag,
+ *  and a scope only reads the clock for a total which is always reported.
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include "Util/BasicTypes.h"
+#include <string>
+
+/*!
+ * Process-wide profile of phases, counters and statistics
+ */
+class Profiler {
+public:
+    typedef unsigned long long Count;
+
+    static bool enabled;	///< set by -profile
+
+    static inline bool isEnabled() {
+        return enabled;
+    }
+
+    /// Monotonic wall clock in ms
+    static inline double getClk() {
+        return CLOCK_IN_MS();
+    }
+
+    /// Phases of the calling thread, use ProfileScope instead of calling them directly
+    //@{
+    static void beginPhase(const char* name);
+    static void endPhase(double elapsed);
+    //@}
+
+    /// Add n to a counter of the calling thread
+    static inline void addCount(const char* name, Count n = 1) {
+        if (enabled)
+            addThreadCount(name, n);
+    }
+
+    /// Record a statistic of a group (a row of the PTAStat maps), the last value wins
+    static void setStat(const std::string& group, const std::string& name, double value);
+
+    /// Print the merged profile and write it to the JSON file, no-op if not enabled
+    static void report();
+
+private:
+    static void addThreadCount(const char* name, Count n);
+};
+
+/*!
+ * Time a phase from construction to destruction when profiling is enabled,
+ * and optionally add the elapsed seconds to a total kept by the analysis
+ * (which is not synchronized, so a total must belong to one thread).
+ * The total of a coarse phase which is always reported is also kept without
+ * -profile if alwaysTimed is set, the totals of fine-grained phases are only
+ * meaningful with -profile.
+ */
+class ProfileScope {
+public:
+    ProfileScope(const char* name, double* t = NULL, bool alwaysTimed = false)
+        : total(t), start(0), active(Profiler::isEnabled()), timed(active || (t && alwaysTimed)) {
+        if (active)
+            Profiler::beginPhase(name);
+        if (timed)
+            start = Profiler::getClk();
+    }
+    ~ProfileScope() {
+        if (timed) {
+            double elapsed = Profiler::getClk() - start;
+            if (active)
+                Profiler::endPhase(elapsed);
+            if (total)
+                *total += elapsed / TIMEINTERVAL;
+        }
+    }
+
+private:
+    ProfileScope(const ProfileScope&);
+    void operator=(const ProfileScope&);
+
+    double* total;
+    double start;
+    bool active;	///< record the phase in the profile
+    bool timed;	///< read the clock
+};
+
+#endif /* PROFILER_H_ */
@@ -20,6 +20,11 @@
  *
  * And influenced by implementation from Open64 compiler
  *
+ * The depth-first search runs on an explicit stack, so that long chains on the
+ * graph do not overflow the call stack. Per-node state is kept in vectors indexed
+ * by NodeID, and a set of sub nodes is only allocated for a rep of a multi-node
+ * SCC, or when the sub nodes of a single-node SCC are asked for.
+ *
  *  Created on: Jul 12, 2013
  *      Author: yusui
  */
@@ -30,11 +35,10 @@
 #include <llvm/ADT/GraphTraits.h>
 #include <llvm/ADT/SparseBitVector.h>	// for NodeBS
 #include <limits.h>
+#include <algorithm>
 #include <stack>
-#include <map>
-
+#include <vector>
 
-class GNodeSCCInfo;
 
 template<class GraphType>
 class SCCDetection {
@@ -51,49 +55,26 @@ public:
     typedef llvm::SparseBitVector<> NodeBS;
     typedef std::stack<NodeID> GNodeStack;
 
-    class GNodeSCCInfo {
-    public:
-        GNodeSCCInfo() : _visited(false), _inSCC(false), _rep(UINT_MAX) {}
+    /// SCC information of a node
+    struct GNodeSCCInfo {
+        GNodeSCCInfo() : _D(0), _rep(UINT_MAX), _inSCC(false), _inCycle(false) {}
 
-        inline bool visited(void) const {
-            return _visited;
-        }
-        inline void visited(bool v)     {
-            _visited = v;
-        }
-        inline bool inSCC(void)   const {
-            return _inSCC;
-        }
-        inline void inSCC(bool v)       {
-            _inSCC = v;
-        }
-        inline NodeID rep(void)const {
-            return _rep;
-        }
-        inline void rep(NodeID n)    {
-            _rep = n;
-        }
-        inline void addSubNodes(NodeID n)    {
-            _subNodes.set(n);
-        }
-        inline const NodeBS& subNodes() const   {
-            return _subNodes;
-        }
-    private:
-        bool     _visited;
-        bool     _inSCC;
-        NodeID  _rep;
-        NodeBS _subNodes; /// nodes in the scc represented by this node
+        NodeID _D;	///< visiting order, 0 if not visited yet
+        NodeID _rep;	///< rep node, UINT_MAX if not visited yet
+        bool _inSCC;	///< whether the SCC of this node has been found
+        bool _inCycle;	///< whether this node is the rep of a multi-node SCC
     };
-
-    typedef std::map<NodeID,GNodeSCCInfo > GNODESCCInfoMap;
-    typedef std::map<NodeID,NodeID > NodeToNodeMap;
+    typedef std::vector<GNodeSCCInfo> GNODESCCInfoVector;
 
     SCCDetection(const GraphType &GT)
         : _graph(GT),
           _I(0)
     {}
 
+    ~SCCDetection() {
+        clearSubNodes();
+    }
+
 
     // Return a handle to the stack of nodes in topological
     // order.  This will be used to seed the initial solution
@@ -102,24 +83,22 @@ public:
         return _T;
     }
 
-    const inline  GNODESCCInfoMap &GNodeSCCInfo() const {
-        return _NodeSCCAuxInfo;
-    }
-
-    /// get the rep node if not found return itself
+    /// get the rep node if not found return itself (also for nodes added after the detection)
     inline NodeID repNode(NodeID n) const {
-        typename GNODESCCInfoMap::const_iterator it = _NodeSCCAuxInfo.find(n);
-        assert(it!=_NodeSCCAuxInfo.end() && "scc rep not found");
-        NodeID rep = it->second.rep();
+        if (n >= _info.size())
+            return n;
+        NodeID rep = _info[n]._rep;
         return rep!= UINT_MAX ? rep : n ;
     }
 
 
-    /// whether the node is in a cycle
+    /// whether the node is in a cycle, false for nodes added after the detection
     inline bool isInCycle(NodeID n) const {
+        if (n >= _info.size())
+            return false;
         NodeID rep = repNode(n);
         // multi-node cycle
-        if (subNodes(rep).count() > 1) {
+        if (_info[rep]._inCycle) {
             return true;
         }
         // self-cycle
@@ -135,11 +114,15 @@ public:
         }
     }
 
-    /// get all subnodes in one scc, if size is empty insert itself into the set
+    /// get all subnodes in one scc, if size is empty (or the node is added after the detection) insert itself into the set
     inline const NodeBS& subNodes(NodeID n)  const  {
-        typename GNODESCCInfoMap::const_iterator it = _NodeSCCAuxInfo.find(n);
-        assert(it!=_NodeSCCAuxInfo.end() && "scc rep not found");
-        return it->second.subNodes();
+        if (n >= _subNodes.size())
+            _subNodes.resize(n + 1, NULL);
+        if (_subNodes[n] == NULL) {
+            _subNodes[n] = new NodeBS();
+            _subNodes[n]->set(n);
+        }
+        return *_subNodes[n];
     }
 
     const inline GraphType & graph() {
@@ -147,37 +130,33 @@ public:
     }
 private:
 
-    GNODESCCInfoMap  _NodeSCCAuxInfo;
+    /// A node being visited and the next child to visit
+    struct VisitFrame {
+        VisitFrame(NodeID n, child_iterator b, child_iterator e) : node(n), child(b), end(e) {}
+        NodeID node;
+        child_iterator child;
+        child_iterator end;
+    };
+
+    GNODESCCInfoVector       _info;
+    mutable std::vector<NodeBS*> _subNodes;	///< sub nodes of a rep, allocated lazily
 
     const GraphType &           _graph;
     NodeID                   _I;
-    NodeToNodeMap            _D;
-    GNodeStack             _SS;
+    std::vector<NodeID>      _SS;
+    std::vector<NodeID>      _members;	///< nodes of the SCC being popped
     GNodeStack             _T;
+    std::vector<VisitFrame>  _visitStack;
 
-    inline bool visited(NodeID n)  {
-        return _NodeSCCAuxInfo[n].visited();
-    }
-    inline bool inSCC(NodeID n)    {
-        return _NodeSCCAuxInfo[n].inSCC();
-    }
+    /// Not copyable, sub node sets are owned by the detector
+    SCCDetection(const SCCDetection&);
+    void operator=(const SCCDetection&);
 
-    inline void setVisited(NodeID n,bool v) {
-        _NodeSCCAuxInfo[n].visited(v);
+    inline bool visited(NodeID n) const {
+        return _info[n]._D != 0;
     }
-    inline void setInSCC(NodeID n,bool v)   {
-        _NodeSCCAuxInfo[n].inSCC(v);
-    }
-    inline void rep(NodeID n, NodeID r)  {
-        _NodeSCCAuxInfo[n].rep(r);
-        _NodeSCCAuxInfo[r].addSubNodes(n);
-    }
-
-    inline NodeID rep(NodeID n) {
-        return _NodeSCCAuxInfo[n].rep();
-    }
-    inline bool isInSCC(NodeID n)    {
-        return _NodeSCCAuxInfo[n].inSCC();
+    inline NodeID rep(NodeID n) const {
+        return _info[n]._rep;
     }
 
     inline GNODE* Node(NodeID id) const {
@@ -188,53 +167,106 @@ private:
         return GTraits::getNodeID(node);
     }
 
-    void visit(NodeID v) {
-        // llvm::outs() << "visit GNODE: " << Node_Index(v)<< "\n";
+    /// Enter node v and push it onto the visit stack
+    inline void beginVisit(NodeID v) {
         _I += 1;
-        _D[v] = _I;
-        this->rep(v,v);
-        this->setVisited(v,true);
-
-        child_iterator EI = GTraits::direct_child_begin(Node(v));
-        child_iterator EE = GTraits::direct_child_end(Node(v));
-
-        for (; EI != EE; ++EI) {
-            NodeID w = Node_Index(*EI);
-
-            if (!this->visited(w))
-                visit(w);
-            if (!this->inSCC(w))
-            {
-                NodeID rep;
-                rep = _D[this->rep(v)] < _D[this->rep(w)] ?
-                      this->rep(v) : this->rep(w);
-                this->rep(v,rep);
-            }
+        _info[v]._D = _I;
+        _info[v]._rep = v;
+        GNODE* node = Node(v);
+        _visitStack.push_back(VisitFrame(v, GTraits::direct_child_begin(node), GTraits::direct_child_end(node)));
+    }
+
+    /// Child w of v has been visited, update the rep of v
+    inline void visitChild(NodeID v, NodeID w) {
+        if (!_info[w]._inSCC) {
+            NodeID rv = rep(v);
+            NodeID rw = rep(w);
+            _info[v]._rep = _info[rv]._D < _info[rw]._D ? rv : rw;
         }
-        if (this->rep(v) == v) {
-            this->setInSCC(v,true);
+    }
+
+    /// All children of v have been visited, pop the SCC of v if v is its root
+    inline void finishVisit(NodeID v) {
+        if (rep(v) == v) {
+            _info[v]._inSCC = true;
+            _members.clear();
             while (!_SS.empty()) {
-                NodeID w = _SS.top();
-                if (_D[w] <= _D[v])
+                NodeID w = _SS.back();
+                if (_info[w]._D <= _info[v]._D)
                     break;
                 else {
-                    _SS.pop();
-                    this->setInSCC(w,true);
-                    this->rep(w,v);
+                    _SS.pop_back();
+                    _info[w]._inSCC = true;
+                    _info[w]._rep = v;
+                    _members.push_back(w);
                 }
             }
+            if (!_members.empty()) {
+                /// sparse bit vectors are cheap to fill in ascending order only
+                _members.push_back(v);
+                std::sort(_members.begin(), _members.end());
+                NodeBS* subs = new NodeBS();
+                for (std::vector<NodeID>::const_iterator it = _members.begin(), eit = _members.end(); it != eit; ++it)
+                    subs->set(*it);
+                _info[v]._inCycle = true;
+                _subNodes[v] = subs;
+            }
             _T.push(v);
         }
         else
-            _SS.push(v);
+            _SS.push_back(v);
     }
 
+    void visit(NodeID root) {
+        beginVisit(root);
+        while (!_visitStack.empty()) {
+            VisitFrame& frame = _visitStack.back();
+            if (frame.child != frame.end) {
+                NodeID w = Node_Index(*frame.child);
+                if (!this->visited(w)) {
+                    /// frame is invalidated by the push, w is finished when its frame is popped
+                    beginVisit(w);
+                    continue;
+                }
+                visitChild(frame.node, w);
+                ++frame.child;
+            }
+            else {
+                NodeID v = frame.node;
+                _visitStack.pop_back();
+                finishVisit(v);
+                if (!_visitStack.empty()) {
+                    VisitFrame& parent = _visitStack.back();
+                    visitChild(parent.node, v);
+                    ++parent.child;
+                }
+            }
+        }
+    }
+
+    void clearSubNodes() {
+        for (typename std::vector<NodeBS*>::iterator it = _subNodes.begin(), eit = _subNodes.end(); it != eit; ++it) {
+            delete *it;
+            *it = NULL;
+        }
+    }
+
+    /// Reset the state of all nodes, nodes are indexed up to the largest NodeID on the graph
     void clear() {
-        _NodeSCCAuxInfo.clear();
+        clearSubNodes();
+        NodeID maxId = 0;
+        node_iterator I = GTraits::nodes_begin(_graph);
+        node_iterator E = GTraits::nodes_end(_graph);
+        for (; I != E; ++I) {
+            NodeID node = Node_Index(*I);
+            if (node > maxId)
+                maxId = node;
+        }
+        _info.assign(maxId + 1, GNodeSCCInfo());
+        _subNodes.resize(maxId + 1, NULL);
         _I = 0;
-        _D.clear();
-        while(!_SS.empty())
-            _SS.pop();
+        _SS.clear();
+        _visitStack.clear();
         while(!_T.empty())
             _T.pop();
     }
@@ -248,18 +280,8 @@ public:
         node_iterator E = GTraits::nodes_end(_graph);
         for (; I != E; ++I) {
             NodeID node = Node_Index(*I);
-            if (!this->visited(node)) {
-                // We skip any nodes that have a representative other than
-                // themselves.  Such nodes occur as a result of merging
-                // nodes either through unifying an ACC or other node
-                // merging optimizations.  Any such node should have no
-                // outgoing edges and therefore should no longer be a member
-                // of an SCC.
-                if (this->rep(node) == UINT_MAX || this->rep(node) == node)
-                    visit(node);
-                else
-                    this->visited(node);
-            }
+            if (!this->visited(node))
+                visit(node);
         }
     }
 
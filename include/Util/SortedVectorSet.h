@@ -0,0 +1,130 @@
+//===- SortedVectorSet.h -- Set kept in a sorted vector-----------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * SortedVectorSet.h
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  A set whose elements are kept in a sorted vector. It takes one pointer-sized
+ *  slot per element instead of a tree node, iterating it walks contiguous memory
+ *  and looking up an element is a binary search. Inserting or erasing an element
+ *  moves the elements after it, so it suits small sets such as the edges of a
+ *  graph node. Unlike std::set, inserting or erasing invalidates all iterators.
+ */
+
+#ifndef SORTEDVECTORSET_H_
+#define SORTEDVECTORSET_H_
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+template<class T, class Compare = std::less<T> >
+class SortedVectorSet {
+
+public:
+    typedef std::vector<T> VectorTy;
+    typedef T key_type;
+    typedef T value_type;
+    typedef typename VectorTy::size_type size_type;
+    /// Elements are kept sorted, they can not be changed through an iterator
+    //@{
+    typedef typename VectorTy::const_iterator iterator;
+    typedef typename VectorTy::const_iterator const_iterator;
+    //@}
+
+    /// Constructors
+    //@{
+    SortedVectorSet() {}
+
+    template<class InputIterator>
+    SortedVectorSet(InputIterator first, InputIterator last) {
+        insert(first, last);
+    }
+    //@}
+
+    /// Iterators
+    //@{
+    inline const_iterator begin() const {
+        return elems.begin();
+    }
+    inline const_iterator end() const {
+        return elems.end();
+    }
+    //@}
+
+    inline bool empty() const {
+        return elems.empty();
+    }
+    inline size_type size() const {
+        return elems.size();
+    }
+    inline void clear() {
+        elems.clear();
+    }
+
+    /// Insert an element, return the position of the element and whether it is new
+    inline std::pair<iterator, bool> insert(const T& val) {
+        /// elements are usually created in order, check the back first
+        if (elems.empty() || comp(elems.back(), val)) {
+            elems.push_back(val);
+            return std::make_pair(iterator(elems.end() - 1), true);
+        }
+        typename VectorTy::iterator it = std::lower_bound(elems.begin(), elems.end(), val, comp);
+        if (!comp(val, *it))
+            return std::make_pair(iterator(it), false);
+        it = elems.insert(it, val);
+        return std::make_pair(iterator(it), true);
+    }
+
+    template<class InputIterator>
+    inline void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    /// Find an element, return end() if it is not in the set
+    inline const_iterator find(const T& val) const {
+        const_iterator it = std::lower_bound(elems.begin(), elems.end(), val, comp);
+        if (it != elems.end() && !comp(val, *it))
+            return it;
+        return elems.end();
+    }
+
+    inline size_type count(const T& val) const {
+        return find(val) != end() ? 1 : 0;
+    }
+
+    /// Erase an element, return the number of elements erased
+    inline size_type erase(const T& val) {
+        const_iterator it = find(val);
+        if (it == end())
+            return 0;
+        elems.erase(it);
+        return 1;
+    }
+
+    inline iterator erase(const_iterator pos) {
+        return elems.erase(pos);
+    }
+
+    inline bool operator==(const SortedVectorSet& rhs) const {
+        return elems == rhs.elems;
+    }
+    inline bool operator!=(const SortedVectorSet& rhs) const {
+        return elems != rhs.elems;
+    }
+
+private:
+    VectorTy elems;
+    Compare comp;
+};
+
+#endif /* SORTEDVECTORSET_H_ */
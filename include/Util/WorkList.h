@@ -28,6 +28,9 @@
 #include <vector>
 #include <deque>
 #include <set>
+#include <algorithm>
+#include <functional>
+#include <limits.h>
 
 /**
  * Worlist with "first come first go" order.
@@ -104,11 +107,11 @@ private:
 /**
  * Worlist with "first in first out" order.
  * New nodes will be pushed at back and popped from front.
- * Elements in the list are unique as they're recorded by std::set.
+ * Elements in the list are unique as they're recorded by std::set
+ * (or another set such as std::unordered_set for hashable data).
  */
-template<class Data>
+template<class Data, class DataSet = std::set<Data> >
 class FIFOWorkList {
-    typedef std::set<Data> DataSet;
     typedef std::deque<Data> DataDeque;
 public:
     FIFOWorkList() {}
@@ -219,6 +222,428 @@ private:
     DataVector data_list;	///< work list using std::vector.
 };
 
+/**
+ * Worklist with "first in first out" order for dense unsigned keys (e.g., NodeID).
+ * Membership is recorded in a flat bit vector indexed by the key instead of std::set,
+ * and elements are kept in a growable ring buffer, so that both push and pop are O(1).
+ * Elements in the list are unique.
+ */
+template<class Data>
+class DenseFIFOWorkList {
+    typedef std::vector<bool> DataBits;
+    typedef std::vector<Data> DataRing;
+    static const size_t InitCapacity = 64;	///< initial ring capacity (power of two)
+public:
+    DenseFIFOWorkList(): head(0), num(0) {}
+
+    ~DenseFIFOWorkList() {}
+
+    inline bool empty() const {
+        return num == 0;
+    }
+
+    inline size_t size() const {
+        return num;
+    }
+
+    inline bool find(Data data) const {
+        return (data < data_bits.size() && data_bits[data]);
+    }
+
+    /**
+     * Push a data into the work list.
+     */
+    inline bool push(Data data) {
+        if (data >= data_bits.size())
+            data_bits.resize(std::max<size_t>(data + 1, 2 * data_bits.size()), false);
+        if (data_bits[data])
+            return false;
+
+        if (num == data_ring.size())
+            grow();
+        data_ring[(head + num) & (data_ring.size() - 1)] = data;
+        data_bits[data] = true;
+        num++;
+        return true;
+    }
+
+    /**
+     * Pop a data from the FRONT of work list.
+     */
+    inline Data pop() {
+        assert(!empty() && "work list is empty");
+        Data data = data_ring[head];
+        head = (head + 1) & (data_ring.size() - 1);
+        num--;
+        data_bits[data] = false;
+        return data;
+    }
+
+    /*!
+     * Clear all the data
+     */
+    inline void clear() {
+        while (!empty())
+            pop();
+        head = 0;
+    }
+
+private:
+    /// Double the ring capacity and move the elements to the front in order
+    void grow() {
+        size_t cap = data_ring.empty() ? InitCapacity : 2 * data_ring.size();
+        DataRing newRing(cap);
+        for (size_t i = 0; i < num; i++)
+            newRing[i] = data_ring[(head + i) & (data_ring.size() - 1)];
+        data_ring.swap(newRing);
+        head = 0;
+    }
+
+    DataBits data_bits;	///< membership of each key.
+    DataRing data_ring;	///< ring buffer whose capacity is a power of two.
+    size_t head;	///< index of the first element.
+    size_t num;	///< number of elements in the list.
+};
+
+/**
+ * Worklist with "first in last out" order for dense unsigned keys (e.g., NodeID).
+ * Membership is recorded in a flat bit vector indexed by the key.
+ * Elements in the list are unique.
+ */
+template<class Data>
+class DenseFILOWorkList {
+    typedef std::vector<bool> DataBits;
+    typedef std::vector<Data> DataVector;
+public:
+    DenseFILOWorkList() {}
+
+    ~DenseFILOWorkList() {}
+
+    inline bool empty() const {
+        return data_list.empty();
+    }
+
+    inline size_t size() const {
+        return data_list.size();
+    }
+
+    inline bool find(Data data) const {
+        return (data < data_bits.size() && data_bits[data]);
+    }
+
+    /**
+     * Push a data into the work list.
+     */
+    inline bool push(Data data) {
+        if (data >= data_bits.size())
+            data_bits.resize(std::max<size_t>(data + 1, 2 * data_bits.size()), false);
+        if (data_bits[data])
+            return false;
+        data_list.push_back(data);
+        data_bits[data] = true;
+        return true;
+    }
+
+    /**
+     * Pop a data from the END of work list.
+     */
+    inline Data pop() {
+        assert(!empty() && "work list is empty");
+        Data data = data_list.back();
+        data_list.pop_back();
+        data_bits[data] = false;
+        return data;
+    }
+
+    /*!
+     * Clear all the data
+     */
+    inline void clear() {
+        while (!empty())
+            pop();
+    }
+
+private:
+    DataBits data_bits;	///< membership of each key.
+    DataVector data_list;	///< work list using std::vector.
+};
+
+/**
+ * Worklist ordered by a priority of each dense unsigned key (e.g., NodeID).
+ * The element with the lowest priority value is popped first, ties are broken by the key.
+ * Keys without a priority are given UINT_MAX, so that they are popped last.
+ * Elements in the list are unique.
+ */
+template<class Data>
+class DensePriorityWorkList {
+    typedef std::vector<bool> DataBits;
+    typedef std::vector<unsigned> PriorityVector;
+    typedef std::pair<unsigned, Data> HeapItem;
+    typedef std::vector<HeapItem> DataHeap;
+public:
+    DensePriorityWorkList() {}
 
+    ~DensePriorityWorkList() {}
+
+    inline bool empty() const {
+        return data_heap.empty();
+    }
+
+    inline size_t size() const {
+        return data_heap.size();
+    }
+
+    inline bool find(Data data) const {
+        return (data < data_bits.size() && data_bits[data]);
+    }
+
+    /// Set the priority of a data, it takes effect the next time the data is pushed
+    inline void setPriority(Data data, unsigned prio) {
+        if (data >= priorities.size())
+            priorities.resize(std::max<size_t>(data + 1, 2 * priorities.size()), UINT_MAX);
+        priorities[data] = prio;
+    }
+
+    inline unsigned getPriority(Data data) const {
+        return data < priorities.size() ? priorities[data] : UINT_MAX;
+    }
+
+    /// Forget the priorities of all data
+    inline void clearPriorities() {
+        priorities.clear();
+    }
+
+    /**
+     * Push a data into the work list.
+     */
+    inline bool push(Data data) {
+        if (data >= data_bits.size())
+            data_bits.resize(std::max<size_t>(data + 1, 2 * data_bits.size()), false);
+        if (data_bits[data])
+            return false;
+        data_heap.push_back(HeapItem(getPriority(data), data));
+        std::push_heap(data_heap.begin(), data_heap.end(), std::greater<HeapItem>());
+        data_bits[data] = true;
+        return true;
+    }
+
+    /**
+     * Pop the data with the lowest priority value.
+     */
+    inline Data pop() {
+        assert(!empty() && "work list is empty");
+        std::pop_heap(data_heap.begin(), data_heap.end(), std::greater<HeapItem>());
+        Data data = data_heap.back().second;
+        data_heap.pop_back();
+        data_bits[data] = false;
+        return data;
+    }
+
+    /*!
+     * Clear all the data
+     */
+    inline void clear() {
+        while (!empty())
+            pop();
+    }
+
+private:
+    DataBits data_bits;	///< membership of each key.
+    PriorityVector priorities;	///< priority of each key.
+    DataHeap data_heap;	///< binary min-heap of (priority, data).
+};
+
+/**
+ * Two-phase "least recently fired" worklist for dense unsigned keys (e.g., NodeID).
+ * Data are popped from the current phase and new data are pushed into the next phase.
+ * When the current phase is drained, the next phase becomes current and its data are
+ * ordered by the time they were last popped (fired), the least recently fired first.
+ * Elements in the list are unique.
+ */
+template<class Data>
+class DenseLRFWorkList {
+    typedef std::vector<bool> DataBits;
+    typedef std::vector<unsigned long long> FireTimeVector;
+    typedef std::pair<unsigned long long, Data> HeapItem;
+    typedef std::vector<HeapItem> DataHeap;
+    typedef std::vector<Data> DataVector;
+public:
+    DenseLRFWorkList(): clock(0) {}
+
+    ~DenseLRFWorkList() {}
+
+    inline bool empty() const {
+        return cur_heap.empty() && next_list.empty();
+    }
+
+    inline size_t size() const {
+        return cur_heap.size() + next_list.size();
+    }
+
+    inline bool find(Data data) const {
+        return (data < data_bits.size() && data_bits[data]);
+    }
+
+    /**
+     * Push a data into the next phase of the work list.
+     */
+    inline bool push(Data data) {
+        if (data >= data_bits.size()) {
+            size_t newSize = std::max<size_t>(data + 1, 2 * data_bits.size());
+            data_bits.resize(newSize, false);
+            fire_times.resize(newSize, 0);
+        }
+        if (data_bits[data])
+            return false;
+        next_list.push_back(data);
+        data_bits[data] = true;
+        return true;
+    }
+
+    /**
+     * Pop the least recently fired data of the current phase.
+     */
+    inline Data pop() {
+        assert(!empty() && "work list is empty");
+        if (cur_heap.empty())
+            nextPhase();
+        std::pop_heap(cur_heap.begin(), cur_heap.end(), std::greater<HeapItem>());
+        Data data = cur_heap.back().second;
+        cur_heap.pop_back();
+        data_bits[data] = false;
+        fire_times[data] = ++clock;
+        return data;
+    }
+
+    /*!
+     * Clear all the data
+     */
+    inline void clear() {
+        while (!empty())
+            pop();
+    }
+
+private:
+    /// Move the data of the next phase into the current phase
+    void nextPhase() {
+        for (typename DataVector::const_iterator it = next_list.begin(), eit = next_list.end(); it != eit; ++it)
+            cur_heap.push_back(HeapItem(fire_times[*it], *it));
+        next_list.clear();
+        std::make_heap(cur_heap.begin(), cur_heap.end(), std::greater<HeapItem>());
+    }
+
+    DataBits data_bits;	///< membership of each key.
+    FireTimeVector fire_times;	///< the last time each key was popped.
+    DataHeap cur_heap;	///< current phase, binary min-heap of (fire time, data).
+    DataVector next_list;	///< next phase.
+    unsigned long long clock;	///< number of pops so far.
+};
+
+/// Order in which NodeWorkList pops its elements
+enum WorkListOrder {
+    WL_FIFO,	///< first in first out
+    WL_LIFO,	///< last in first out
+    WL_TOPO,	///< lowest topological rank first
+    WL_LRF	///< two-phase least recently fired first
+};
+
+/**
+ * Worklist of dense unsigned keys (e.g., NodeID) whose order can be chosen at runtime.
+ * The TOPO order requires the rank of each key to be set via setPriority.
+ */
+template<class Data>
+class NodeWorkList {
+public:
+    NodeWorkList(): order(WL_FIFO) {}
+
+    ~NodeWorkList() {}
+
+    /// Get/Set the order, the list must be empty when the order is changed
+    //@{
+    inline WorkListOrder getOrder() const {
+        return order;
+    }
+    inline void setOrder(WorkListOrder o) {
+        assert(empty() && "change the order of a non-empty work list");
+        order = o;
+    }
+    //@}
+
+    /// Set the priority used by the TOPO order
+    //@{
+    inline void setPriority(Data data, unsigned prio) {
+        prioList.setPriority(data, prio);
+    }
+    inline void clearPriorities() {
+        prioList.clearPriorities();
+    }
+    //@}
+
+    inline bool empty() const {
+        switch (order) {
+        case WL_LIFO:
+            return filoList.empty();
+        case WL_TOPO:
+            return prioList.empty();
+        case WL_LRF:
+            return lrfList.empty();
+        default:
+            return fifoList.empty();
+        }
+    }
+
+    inline bool find(Data data) const {
+        switch (order) {
+        case WL_LIFO:
+            return filoList.find(data);
+        case WL_TOPO:
+            return prioList.find(data);
+        case WL_LRF:
+            return lrfList.find(data);
+        default:
+            return fifoList.find(data);
+        }
+    }
+
+    inline bool push(Data data) {
+        switch (order) {
+        case WL_LIFO:
+            return filoList.push(data);
+        case WL_TOPO:
+            return prioList.push(data);
+        case WL_LRF:
+            return lrfList.push(data);
+        default:
+            return fifoList.push(data);
+        }
+    }
+
+    inline Data pop() {
+        switch (order) {
+        case WL_LIFO:
+            return filoList.pop();
+        case WL_TOPO:
+            return prioList.pop();
+        case WL_LRF:
+            return lrfList.pop();
+        default:
+            return fifoList.pop();
+        }
+    }
+
+    inline void clear() {
+        fifoList.clear();
+        filoList.clear();
+        prioList.clear();
+        lrfList.clear();
+    }
+
+private:
+    WorkListOrder order;
+    DenseFIFOWorkList<Data> fifoList;
+    DenseFILOWorkList<Data> filoList;
+    DensePriorityWorkList<Data> prioList;
+    DenseLRFWorkList<Data> lrfList;
+};
 
 #endif /* WORKLIST_H_ */
@@ -21,8 +21,13 @@
 #include "WPA/WPAStat.h"
 #include "WPA/WPASolver.h"
 #include "MemoryModel/ConsG.h"
+#include "Util/IncrementalSCC.h"
+#include "Util/Profiler.h"
 #include <llvm/PassAnalysisSupport.h>	// analysis usage
 #include <llvm/Support/Debug.h>		// DEBUG TYPE
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 /*!
  * Inclusion-based Pointer Analysis
@@ -35,6 +40,16 @@ class Andersen:  public WPAConstraintSolver, public BVDataPTAImpl {
 public:
     typedef std::set<const ConstraintEdge*> EdgeSet;
     typedef SCCDetection<ConstraintGraph*> CGSCC;
+    typedef IncrementalSCCDetection<ConstraintGraph*> CGIncSCC;
+    typedef llvm::DenseMap<NodeID, NodeID> NodeToNodeMap;
+    typedef llvm::DenseMap<NodeID, NodeBS> NodeToNodeBSMap;
+
+    /// PAG edges added to and removed from a function since the last solve
+    struct PAGEdgeDiff {
+        PAGEdge::PAGEdgeSetTy addedEdges;
+        PAGEdge::PAGEdgeSetTy removedEdges;
+    };
+    typedef std::map<const llvm::Function*, PAGEdgeDiff> FunToPAGEdgeDiffMap;
 
     /// Pass ID
     static char ID;
@@ -48,6 +63,10 @@ public:
     static Size_t numOfProcessedStore;	/// Number of processed Store edge
 
     static Size_t numOfSCCDetection;
+    static Size_t numOfIncSCCDetection;
+    static Size_t numOfOfflineMergedNodes;
+    static Size_t numOfHCDMerges;
+    static double timeOfOfflineReduction;
     static double timeOfSCCDetection;
     static double timeOfSCCMerges;
     static double timeOfCollapse;
@@ -60,7 +79,7 @@ public:
 
     /// Constructor
     Andersen(PTATY type = Andersen_WPA)
-        :  BVDataPTAImpl(type), consCG(NULL)
+        :  BVDataPTAImpl(type), consCG(NULL), worklistTrace(NULL), incSCC(NULL), numOfInitialNodes(0)
     {
         reanalyze = false;
     }
@@ -70,17 +89,43 @@ public:
         if (consCG != NULL)
             delete consCG;
         consCG = NULL;
+        delete worklistTrace;
+        worklistTrace = NULL;
+        delete incSCC;
+        incSCC = NULL;
     }
     /// We start from here
     virtual bool runOnModule(llvm::Module& module);
 
     /// Andersen analysis
     virtual inline void analyze(llvm::Module& module) {
+        ProfileScope prof("Andersen");
+
         /// Initialization for the Solver
         initialize(module);
 
+        /// Reuse the results of a previous run on the same module if there is any
+        if (readResultCache(module)) {
+            finalize();
+            return;
+        }
+
         DBOUT(DGENERAL, llvm::outs() << analysisUtil::pasMsg("Start Solving Constraints\n"));
 
+        solveConstraints();
+
+        DBOUT(DGENERAL, llvm::outs() << analysisUtil::pasMsg("Finish Solving Constraints\n"));
+
+        writeResultCache();
+
+        /// finalize the analysis
+        finalize();
+    }
+
+    /// Solve all constraints from the address edges until no points-to set or call edge changes
+    inline void solveConstraints() {
+        reduceConstraintGraph();
+
         processAllAddr();
 
         do {
@@ -95,28 +140,30 @@ public:
             /// Start solving constraints
             solve();
 
-            double cgUpdateStart = stat->getClk();
+            ProfileScope prof("updateCallGraph", &timeOfUpdateCallGraph, true);
             if (updateCallGraph(getIndirectCallsites()))
                 reanalyze = true;
-            double cgUpdateEnd = stat->getClk();
-            timeOfUpdateCallGraph += (cgUpdateEnd - cgUpdateStart) / TIMEINTERVAL;
 
         } while (reanalyze);
-
-        DBOUT(DGENERAL, llvm::outs() << analysisUtil::pasMsg("Finish Solving Constraints\n"));
-
-        /// finalize the analysis
-        finalize();
     }
 
+    /// Re-solve after the PAG edges of some functions are changed.
+    /// Added edges must have been added into the PAG already, removed edges are kept in the PAG
+    /// but are ignored by this analysis from now on.
+    void solveIncrementally(const FunToPAGEdgeDiffMap& diffs);
+
     /// Initialize analysis
     virtual inline void initialize(llvm::Module& module) {
         resetData();
+        disableAliasCache();
         /// Build PAG
         PointerAnalysis::initialize(module);
         /// Build Constraint Graph
         consCG = new ConstraintGraph(pag);
         setGraph(consCG);
+        initIncSCC();
+        initWorklist();
+        initRevPts();
         /// Create statistic class
         stat = new AndersenStat(this);
 
@@ -131,7 +178,7 @@ public:
         /// TODO: Fields has been collapsed during Andersen::collapseField().
         //	sanitizePts();
 
-        PointerAnalysis::finalize();
+        BVDataPTAImpl::finalize();
     }
 
     /// Reset data
@@ -151,7 +198,8 @@ public:
         return (pta->getAnalysisTy() == Andersen_WPA
                 || pta->getAnalysisTy() == AndersenLCD_WPA
                 || pta->getAnalysisTy() == AndersenWave_WPA
-                || pta->getAnalysisTy() == AndersenWaveDiff_WPA);
+                || pta->getAnalysisTy() == AndersenWaveDiff_WPA
+                || pta->getAnalysisTy() == AndersenParallel_WPA);
     }
     //@}
 
@@ -160,15 +208,25 @@ public:
     inline NodeID sccRepNode(NodeID id) const {
         return consCG->sccRepNode(id);
     }
-    inline NodeBS& sccSubNodes(NodeID repId) {
+    inline NodeBS sccSubNodes(NodeID repId) const {
         return consCG->sccSubNodes(repId);
     }
+    inline bool hasSubNodes(NodeID repId) const {
+        return consCG->hasSubNodes(repId);
+    }
     //@}
 
     /// Get points-to set
     virtual inline PointsTo& getPts(NodeID id) {
         return getPTDataTy()->getPts(sccRepNode(id));
     }
+    virtual inline const PointsTo& getConstPts(NodeID id) {
+        return getPTDataTy()->getConstPts(sccRepNode(id));
+    }
+    /// Pointers in the same SCC share the points-to set of the rep node
+    virtual inline NodeID getPtsRepNode(NodeID id) {
+        return sccRepNode(id);
+    }
 
     /// Get constraint graph
     ConstraintGraph* getConstraintGraph() {
@@ -196,7 +254,7 @@ protected:
 
     virtual void processGep(NodeID node, const GepCGEdge* edge);
 
-    virtual void processGepPts(PointsTo& pts, const GepCGEdge* edge);
+    virtual void processGepPts(const PointsTo& pts, const GepCGEdge* edge);
     //@}
 
     /// Add copy edge on constraint graph
@@ -212,8 +270,9 @@ protected:
 
     /// Merge sub node in a SCC cycle to their rep node
     //@{
-    void mergeSccNodes(NodeID repNodeId, NodeBS & chanegdRepNodes);
+    void mergeSccNodes(NodeID repNodeId, const NodeBS& subNodes);
     void mergeSccCycle();
+    void mergeNewSccs();
     //@}
     /// Collapse a field object into its base for field insensitive anlaysis
     //@{
@@ -221,19 +280,94 @@ protected:
     bool collapseField(NodeID nodeId);
     //@}
 
-    /// Updates subnodes of its rep, and rep node of its subs
-    void updateNodeRepAndSubs(NodeID nodeId);
-
     /// SCC detection
     virtual NodeStack& SCCDetect();
 
+    /// Incremental SCC detection on the direct edges added since the last detection
+    //@{
+    void initIncSCC();
+    bool updateSCCIncrementally();
+    //@}
+
+    /// Offline constraint graph reduction before solving
+    //@{
+    void reduceConstraintGraph();
+    /// Merge nodes with the same points-to set by hash-based value numbering
+    void mergeEquivalentNodes();
+    /// Find the cycles through a single dereference *p to be collapsed when p is processed
+    void findHCDCycles();
+    /// Merge the objects pointed by a node into the cycle found offline for it
+    void mergeHCDCycle(NodeID nodeId);
+    /// Whether processNode consumes the cycles found by HCD, the offline search is skipped otherwise
+    virtual bool usesHCDCycles() const {
+        return true;
+    }
+    /// Whether an added PAG edge flows into a node merged offline
+    bool hasOfflineMergedDst(const PAGEdge::PAGEdgeSetTy& edges) const;
+
+    NodeBS offlineMergedNodes;	///< nodes merged by value numbering, including their reps
+    NodeToNodeBSMap hcdCycles;	///< pointer p -> nodes on the cycles through *p
+    //@}
+
     /// Constraint Graph
     ConstraintGraph* consCG;
 
+    /// Set the worklist order and open the worklist trace file as specified by user
+    void initWorklist();
+
+    /// Worklist trace file
+    llvm::raw_fd_ostream* worklistTrace;
+
+    /// Incremental SCC detection, NULL if SCCs are always detected on the whole graph
+    CGIncSCC* incSCC;
+
+    /// Keep reverse points-to only for field objects which may be collapsed, if specified by user
+    void initRevPts();
+
+    /// Persistent result cache keyed by module hash and options, if specified by user
+    //@{
+    bool readResultCache(llvm::Module& module);
+    void writeResultCache();
+    bool readResultCacheFile(const std::string& filename);
+    /// Options affecting the results, including the ones of constraint graph reduction
+    static std::string getOptionKey();
+    //@}
+
+    /// Incremental solving
+    //@{
+    /// Whether the solver can resume from a solved state by draining the worklist only
+    inline bool isIncrementalSolver() const {
+        return getAnalysisTy() == Andersen_WPA || getAnalysisTy() == AndersenLCD_WPA;
+    }
+    /// Remove the constraints of removed PAG edges and reset the points-to sets derived from them,
+    /// return false without changing anything if they can not be removed incrementally
+    bool removeConstraints(const PAGEdge::PAGEdgeSetTy& edges);
+    /// Add the constraints of added PAG edges
+    void addConstraints(const PAGEdge::PAGEdgeSetTy& edges);
+    /// Remove the constraint edge of a PAG edge
+    void removeConstraintEdge(const PAGEdge* edge);
+    /// Whether src and dst are still connected by a copy/call/ret/thread edge on the PAG
+    bool hasPAGCopyEdge(NodeID src, NodeID dst) const;
+    /// Process the nodes in the worklist and the new call edges found until nothing changes
+    void solveWorklist();
+    /// Drop all results and solve the constraints from scratch
+    void solveFromScratch();
+    /// Compare the points-to sets with the ones of a solve from scratch, whose results are kept
+    bool verifyWithSolveFromScratch(const std::string& solveName);
+
+    PAGEdge::PAGEdgeSetTy removedPAGEdges;	///< PAG edges removed by incremental updates
+    //@}
+
+    /// Hash of the module being analyzed and number of PAG nodes before solving
+    //@{
+    std::string moduleHash;
+    Size_t numOfInitialNodes;
+    //@}
+
     /// Sanitize pts for field insensitive objects
     void sanitizePts() {
         for(ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it!=eit; ++it) {
-            PointsTo& pts = getPts(it->first);
+            const PointsTo& pts = getConstPts(it->first);
             NodeBS fldInsenObjs;
             for(NodeBS::iterator pit = pts.begin(), epit = pts.end(); pit!=epit; ++pit) {
                 if(consCG->isFieldInsensitiveObj(*pit))
@@ -284,6 +418,11 @@ public:
 
     virtual bool handleLoad(NodeID id, const ConstraintEdge* load);
     virtual bool handleStore(NodeID id, const ConstraintEdge* store);
+
+    /// Wave propagation does not process nodes through Andersen::processNode
+    virtual bool usesHCDCycles() const {
+        return false;
+    }
 };
 
 
@@ -418,4 +557,134 @@ private:
     }
 };
 
+
+/*!
+ * Parallel Andersen analysis using per-thread work-stealing deques.
+ *
+ * Each round propagates points-to sets along copy edges concurrently: every thread
+ * pops nodes from the back of its own deque and steals from the front of the others.
+ * Points-to sets are guarded by striped locks, so two threads never update the same
+ * set at the same time. Addr/load/store/gep constraints change the constraint graph
+ * (new copy edges, new field objects), they are handled sequentially at the end of
+ * each round in NodeID order. Since the constraint system is monotone, the fixed point
+ * reached is the same one as the sequential Andersen.
+ */
+class AndersenParallel : public Andersen {
+
+public:
+    /// Deque of a worker thread. The owner works at the back, thieves steal from the front.
+    class WorkDeque {
+    public:
+        inline void push(NodeID id) {
+            std::lock_guard<std::mutex> guard(lock);
+            nodes.push_back(id);
+        }
+        inline bool pop(NodeID& id) {
+            std::lock_guard<std::mutex> guard(lock);
+            if (nodes.empty())
+                return false;
+            id = nodes.back();
+            nodes.pop_back();
+            return true;
+        }
+        inline bool steal(NodeID& id) {
+            std::lock_guard<std::mutex> guard(lock);
+            if (nodes.empty())
+                return false;
+            id = nodes.front();
+            nodes.pop_front();
+            return true;
+        }
+    private:
+        std::mutex lock;
+        NodeDeque nodes;
+    };
+
+private:
+    static AndersenParallel* parAndersen; // static instance
+
+    /// Number of striped locks guarding points-to sets (power of two)
+    static const u32_t NumOfPtsLocks = 1024;
+
+    u32_t numOfThreads;	///< number of worker threads
+    std::vector<std::unique_ptr<WorkDeque> > deques;	///< one deque per worker
+    std::unique_ptr<std::mutex[]> ptsLocks;	///< striped locks of points-to sets
+    std::unique_ptr<std::atomic<bool>[]> inDeque;	///< whether a node is already in some deque
+    u32_t inDequeSize;	///< size of inDeque
+    std::atomic<Size_t> pendingNodes;	///< nodes pushed but not processed yet
+    std::vector<NodeVector> processedNodes;	///< nodes processed by each worker in this round
+    std::vector<Size_t> processedCopys;	///< number of copy edges processed by each worker
+    bool sequential;	///< solve with Andersen::solve(), to verify the parallel solve
+
+public:
+    AndersenParallel(PTATY type = AndersenParallel_WPA);
+
+    /// Create an singleton instance directly instead of invoking llvm pass manager
+    static AndersenParallel* createAndersenParallel(llvm::Module& module) {
+        if(parAndersen==NULL) {
+            parAndersen = new AndersenParallel();
+            parAndersen->analyze(module);
+            return parAndersen;
+        }
+        return parAndersen;
+    }
+    static void releaseAndersenParallel() {
+        if (parAndersen)
+            delete parAndersen;
+        parAndersen = NULL;
+    }
+
+    /// Number of worker threads
+    inline u32_t getNumOfThreads() const {
+        return numOfThreads;
+    }
+
+    /// Solve constraints round by round
+    virtual void solve();
+
+    /// Finalize analysis, compare with a sequential solve first if -pander-verify is enabled
+    virtual void finalize();
+
+    /// Get PTA name
+    virtual const std::string PTAName() const {
+        return "AndersenParallelWPA";
+    }
+
+protected:
+    /// Propagate along copy edges from the frontier until no points-to set changes.
+    /// Nodes processed by the workers are returned in processed.
+    void parallelPropagate(const NodeVector& frontier, NodeBS& processed);
+
+    /// Main loop of a worker thread
+    void runWorker(u32_t tid);
+
+    /// Concurrent copy propagation of a node, run by worker tid
+    void processNodeCopys(u32_t tid, NodeID nodeId);
+
+    /// Handle constraints which modify the constraint graph, in sequential
+    void processNodeIndirect(NodeID nodeId);
+
+    /// Push a node into the deque of worker tid if it is not in any deque
+    inline void pushIntoDeque(u32_t tid, NodeID id) {
+        if (inDeque[id].exchange(true) == false) {
+            pendingNodes++;
+            deques[tid]->push(id);
+        }
+    }
+
+    /// Lock guarding the points-to set of a node
+    inline std::mutex& getPtsLock(NodeID id) {
+        return ptsLocks[id & (NumOfPtsLocks - 1)];
+    }
+
+    /// Make sure every node on the constraint graph has its points-to entry,
+    /// so that no points-to map insertion happens while workers are running
+    void preparePtsMap();
+
+    /// Only the sequential solve processes nodes through Andersen::processNode
+    virtual bool usesHCDCycles() const {
+        return sequential;
+    }
+};
+
 #endif /* ANDERSENPASS_H_ */
@@ -243,7 +243,7 @@ private:
 
     double solveTime;	///< time of solve.
     double sccTime;	///< time of SCC detection.
-    double processTime;	///< time of processNode.
+    double processTime;	///< time of processNode, this and the times below until storeTime are only sampled with -profile
     double propagationTime;	///< time of points-to propagation.
     double directPropaTime;	///< time of points-to propagation of address-taken objects
     double indirectPropaTime; ///< time of points-to propagation of top-level pointers
@@ -35,6 +35,8 @@
  */
 class WPAPass: public llvm::ModulePass, public llvm::AliasAnalysis {
     typedef std::vector<PointerAnalysis*> PTAVector;
+    typedef PointerAnalysis::AliasQueryList AliasQueryList;
+    typedef PointerAnalysis::AliasResultList AliasResultList;
 
 public:
     /// Pass ID
@@ -71,6 +73,10 @@ public:
     /// Interface expose to users of our pointer analysis, given Value infos
     virtual llvm::AliasResult alias(const llvm::Value* V1,	const llvm::Value* V2);
 
+    /// Interface expose to users of our pointer analysis, given a batch of Value pairs.
+    /// Each pointer analysis answers the whole batch before the results are combined.
+    void alias(const AliasQueryList& queries, AliasResultList& results);
+
     /// We start from here
     virtual bool runOnModule(llvm::Module& module);
 
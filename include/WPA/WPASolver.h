@@ -20,11 +20,15 @@
 
 #include "Util/WorkList.h"
 #include <llvm/ADT/GraphTraits.h>
+#include <llvm/Support/raw_ostream.h>
 
 /*
  * Generic graph solver for whole program pointer analysis
+ * The worklist type can be chosen by each solver. By default NodeWorkList is used,
+ * whose order (FIFO, LIFO, TOPO or LRF) can be changed via setWorklistOrder().
+ * A custom worklist type needs to provide the same interface as NodeWorkList.
  */
-template<class GraphType>
+template<class GraphType, class WorkListTy = NodeWorkList<NodeID> >
 class WPASolver {
 
 public:
@@ -36,12 +40,12 @@ public:
 
     typedef SCCDetection<GraphType> SCC;
 
-    typedef FIFOWorkList<NodeID> WorkList;
+    typedef WorkListTy WorkList;
 
 protected:
 
     /// Constructor
-    WPASolver(): _graph(NULL),scc(NULL)
+    WPASolver(): _graph(NULL),scc(NULL),traceOS(NULL)
     {
     }
     /// Destructor
@@ -61,8 +65,9 @@ protected:
     }
     inline void setGraph(GraphType g) {
         _graph = g;
-        if(!scc)
-            scc = new SCC(_graph);
+        /// the graph may be rebuilt, SCC detector of the old graph is dropped
+        delete scc;
+        scc = new SCC(_graph);
     }
     //@}
 
@@ -79,6 +84,7 @@ protected:
         /// Nodes in nodeStack are in topological order by default.
         /// This order can be changed by overwritten SCCDetect() in sub-classes
         NodeStack& nodeStack = SCCDetect();
+        rankWorklist(nodeStack);
 
         /// initial worklist
         /// process nodes in nodeStack.
@@ -129,10 +135,16 @@ protected:
     /// Worklist operations
     //@{
     inline NodeID popFromWorklist() {
-        return sccRepNode(worklist.pop());
+        NodeID id = worklist.pop();
+        if (traceOS)
+            *traceOS << "-\n";
+        return sccRepNode(id);
     }
     inline void pushIntoWorklist(NodeID id) {
-        worklist.push(sccRepNode(id));
+        NodeID rep = sccRepNode(id);
+        if (traceOS)
+            *traceOS << "+ " << rep << "\n";
+        worklist.push(rep);
     }
     inline bool isWorklistEmpty() {
         return worklist.empty();
@@ -142,6 +154,36 @@ protected:
     }
     //@}
 
+    /// Get/Set the order of the worklist, the worklist must be empty when the order is changed
+    //@{
+    inline WorkListOrder getWorklistOrder() const {
+        return worklist.getOrder();
+    }
+    inline void setWorklistOrder(WorkListOrder order) {
+        worklist.setOrder(order);
+    }
+    //@}
+
+    /// Rank nodes by their position in the topological order for the TOPO worklist,
+    /// nodes on the top of nodeStack are popped from the worklist first.
+    void rankWorklist(const NodeStack& nodeStack) {
+        if (worklist.getOrder() != WL_TOPO)
+            return;
+        worklist.clearPriorities();
+        NodeStack topoOrder(nodeStack);
+        unsigned rank = 0;
+        while (!topoOrder.empty()) {
+            worklist.setPriority(topoOrder.top(), rank++);
+            topoOrder.pop();
+        }
+    }
+
+    /// Record every worklist push ("+ id") and pop ("-") into os, NULL to stop recording.
+    /// The trace can be replayed by wlbench to compare worklist implementations.
+    inline void setWorklistTrace(llvm::raw_ostream* os) {
+        traceOS = os;
+    }
+
 protected:
     /// Get node on the graph
     inline GNODE* Node(NodeID id) {
@@ -162,6 +204,9 @@ private:
 
     /// Worklist for resolution
     WorkList worklist;
+
+    /// Output stream of worklist trace
+    llvm::raw_ostream* traceOS;
 };
 
 #endif /* GRAPHSOLVER_H_ */
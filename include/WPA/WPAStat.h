@@ -56,7 +56,7 @@ public:
 
     virtual void performStat();
 
-    virtual void printStat();
+    virtual void printStat(std::string statname = "Stat");
 
     void collectCycleInfo(ConstraintGraph* consCG);
 
@@ -83,7 +83,7 @@ public:
 
     virtual void performStat();
 
-    virtual void printStat();
+    virtual void printStat(std::string statname = "Stat");
 private:
     enum ENUM_INOUT {
         IN,
@@ -20,6 +20,9 @@
  */
 
 #include "MSSA/MemPartition.h"
+
+#include <algorithm>
+
 using namespace llvm;
 
 /**
@@ -111,12 +114,12 @@ void IntraDisjointMRG::partitionMRs()
                 cit!=ecit; ++cit) {
             const PointsTo& cpts = *cit;
 
-            PointsToList& inters = getIntersList(fun);
+            IntersectionSet& inters = getIntersList(fun);
             computeIntersections(cpts, inters);
         }
 
         /// Create memory regions.
-        const PointsToList& inters = getIntersList(fun);
+        const PointsToList& inters = getIntersList(fun).getInters();
         for (PointsToList::const_iterator interIt = inters.begin(), interEit = inters.end();
                 interIt != interEit; ++interIt) {
             const PointsTo& inter = *interIt;
@@ -128,16 +131,16 @@ void IntraDisjointMRG::partitionMRs()
 /**
  * Compute intersections between cpts and computed cpts intersections before.
  */
-void IntraDisjointMRG::computeIntersections(const PointsTo& cpts, PointsToList& inters)
+void IntraDisjointMRG::computeIntersections(const PointsTo& cpts, IntersectionSet& inters)
 {
-    if (inters.find(cpts) != inters.end()) {
+    if (inters.hasInter(cpts)) {
         // Skip this cpts if it is already in the map.
         return;
     }
     else if (cpts.count() == 1) {
         // If this cpts has only one element, it will not intersect with any cpts in inters,
         // just add it into intersection set.
-        inters.insert(cpts);
+        inters.addInter(cpts);
         return;
     }
     else {
@@ -146,10 +149,14 @@ void IntraDisjointMRG::computeIntersections(const PointsTo& cpts, PointsToList&
 
         PointsTo cpts_copy = cpts;	// make a copy since cpts may be changed.
 
+        // only the intersections sharing objects with cpts need to be checked
+        IntersectionSet::PtsPtrList candidates;
+        inters.getIntersectingInters(cpts, candidates);
+
         // check intersections with existing cpts in subSetMap
-        for (PointsToList::const_iterator interIt = inters.begin(), interEit = inters.end();
+        for (IntersectionSet::PtsPtrList::const_iterator interIt = candidates.begin(), interEit = candidates.end();
                 interIt != interEit; ++interIt) {
-            const PointsTo& inter = *interIt;
+            const PointsTo& inter = **interIt;
 
             if (cpts_copy.intersects(inter)) {
                 // compute intersection between cpts and inter
@@ -180,19 +187,19 @@ void IntraDisjointMRG::computeIntersections(const PointsTo& cpts, PointsToList&
         for (PointsToList::const_iterator it = toBeDeleted.begin(), eit = toBeDeleted.end();
                 it != eit; ++it) {
             const PointsTo& temp_cpts = *it;
-            inters.erase(temp_cpts);
+            inters.removeInter(temp_cpts);
         }
 
         // add new intersections
         for (PointsToList::const_iterator it = newInters.begin(), eit = newInters.end();
                 it != eit; ++it) {
             const PointsTo& temp_cpts = *it;
-            inters.insert(temp_cpts);
+            inters.addInter(temp_cpts);
         }
 
         // add remaining set into inters
         if (cpts_copy.empty() == false)
-            inters.insert(cpts_copy);
+            inters.addInter(cpts_copy);
     }
 }
 
@@ -208,18 +215,18 @@ void IntraDisjointMRG::createDisjointMR(const llvm::Function* func, const Points
     createMR(func, cpts);
 }
 
-void IntraDisjointMRG::getMRsForLoadFromInterList(MRSet& mrs, const PointsTo& cpts, const PointsToList& inters)
+void IntraDisjointMRG::getMRsForLoadFromInterList(MRSet& mrs, const PointsTo& cpts, const IntersectionSet& inters)
 {
-    PointsToList::const_iterator it = inters.begin();
-    PointsToList::const_iterator eit = inters.end();
+    IntersectionSet::PtsPtrList subInters;
+    inters.getSubInters(cpts, subInters);
+    IntersectionSet::PtsPtrList::const_iterator it = subInters.begin();
+    IntersectionSet::PtsPtrList::const_iterator eit = subInters.end();
     for (; it != eit; ++it) {
-        const PointsTo& inter = *it;
-        if (cpts.contains(inter)) {
-            MemRegion mr(inter);
-            MRSet::iterator mit = memRegSet.find(&mr);
-            assert(mit!=memRegSet.end() && "memory region not found!!");
-            mrs.insert(*mit);
-        }
+        const PointsTo& inter = **it;
+        MemRegion mr(inter);
+        MRSet::iterator mit = memRegSet.find(&mr);
+        assert(mit!=memRegSet.end() && "memory region not found!!");
+        mrs.insert(*mit);
     }
 }
 
@@ -256,12 +263,87 @@ void InterDisjointMRG::partitionMRs()
                 cit!=ecit; ++cit) {
             const PointsTo& cpts = *cit;
 
-            for (PointsToList::const_iterator interIt = inters.begin(), interEit = inters.end();
+            IntersectionSet::PtsPtrList subInters;
+            inters.getSubInters(cpts, subInters);
+            for (IntersectionSet::PtsPtrList::const_iterator interIt = subInters.begin(), interEit = subInters.end();
                     interIt != interEit; ++interIt) {
-                const PointsTo& inter = *interIt;
-                if (cpts.contains(inter))
-                    createDisjointMR(fun, inter);
+                const PointsTo& inter = **interIt;
+                createDisjointMR(fun, inter);
             }
         }
     }
 }
+
+/*-----------------------------------------------------*/
+
+/// Order intersections as PointsToList does
+struct InterPtrCmp {
+    bool operator()(const PointsTo* lhs, const PointsTo* rhs) const {
+        return analysisUtil::cmpPts(*lhs, *rhs);
+    }
+};
+
+/**
+ * Add an intersection and index it by its objects.
+ */
+void IntersectionSet::addInter(const PointsTo& cpts)
+{
+    std::pair<PointsToList::iterator, bool> res = inters.insert(cpts);
+    if (res.second == false)
+        return;
+    const PointsTo* inter = &(*res.first);
+    for (PointsTo::iterator it = cpts.begin(), eit = cpts.end(); it != eit; ++it)
+        objToInters[*it].push_back(inter);
+}
+
+/**
+ * Remove an intersection from the set and the index.
+ */
+void IntersectionSet::removeInter(const PointsTo& cpts)
+{
+    PointsToList::iterator pit = inters.find(cpts);
+    if (pit == inters.end())
+        return;
+    const PointsTo* inter = &(*pit);
+    for (PointsTo::iterator it = cpts.begin(), eit = cpts.end(); it != eit; ++it) {
+        PtsPtrList& objInters = objToInters[*it];
+        PtsPtrList::iterator iit = std::find(objInters.begin(), objInters.end(), inter);
+        assert(iit != objInters.end() && "intersection not indexed by its object");
+        *iit = objInters.back();
+        objInters.pop_back();
+    }
+    inters.erase(pit);
+}
+
+/**
+ * Collect the intersections indexed by objects of cpts.
+ */
+void IntersectionSet::getIntersectingInters(const PointsTo& cpts, PtsPtrList& res) const
+{
+    for (PointsTo::iterator it = cpts.begin(), eit = cpts.end(); it != eit; ++it) {
+        ObjToIntersMap::const_iterator iit = objToInters.find(*it);
+        if (iit != objToInters.end())
+            res.insert(res.end(), iit->second.begin(), iit->second.end());
+    }
+    std::sort(res.begin(), res.end(), InterPtrCmp());
+    res.erase(std::unique(res.begin(), res.end()), res.end());
+}
+
+/**
+ * Collect the intersections contained in cpts.
+ * An intersection is only checked at its first object, so that it is checked once.
+ */
+void IntersectionSet::getSubInters(const PointsTo& cpts, PtsPtrList& res) const
+{
+    for (PointsTo::iterator it = cpts.begin(), eit = cpts.end(); it != eit; ++it) {
+        ObjToIntersMap::const_iterator iit = objToInters.find(*it);
+        if (iit == objToInters.end())
+            continue;
+        for (PtsPtrList::const_iterator pit = iit->second.begin(), epit = iit->second.end(); pit != epit; ++pit) {
+            const PointsTo* inter = *pit;
+            if ((NodeID)inter->find_first() == *it && cpts.contains(*inter))
+                res.push_back(inter);
+        }
+    }
+    std::sort(res.begin(), res.end(), InterPtrCmp());
+}
@@ -25,7 +25,7 @@ using namespace llvm;
 using namespace analysisUtil;
 
 Size_t MemRegion::totalMRNum = 0;
-Size_t MRVer::totalVERNum = 0;
+std::atomic<Size_t> MRVer::totalVERNum(0);
 
 static cl::opt<bool> IgnoreDeadFun("mssa-ignoreDeadFun", cl::init(false),
                                    cl::desc("Don't construct memory SSA for deadfunction"));
@@ -131,7 +131,7 @@ void MRGenerator::collectModRefForLoadStore() {
                     const PAGEdge* inst = *bit;
                     pagEdgeToFunMap[inst] = &fun;
                     if (const StorePE *st = dyn_cast<StorePE>(inst)) {
-                        PointsTo cpts(pta->getPts(st->getDstID()));
+                        PointsTo cpts(pta->getConstPts(st->getDstID()));
                         // TODO: change this assertion check later when we have conditional points-to set
                         if (cpts.empty())
                             continue;
@@ -140,7 +140,7 @@ void MRGenerator::collectModRefForLoadStore() {
                     }
 
                     else if (const LoadPE *ld = dyn_cast<LoadPE>(inst)) {
-                        PointsTo cpts(pta->getPts(ld->getSrcID()));
+                        PointsTo cpts(pta->getConstPts(ld->getSrcID()));
                         // TODO: change this assertion check later when we have conditional points-to set
                         if (cpts.empty())
                             continue;
@@ -201,34 +201,13 @@ void MRGenerator::collectModRefForCall() {
 }
 
 /*!
- * Given a condition pts, insert into cptsToRepCPtsMap
+ * Given a condition pts, insert into repPtsIndex
  * Always map it to its superset(rep) cpts according to existing items
  * 1) map cpts to its superset(rep) which exists in the map, otherwise its superset is itself
  * 2) adjust existing items in the map if their supersets are cpts
  */
 void MRGenerator::sortPointsTo(const PointsTo& cpts) {
-
-    if(cptsToRepCPtsMap.find(cpts)!=cptsToRepCPtsMap.end())
-        return;
-
-    PointsToList subSetList;
-    PointsTo repCPts = cpts;
-    for(PtsToRepPtsSetMap::iterator it = cptsToRepCPtsMap.begin(),
-            eit = cptsToRepCPtsMap.end(); it!=eit; ++it) {
-        PointsTo& existCPts = it->second;
-        if(cpts.contains(existCPts)) {
-            subSetList.insert(it->first);
-        }
-        else if(existCPts.contains(cpts)) {
-            repCPts = existCPts;
-        }
-    }
-
-    for(PointsToList::iterator it = subSetList.begin(), eit = subSetList.end(); it!=eit; ++it) {
-        cptsToRepCPtsMap[*it] = cpts;
-    }
-
-    cptsToRepCPtsMap[cpts] = repCPts;
+    repPtsIndex.insert(cpts);
 }
 
 /*!
@@ -246,6 +225,9 @@ void MRGenerator::partitionMRs() {
             sortPointsTo(*cit);
         }
     }
+    repPtsIndex.getRepPointsTo(cptsToRepCPtsMap);
+    repPtsIndex.clear();
+
     /// Generate memory regions according to condition pts after computing superset
     for(FunToPointsToMap::iterator it = getFunToPointsToList().begin(), eit = getFunToPointsToList().end();
             it!=eit; ++it) {
@@ -386,7 +368,7 @@ void MRGenerator::collectCallSitePts(CallSite cs,NodeToPTSSMap& cachedPtsMap) {
 
     while(!worklist.empty()) {
         NodeID nodeId = worklist.pop();
-        PointsTo& tmp = pta->getPts(nodeId);
+        const PointsTo& tmp = pta->getConstPts(nodeId);
         for(PointsTo::iterator it = tmp.begin(), eit = tmp.end(); it!=eit; ++it) {
             pts |= CollectPtsChain(*it,cachedPtsMap);
         }
@@ -411,7 +393,7 @@ NodeBS& MRGenerator::CollectPtsChain(NodeID id, NodeToPTSSMap& cachedPtsMap) {
 
         while(!worklist.empty()) {
             NodeID nodeId = worklist.pop();
-            PointsTo& tmp = pta->getPts(nodeId);
+            const PointsTo& tmp = pta->getConstPts(nodeId);
             for(PointsTo::iterator it = tmp.begin(), eit = tmp.end(); it!=eit; ++it) {
                 pts |= CollectPtsChain(*it,cachedPtsMap);
             }
@@ -503,3 +485,115 @@ void MRGenerator::modRefAnalysis(PTACallGraphNode* callGraphNode, WorkList& work
         }
     }
 }
+
+/*!
+ * Insert a condition pts
+ * The representatives sharing objects with cpts are found from the object index,
+ * a representative containing all objects of cpts is its superset, and a representative
+ * whose objects are all in cpts is its subset. Representatives never contain each other,
+ * so cpts either has supersets or subsets, but not both.
+ * 1) if there are supersets, cpts is mapped to the one which the largest existing set is mapped to
+ * 2) otherwise cpts becomes a representative, and the representatives it contains are mapped to it
+ * An empty cpts is kept out of the index, it is mapped to the last set containing its current superset.
+ */
+void RepPointsToIndex::insert(const PointsTo& cpts) {
+
+    if(ptsToIdMap.find(cpts)!=ptsToIdMap.end())
+        return;
+
+    u32_t id = idToPts.size();
+    PtsToIdMap::iterator pit = ptsToIdMap.insert(std::make_pair(cpts, id)).first;
+    idToPts.push_back(&pit->first);
+    sizeOf.push_back(cpts.count());
+    repOf.push_back(id);
+    maxPtsOf.push_back(id);
+    hits.push_back(0);
+
+    if(cpts.empty()) {
+        emptyId = id;
+        emptyRep = findRep(ptsToIdMap.rbegin()->second);
+        return;
+    }
+
+    /// count the objects each representative shares with cpts
+    std::vector<u32_t> touched;
+    for(PointsTo::iterator it = cpts.begin(), eit = cpts.end(); it!=eit; ++it) {
+        ObjToRepsMap::iterator rit = objToReps.find(*it);
+        if(rit==objToReps.end())
+            continue;
+        std::vector<u32_t>& reps = rit->second;
+        for(u32_t i = 0; i < reps.size();) {
+            u32_t rep = reps[i];
+            /// drop the representatives which have been merged into another one
+            if(!isRep(rep)) {
+                reps[i] = reps.back();
+                reps.pop_back();
+                continue;
+            }
+            if(hits[rep]++ == 0)
+                touched.push_back(rep);
+            ++i;
+        }
+    }
+
+    u32_t superRep = id;
+    std::vector<u32_t> subReps;
+    for(std::vector<u32_t>::iterator it = touched.begin(), eit = touched.end(); it!=eit; ++it) {
+        u32_t rep = *it;
+        if(hits[rep] == sizeOf[id]) {
+            if(superRep == id || analysisUtil::cmpPts(getMaxPts(superRep), getMaxPts(rep)))
+                superRep = rep;
+        }
+        else if(hits[rep] == sizeOf[rep]) {
+            subReps.push_back(rep);
+        }
+        hits[rep] = 0;
+    }
+
+    /// the empty set is contained in any set
+    if(emptyId != ~0U && cpts.contains(*idToPts[emptyRep]))
+        emptyRep = id;
+
+    if(superRep != id) {
+        repOf[id] = superRep;
+        if(analysisUtil::cmpPts(getMaxPts(superRep), cpts))
+            maxPtsOf[superRep] = id;
+        return;
+    }
+
+    for(std::vector<u32_t>::iterator it = subReps.begin(), eit = subReps.end(); it!=eit; ++it) {
+        u32_t rep = *it;
+        repOf[rep] = id;
+        if(analysisUtil::cmpPts(getMaxPts(id), getMaxPts(rep)))
+            maxPtsOf[id] = maxPtsOf[rep];
+    }
+
+    for(PointsTo::iterator it = cpts.begin(), eit = cpts.end(); it!=eit; ++it)
+        objToReps[*it].push_back(id);
+}
+
+/*!
+ * Map every inserted set to its representative
+ */
+void RepPointsToIndex::getRepPointsTo(PtsToRepPtsSetMap& repMap) {
+    for(u32_t id = 0; id < idToPts.size(); id++) {
+        if(id == emptyId)
+            repMap[*idToPts[id]] = *idToPts[emptyRep];
+        else
+            repMap[*idToPts[id]] = *idToPts[findRep(id)];
+    }
+}
+
+/*!
+ * Release the index
+ */
+void RepPointsToIndex::clear() {
+    ptsToIdMap.clear();
+    idToPts.clear();
+    sizeOf.clear();
+    repOf.clear();
+    maxPtsOf.clear();
+    hits.clear();
+    objToReps.clear();
+    emptyId = emptyRep = ~0U;
+}
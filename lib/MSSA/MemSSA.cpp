@@ -18,6 +18,8 @@
 #include "MSSA/MemSSA.h"
 #include "Util/AnalysisUtil.h"
 #include "MSSA/SVFGStat.h"
+#include "MSSA/SVFGBuilder.h"
+#include "Util/Profiler.h"
 
 #include <llvm/Analysis/DominanceFrontier.h>
 #include <llvm/IR/InstIterator.h>	// for inst iteration
@@ -25,6 +27,7 @@
 #include <llvm/Analysis/CFG.h>	// for CFG
 #include <llvm/Support/raw_ostream.h>	// for output
 #include <llvm/Support/CommandLine.h>
+#include <thread>
 
 using namespace llvm;
 using namespace analysisUtil;
@@ -41,6 +44,9 @@ static std::string kDistinctMemPar = "distinct";
 static std::string kIntraDisjointMemPar = "intra-disjoint";
 static std::string kInterDisjointMemPar = "inter-disjoint";
 
+static cl::opt<bool> MSSAVerify("mssa-verify", cl::init(false),
+                                cl::desc("Compare the memory SSA built in parallel with a sequential build"));
+
 
 double MemSSA::timeOfGeneratingMemRegions = 0;	///< Time for allocating regions
 double MemSSA::timeOfCreateMUCHI  = 0;	///< Time for generating mu/chi for load/store/calls
@@ -50,7 +56,7 @@ double MemSSA::timeOfSSARenaming  = 0;	///< Time for SSA rename
 /*!
  * Constructor
  */
-MemSSA::MemSSA(BVDataPTAImpl* p) : df(NULL),dt(NULL) {
+MemSSA::MemSSA(BVDataPTAImpl* p) : df(NULL),dt(NULL),parent(NULL) {
     pta = p;
     assert((pta->getAnalysisTy()!=PointerAnalysis::Default_PTA)
            && "please specify a pointer analysis");
@@ -73,10 +79,14 @@ MemSSA::MemSSA(BVDataPTAImpl* p) : df(NULL),dt(NULL) {
     stat = new MemSSAStat(this);
 
     /// Generate whole program memory regions
-    double mrStart = stat->getClk();
+    ProfileScope prof("generateMRs", &timeOfGeneratingMemRegions, true);
     mrGen->generateMRs();
-    double mrEnd = stat->getClk();
-    timeOfGeneratingMemRegions += (mrEnd - mrStart)/TIMEINTERVAL;
+}
+
+/*!
+ * Constructor of a worker
+ */
+MemSSA::MemSSA(MemSSA* p) : pta(p->pta), mrGen(p->mrGen), df(NULL), dt(NULL), stat(p->stat), parent(p) {
 }
 
 /*!
@@ -105,19 +115,22 @@ void MemSSA::buildMemSSA(const Function& fun, DominanceFrontier* f, DominatorTre
     double muchiStart = stat->getClk();
     createMUCHI(fun);
     double muchiEnd = stat->getClk();
-    timeOfCreateMUCHI += (muchiEnd - muchiStart)/TIMEINTERVAL;
+    if (parent == NULL)
+        timeOfCreateMUCHI += (muchiEnd - muchiStart)/TIMEINTERVAL;
 
     /// Insert PHI for memory regions
     double phiStart = stat->getClk();
     insertPHI(fun);
     double phiEnd = stat->getClk();
-    timeOfInsertingPHI += (phiEnd - phiStart)/TIMEINTERVAL;
+    if (parent == NULL)
+        timeOfInsertingPHI += (phiEnd - phiStart)/TIMEINTERVAL;
 
     /// SSA rename for memory regions
     double renameStart = stat->getClk();
     SSARename(fun);
     double renameEnd = stat->getClk();
-    timeOfInsertingPHI += (renameEnd - renameStart)/TIMEINTERVAL;
+    if (parent == NULL)
+        timeOfInsertingPHI += (renameEnd - renameStart)/TIMEINTERVAL;
 
 }
 
@@ -178,6 +191,12 @@ void MemSSA::createMUCHI(const Function& fun) {
         }
     }
 
+    /// if the function does not have a reachable return instruction from function entry
+    /// then we won't create return mu for it
+    bool noRet = false;
+    if (!usedRegs.empty())
+        noRet = parent ? parent->noRetFuns.count(&fun) : functionDoesNotRet(&fun);
+
     // create entry chi for this function including all memory regions
     // initialize them with version 0 and 1 r_1 = chi (r_0)
     for (MRSet::iterator iter = usedRegs.begin(), eiter = usedRegs.end();
@@ -191,9 +210,7 @@ void MemSSA::createMUCHI(const Function& fun) {
         chi->setResVer(newSSAName(mr,chi));
         funToEntryChiSetMap[&fun].insert(chi);
 
-        /// if the function does not have a reachable return instruction from function entry
-        /// then we won't create return mu for it
-        if(functionDoesNotRet(&fun) == false) {
+        if(noRet == false) {
             RETMU* mu = new RETMU(&fun, mr);
             funToReturnMuSetMap[&fun].insert(mu);
         }
@@ -427,13 +444,206 @@ void MemSSA::destroy() {
         }
     }
 
-    delete mrGen;
+    /// a worker shares the regions and statistics of its parent
+    if (parent == NULL) {
+        delete mrGen;
+        delete stat;
+    }
     mrGen = NULL;
-    delete stat;
     stat = NULL;
     pta = NULL;
 }
 
+/*!
+ * Build memory SSA for functions in parallel.
+ * After memory regions are generated, the mus/chis/phis and SSA versions of a function
+ * only depend on the function itself. Each function is built by a worker with its own
+ * maps and version counters, the workers are merged in the order of functions.
+ */
+void MemSSA::buildMemSSAInParallel(const FunctionList& funs, u32_t numOfThreads) {
+
+    prepareParallelBuild(funs);
+
+    std::vector<MemSSA*> workers(funs.size(), NULL);
+    std::atomic<u32_t> next(0);
+
+    std::vector<std::thread> threads;
+    for (u32_t i = 1; i < numOfThreads; i++)
+        threads.push_back(std::thread(&MemSSA::runWorker, this, std::cref(funs), std::ref(workers), std::ref(next)));
+    runWorker(funs, workers, next);
+    for (std::vector<std::thread>::iterator it = threads.begin(), eit = threads.end(); it != eit; ++it)
+        it->join();
+
+    for (std::vector<MemSSA*>::iterator it = workers.begin(), eit = workers.end(); it != eit; ++it) {
+        mergeWorker(*it);
+        delete *it;
+    }
+
+    if (MSSAVerify)
+        verifyParallelBuild(funs);
+    noRetFuns.clear();
+}
+
+/*!
+ * Workers only read the shared maps, create the entries they look up without checking here
+ */
+void MemSSA::prepareParallelBuild(const FunctionList& funs) {
+    PAG* pag = getPAG();
+    PAGEdge::PAGEdgeSetTy& loads = pag->getEdgeSet(PAGEdge::Load);
+    for (PAGEdge::PAGEdgeSetTy::iterator it = loads.begin(), eit = loads.end(); it != eit; ++it)
+        mrGen->getLoadMRSet(cast<LoadPE>(*it));
+    PAGEdge::PAGEdgeSetTy& stores = pag->getEdgeSet(PAGEdge::Store);
+    for (PAGEdge::PAGEdgeSetTy::iterator it = stores.begin(), eit = stores.end(); it != eit; ++it)
+        mrGen->getStoreMRSet(cast<StorePE>(*it));
+
+    /// the BDD manager is created on first use
+    PathCondAllocator::trueCond();
+
+    /// functionDoesNotRet() warns about functions without return, do it before the workers start
+    for (FunctionList::const_iterator it = funs.begin(), eit = funs.end(); it != eit; ++it) {
+        if (functionDoesNotRet(*it))
+            noRetFuns.insert(*it);
+    }
+}
+
+/*!
+ * Take the next function and build it with a new worker, each thread has its own dominator tree and frontier
+ */
+void MemSSA::runWorker(const FunctionList& funs, std::vector<MemSSA*>& workers, std::atomic<u32_t>& next) {
+    ProfileScope prof("mssaWorker");
+    DominatorTree dt;
+    MemSSADF df;
+    for (u32_t i = next++; i < funs.size(); i = next++) {
+        Function& fun = const_cast<Function&>(*funs[i]);
+        dt.recalculate(fun);
+        df.runOnDT(dt);
+
+        MemSSA* worker = new MemSSA(this);
+        worker->buildMemSSA(fun, &df, &dt);
+        worker->df = NULL;
+        worker->dt = NULL;
+        workers[i] = worker;
+        Profiler::addCount("mssa.functions");
+    }
+}
+
+/*!
+ * Move the mus/chis/phis of a worker, the maps of different functions never share a key
+ */
+void MemSSA::mergeWorker(MemSSA* worker) {
+    for (LoadToMUSetMap::iterator it = worker->load2MuSetMap.begin(), eit = worker->load2MuSetMap.end(); it != eit; ++it)
+        load2MuSetMap[it->first].swap(it->second);
+    for (StoreToChiSetMap::iterator it = worker->store2ChiSetMap.begin(), eit = worker->store2ChiSetMap.end(); it != eit; ++it)
+        store2ChiSetMap[it->first].swap(it->second);
+    for (CallSiteToMUSetMap::iterator it = worker->callsiteToMuSetMap.begin(), eit = worker->callsiteToMuSetMap.end(); it != eit; ++it)
+        callsiteToMuSetMap[it->first].swap(it->second);
+    for (CallSiteToCHISetMap::iterator it = worker->callsiteToChiSetMap.begin(), eit = worker->callsiteToChiSetMap.end(); it != eit; ++it)
+        callsiteToChiSetMap[it->first].swap(it->second);
+    for (BBToPhiSetMap::iterator it = worker->bb2PhiSetMap.begin(), eit = worker->bb2PhiSetMap.end(); it != eit; ++it)
+        bb2PhiSetMap[it->first].swap(it->second);
+    for (FunToEntryChiSetMap::iterator it = worker->funToEntryChiSetMap.begin(), eit = worker->funToEntryChiSetMap.end(); it != eit; ++it)
+        funToEntryChiSetMap[it->first].swap(it->second);
+    for (FunToReturnMuSetMap::iterator it = worker->funToReturnMuSetMap.begin(), eit = worker->funToReturnMuSetMap.end(); it != eit; ++it)
+        funToReturnMuSetMap[it->first].swap(it->second);
+
+    worker->load2MuSetMap.clear();
+    worker->store2ChiSetMap.clear();
+    worker->callsiteToMuSetMap.clear();
+    worker->callsiteToChiSetMap.clear();
+    worker->bb2PhiSetMap.clear();
+    worker->funToEntryChiSetMap.clear();
+    worker->funToReturnMuSetMap.clear();
+}
+
+/// Versions of the mus/chis/phis in a set by their regions
+typedef std::map<const MemRegion*, std::vector<VERSION> > MRToVersionsMap;
+
+/// Collect the versions of each mu (its version), chi (operand and result) and phi (result and operands)
+//@{
+static void collectVersions(const MemSSA::MUSet& muSet, MRToVersionsMap& versions) {
+    for (MemSSA::MUSet::const_iterator it = muSet.begin(), eit = muSet.end(); it != eit; ++it)
+        versions[(*it)->getMR()].push_back((*it)->getVer()->getSSAVersion());
+}
+static void collectVersions(const MemSSA::CHISet& chiSet, MRToVersionsMap& versions) {
+    for (MemSSA::CHISet::const_iterator it = chiSet.begin(), eit = chiSet.end(); it != eit; ++it) {
+        std::vector<VERSION>& vers = versions[(*it)->getMR()];
+        vers.push_back((*it)->getOpVer()->getSSAVersion());
+        vers.push_back((*it)->getResVer()->getSSAVersion());
+    }
+}
+static void collectVersions(const MemSSA::PHISet& phiSet, MRToVersionsMap& versions) {
+    for (MemSSA::PHISet::const_iterator it = phiSet.begin(), eit = phiSet.end(); it != eit; ++it) {
+        std::vector<VERSION>& vers = versions[(*it)->getMR()];
+        vers.push_back((*it)->getResVer()->getSSAVersion());
+        /// operands of unreachable predecessors are not renamed, keep the positions of the others
+        std::map<u32_t, VERSION> opVers;
+        for (MemSSA::PHI::OPVers::const_iterator vit = (*it)->opVerBegin(), evit = (*it)->opVerEnd(); vit != evit; ++vit)
+            opVers[vit->first] = vit->second->getSSAVersion();
+        for (std::map<u32_t, VERSION>::const_iterator vit = opVers.begin(), evit = opVers.end(); vit != evit; ++vit) {
+            vers.push_back(vit->first);
+            vers.push_back(vit->second);
+        }
+    }
+}
+//@}
+
+/*!
+ * Number of keys (loads, stores, callsites, blocks or functions) whose mus/chis/phis differ,
+ * a missing key is the same as an empty set
+ */
+template<class SetMap>
+static u32_t getNumOfMismatches(const SetMap& lhs, const SetMap& rhs) {
+    u32_t num = 0;
+    for (typename SetMap::const_iterator it = lhs.begin(), eit = lhs.end(); it != eit; ++it) {
+        MRToVersionsMap lhsVersions, rhsVersions;
+        collectVersions(it->second, lhsVersions);
+        typename SetMap::const_iterator rit = rhs.find(it->first);
+        if (rit != rhs.end())
+            collectVersions(rit->second, rhsVersions);
+        if (lhsVersions != rhsVersions)
+            num++;
+    }
+    for (typename SetMap::const_iterator it = rhs.begin(), eit = rhs.end(); it != eit; ++it) {
+        if (lhs.find(it->first) == lhs.end() && !it->second.empty())
+            num++;
+    }
+    return num;
+}
+
+/*!
+ * The sequential build is a worker sharing the regions of this memory SSA, so that
+ * the mus/chis/phis of the two builds can be compared region by region
+ */
+bool MemSSA::verifyParallelBuild(const FunctionList& funs) {
+    MemSSA seq(this);
+    DominatorTree dt;
+    MemSSADF df;
+    for (FunctionList::const_iterator it = funs.begin(), eit = funs.end(); it != eit; ++it) {
+        Function& fun = const_cast<Function&>(**it);
+        dt.recalculate(fun);
+        df.runOnDT(dt);
+        seq.buildMemSSA(fun, &df, &dt);
+    }
+    seq.df = NULL;
+    seq.dt = NULL;
+
+    u32_t numOfMismatches = getNumOfMismatches(load2MuSetMap, seq.load2MuSetMap)
+                            + getNumOfMismatches(store2ChiSetMap, seq.store2ChiSetMap)
+                            + getNumOfMismatches(callsiteToMuSetMap, seq.callsiteToMuSetMap)
+                            + getNumOfMismatches(callsiteToChiSetMap, seq.callsiteToChiSetMap)
+                            + getNumOfMismatches(bb2PhiSetMap, seq.bb2PhiSetMap)
+                            + getNumOfMismatches(funToEntryChiSetMap, seq.funToEntryChiSetMap)
+                            + getNumOfMismatches(funToReturnMuSetMap, seq.funToReturnMuSetMap);
+
+    if (numOfMismatches) {
+        outs() << errMsg("parallel memory SSA differs from the sequential build on ") << numOfMismatches
+               << " loads, stores, callsites, blocks or functions\n";
+        return false;
+    }
+    outs() << sucMsg("parallel memory SSA is the same as the sequential build\n");
+    return true;
+}
+
 /*!
  * Perform statistics
  */
@@ -19,6 +19,9 @@
 #include "MSSA/SVFGStat.h"
 #include "Util/GraphUtil.h"
 #include "Util/AnalysisUtil.h"
+#include "Util/Profiler.h"
+
+#include <thread>
 
 using namespace llvm;
 using namespace analysisUtil;
@@ -27,6 +30,9 @@ using namespace analysisUtil;
 static cl::opt<bool> DumpVFG("dump-svfg", cl::init(false),
                              cl::desc("Dump dot graph of SVFG"));
 
+static cl::opt<unsigned> SVFGThreads("svfg-threads", cl::init(1),
+                                     cl::desc("Number of threads collecting SVFG edges of nodes (0: hardware concurrency)"));
+
 /*!
  * Constructor
  */
@@ -53,6 +59,7 @@ void SVFG::destroy() {
  *    b) between two memory SSA operators (MSSAPHI MSSAMU and MSSACHI)
  */
 void SVFG::buildSVFG(MemSSA* m) {
+    ProfileScope prof("buildSVFG");
     mssa = m;
 
     DBOUT(DGENERAL, outs() << pasMsg("\tCreate SVFG Top Level Node\n"));
@@ -263,55 +270,17 @@ void SVFG::addSVFGNodesForAddrTakenVars() {
  */
 void SVFG::connectDirectSVFGEdges() {
 
-    for(iterator it = begin(), eit = end(); it!=eit; ++it) {
-        NodeID nodeId = it->first;
-        const SVFGNode* node = it->second;
-
-        if(const StmtSVFGNode* stmtNode = dyn_cast<StmtSVFGNode>(node)) {
-            /// do not handle AddrSVFG node, as it is already the source of a definition
-            if(isa<AddrSVFGNode>(stmtNode))
-                continue;
-            /// for all other cases, like copy/gep/load/ret, connect the RHS pointer to its def
-            addIntraDirectVFEdge(getDef(stmtNode->getPAGSrcNode()),nodeId);
-
-            /// for store, connect the RHS/LHS pointer to its def
-            if(isa<StoreSVFGNode>(stmtNode)) {
-                addIntraDirectVFEdge(getDef(stmtNode->getPAGDstNode()),nodeId);
-            }
+    SVFGNodeList nodes;
+    for(iterator it = begin(), eit = end(); it!=eit; ++it)
+        nodes.push_back(it->second);
 
-        }
-        else if(const PHISVFGNode* phiNode = dyn_cast<PHISVFGNode>(node)) {
-            for (PHISVFGNode::OPVers::const_iterator it = phiNode->opVerBegin(), eit = phiNode->opVerEnd();
-                    it != eit; it++) {
-                addIntraDirectVFEdge(getDef(it->second),nodeId);
-            }
-        }
-        else if(const ActualParmSVFGNode* actualParm = dyn_cast<ActualParmSVFGNode>(node)) {
-            addIntraDirectVFEdge(getDef(actualParm->getParam()),nodeId);
-        }
-        else if(const FormalParmSVFGNode* formalParm = dyn_cast<FormalParmSVFGNode>(node)) {
-            for(CallPESet::const_iterator it = formalParm->callPEBegin(), eit = formalParm->callPEEnd();
-                    it!=eit; ++it) {
-                const Instruction* callInst = (*it)->getCallInst();
-                CallSite cs = analysisUtil::getLLVMCallSite(callInst);
-                const ActualParmSVFGNode* acutalParm = getActualParmSVFGNode((*it)->getSrcNode(),cs);
-                addInterVFEdgeFromAPToFP(acutalParm,formalParm,getCallSiteID((*it)->getCallSite(), formalParm->getFun()));
-            }
-        }
-        else if(const FormalRetSVFGNode* calleeRet = dyn_cast<FormalRetSVFGNode>(node)) {
-            /// connect formal ret to its definition node
-            addIntraDirectVFEdge(getDef(calleeRet->getRet()), nodeId);
+    std::vector<PendingVFEdgeList> edgeLists(nodes.size());
+    collectVFEdges(nodes, edgeLists, &SVFG::collectDirectVFEdges);
+    stat->dirVFEdgeCollected();
 
-            /// connect formal ret to actual ret
-            for(RetPESet::const_iterator it = calleeRet->retPEBegin(), eit = calleeRet->retPEEnd();
-                    it!=eit; ++it) {
-                const ActualRetSVFGNode* callsiteRev = getActualRetSVFGNode((*it)->getDstNode());
-                addInterVFEdgeFromFRToAR(calleeRet,callsiteRev, getCallSiteID((*it)->getCallSite(), calleeRet->getFun()));
-            }
-        }
-        /// Do not process FormalRetSVFGNode, as they are connected by copy within callee
-        /// We assume one procedure only has unique return
-    }
+    /// add the edges in node order so that the graph does not depend on the number of threads
+    for(std::vector<PendingVFEdgeList>::const_iterator it = edgeLists.begin(), eit = edgeLists.end(); it!=eit; ++it)
+        addPendingVFEdges(*it);
 
     /// connect direct value-flow edges (parameter passing) for thread fork/join
     /// add fork edge
@@ -335,83 +304,231 @@ void SVFG::connectDirectSVFGEdges() {
     }
 }
 
+/*!
+ * Collect the direct value-flow edges into a node
+ */
+void SVFG::collectDirectVFEdges(const SVFGNode* node, PendingVFEdgeList& edges) const {
+
+    NodeID nodeId = node->getId();
+
+    if(const StmtSVFGNode* stmtNode = dyn_cast<StmtSVFGNode>(node)) {
+        /// do not handle AddrSVFG node, as it is already the source of a definition
+        if(isa<AddrSVFGNode>(stmtNode))
+            return;
+        /// for all other cases, like copy/gep/load/ret, connect the RHS pointer to its def
+        edges.push_back(PendingVFEdge(SVFGEdge::IntraDirect, getDef(stmtNode->getPAGSrcNode()), nodeId));
+
+        /// for store, connect the RHS/LHS pointer to its def
+        if(isa<StoreSVFGNode>(stmtNode)) {
+            edges.push_back(PendingVFEdge(SVFGEdge::IntraDirect, getDef(stmtNode->getPAGDstNode()), nodeId));
+        }
+
+    }
+    else if(const PHISVFGNode* phiNode = dyn_cast<PHISVFGNode>(node)) {
+        for (PHISVFGNode::OPVers::const_iterator it = phiNode->opVerBegin(), eit = phiNode->opVerEnd();
+                it != eit; it++) {
+            edges.push_back(PendingVFEdge(SVFGEdge::IntraDirect, getDef(it->second), nodeId));
+        }
+    }
+    else if(const ActualParmSVFGNode* actualParm = dyn_cast<ActualParmSVFGNode>(node)) {
+        edges.push_back(PendingVFEdge(SVFGEdge::IntraDirect, getDef(actualParm->getParam()), nodeId));
+    }
+    else if(const FormalParmSVFGNode* formalParm = dyn_cast<FormalParmSVFGNode>(node)) {
+        for(CallPESet::const_iterator it = formalParm->callPEBegin(), eit = formalParm->callPEEnd();
+                it!=eit; ++it) {
+            const Instruction* callInst = (*it)->getCallInst();
+            CallSite cs = analysisUtil::getLLVMCallSite(callInst);
+            const ActualParmSVFGNode* acutalParm = getActualParmSVFGNode((*it)->getSrcNode(),cs);
+            edges.push_back(PendingVFEdge(SVFGEdge::DirCall, acutalParm->getId(), nodeId,
+                                          getCallSiteID((*it)->getCallSite(), formalParm->getFun())));
+        }
+    }
+    else if(const FormalRetSVFGNode* calleeRet = dyn_cast<FormalRetSVFGNode>(node)) {
+        /// connect formal ret to its definition node
+        edges.push_back(PendingVFEdge(SVFGEdge::IntraDirect, getDef(calleeRet->getRet()), nodeId));
+
+        /// connect formal ret to actual ret
+        for(RetPESet::const_iterator it = calleeRet->retPEBegin(), eit = calleeRet->retPEEnd();
+                it!=eit; ++it) {
+            const ActualRetSVFGNode* callsiteRev = getActualRetSVFGNode((*it)->getDstNode());
+            edges.push_back(PendingVFEdge(SVFGEdge::DirRet, nodeId, callsiteRev->getId(),
+                                          getCallSiteID((*it)->getCallSite(), calleeRet->getFun())));
+        }
+    }
+    /// Do not process FormalRetSVFGNode, as they are connected by copy within callee
+    /// We assume one procedure only has unique return
+}
+
 /*
  * Connect def-use chains for indirect value-flow, (value-flow of address-taken variables)
  */
 void SVFG::connectIndirectSVFGEdges() {
 
-    for(iterator it = begin(), eit = end(); it!=eit; ++it) {
-        NodeID nodeId = it->first;
-        const SVFGNode* node = it->second;
-        if(const LoadSVFGNode* loadNode = dyn_cast<LoadSVFGNode>(node)) {
-            MUSet& muSet = mssa->getMUSet(cast<LoadPE>(loadNode->getPAGEdge()));
-            for(MUSet::iterator it = muSet.begin(), eit = muSet.end(); it!=eit; ++it) {
-                if(LOADMU* mu = dyn_cast<LOADMU>(*it)) {
-                    NodeID def = getDef(mu->getVer());
-                    addIntraIndirectVFEdge(def,nodeId, mu->getVer()->getMR()->getPointsTo());
-                }
+    SVFGNodeList nodes;
+    for(iterator it = begin(), eit = end(); it!=eit; ++it)
+        nodes.push_back(it->second);
+
+    std::vector<PendingVFEdgeList> edgeLists(nodes.size());
+    collectVFEdges(nodes, edgeLists, &SVFG::collectIndirectVFEdges);
+    stat->indVFEdgeCollected();
+
+    for(std::vector<PendingVFEdgeList>::const_iterator it = edgeLists.begin(), eit = edgeLists.end(); it!=eit; ++it)
+        addPendingVFEdges(*it);
+
+    connectFromGlobalToProgEntry();
+}
+
+/*!
+ * Collect the indirect value-flow edges into a node, and the return edges out of a formal-out node.
+ * Memory SSA and call site maps are only looked up, missing entries are not created here.
+ */
+void SVFG::collectIndirectVFEdges(const SVFGNode* node, PendingVFEdgeList& edges) const {
+
+    NodeID nodeId = node->getId();
+
+    if(const LoadSVFGNode* loadNode = dyn_cast<LoadSVFGNode>(node)) {
+        MemSSA::LoadToMUSetMap::const_iterator mit = mssa->getLoadToMUSetMap().find(cast<LoadPE>(loadNode->getPAGEdge()));
+        if(mit == mssa->getLoadToMUSetMap().end())
+            return;
+        for(MUSet::const_iterator it = mit->second.begin(), eit = mit->second.end(); it!=eit; ++it) {
+            if(LOADMU* mu = dyn_cast<LOADMU>(*it)) {
+                NodeID def = getDef(mu->getVer());
+                edges.push_back(PendingVFEdge(SVFGEdge::IntraIndirect, def, nodeId, 0, &mu->getVer()->getMR()->getPointsTo()));
             }
         }
-        else if(const StoreSVFGNode* storeNode = dyn_cast<StoreSVFGNode>(node)) {
-            CHISet& chiSet = mssa->getCHISet(cast<StorePE>(storeNode->getPAGEdge()));
-            for(CHISet::iterator it = chiSet.begin(), eit = chiSet.end(); it!=eit; ++it) {
-                if(STORECHI* chi = dyn_cast<STORECHI>(*it)) {
-                    NodeID def = getDef(chi->getOpVer());
-                    addIntraIndirectVFEdge(def,nodeId, chi->getOpVer()->getMR()->getPointsTo());
-                }
+    }
+    else if(const StoreSVFGNode* storeNode = dyn_cast<StoreSVFGNode>(node)) {
+        MemSSA::StoreToChiSetMap::const_iterator mit = mssa->getStoreToChiSetMap().find(cast<StorePE>(storeNode->getPAGEdge()));
+        if(mit == mssa->getStoreToChiSetMap().end())
+            return;
+        for(CHISet::const_iterator it = mit->second.begin(), eit = mit->second.end(); it!=eit; ++it) {
+            if(STORECHI* chi = dyn_cast<STORECHI>(*it)) {
+                NodeID def = getDef(chi->getOpVer());
+                edges.push_back(PendingVFEdge(SVFGEdge::IntraIndirect, def, nodeId, 0, &chi->getOpVer()->getMR()->getPointsTo()));
             }
         }
-        else if(const FormalINSVFGNode* formalIn = dyn_cast<FormalINSVFGNode>(node)) {
-            PTACallGraphEdge::CallInstSet callInstSet;
-            getPTACallGraph()->getDirCallSitesInvokingCallee(formalIn->getEntryChi()->getFunction(),callInstSet);
-            for(PTACallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it) {
-                CallSite cs = analysisUtil::getLLVMCallSite(*it);
-                if(!mssa->hasMU(cs))
-                    continue;
-                ActualINSVFGNodeSet& actualIns = getActualINSVFGNodes(cs);
-                for(ActualINSVFGNodeSet::iterator ait = actualIns.begin(), aeit = actualIns.end(); ait!=aeit; ++ait) {
-                    const ActualINSVFGNode* actualIn = llvm::cast<ActualINSVFGNode>(getSVFGNode(*ait));
-                    addInterIndirectVFCallEdge(actualIn,formalIn,getCallSiteID(cs, formalIn->getFun()));
-                }
+    }
+    else if(const FormalINSVFGNode* formalIn = dyn_cast<FormalINSVFGNode>(node)) {
+        PTACallGraphEdge::CallInstSet callInstSet;
+        getPTACallGraph()->getDirCallSitesInvokingCallee(formalIn->getEntryChi()->getFunction(),callInstSet);
+        for(PTACallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it) {
+            CallSite cs = analysisUtil::getLLVMCallSite(*it);
+            if(!mssa->hasMU(cs))
+                continue;
+            CallSiteToActualINsMapTy::const_iterator ait = callSiteToActualINMap.find(cs);
+            if(ait == callSiteToActualINMap.end())
+                continue;
+            for(ActualINSVFGNodeSet::iterator nit = ait->second.begin(), neit = ait->second.end(); nit!=neit; ++nit) {
+                const ActualINSVFGNode* actualIn = llvm::cast<ActualINSVFGNode>(getSVFGNode(*nit));
+                PendingVFEdge edge(SVFGEdge::IndCall, actualIn->getId(), nodeId, getCallSiteID(cs, formalIn->getFun()));
+                if(getInterIndirectVFPts(actualIn, formalIn, edge.cpts))
+                    edges.push_back(edge);
             }
         }
-        else if(const FormalOUTSVFGNode* formalOut = dyn_cast<FormalOUTSVFGNode>(node)) {
-            PTACallGraphEdge::CallInstSet callInstSet;
-            const MemSSA::RETMU* retMu = formalOut->getRetMU();
-            getPTACallGraph()->getDirCallSitesInvokingCallee(retMu->getFunction(),callInstSet);
-            for(PTACallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it) {
-                CallSite cs = analysisUtil::getLLVMCallSite(*it);
-                if(!mssa->hasCHI(cs))
-                    continue;
-                ActualOUTSVFGNodeSet& actualOuts = getActualOUTSVFGNodes(cs);
-                for(ActualOUTSVFGNodeSet::iterator ait = actualOuts.begin(), aeit = actualOuts.end(); ait!=aeit; ++ait) {
-                    const ActualOUTSVFGNode* actualOut = llvm::cast<ActualOUTSVFGNode>(getSVFGNode(*ait));
-                    addInterIndirectVFRetEdge(formalOut,actualOut,getCallSiteID(cs, formalOut->getFun()));
-                }
+    }
+    else if(const FormalOUTSVFGNode* formalOut = dyn_cast<FormalOUTSVFGNode>(node)) {
+        PTACallGraphEdge::CallInstSet callInstSet;
+        const MemSSA::RETMU* retMu = formalOut->getRetMU();
+        getPTACallGraph()->getDirCallSitesInvokingCallee(retMu->getFunction(),callInstSet);
+        for(PTACallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it) {
+            CallSite cs = analysisUtil::getLLVMCallSite(*it);
+            if(!mssa->hasCHI(cs))
+                continue;
+            CallSiteToActualOUTsMapTy::const_iterator ait = callSiteToActualOUTMap.find(cs);
+            if(ait == callSiteToActualOUTMap.end())
+                continue;
+            for(ActualOUTSVFGNodeSet::iterator nit = ait->second.begin(), neit = ait->second.end(); nit!=neit; ++nit) {
+                const ActualOUTSVFGNode* actualOut = llvm::cast<ActualOUTSVFGNode>(getSVFGNode(*nit));
+                PendingVFEdge edge(SVFGEdge::IndRet, nodeId, actualOut->getId(), getCallSiteID(cs, formalOut->getFun()));
+                if(getInterIndirectVFPts(formalOut, actualOut, edge.cpts))
+                    edges.push_back(edge);
             }
-            NodeID def = getDef(retMu->getVer());
-            addIntraIndirectVFEdge(def,nodeId, retMu->getVer()->getMR()->getPointsTo());
         }
-        else if(const ActualINSVFGNode* actualIn = dyn_cast<ActualINSVFGNode>(node)) {
-            const MRVer* ver = actualIn->getCallMU()->getVer();
-            NodeID def = getDef(ver);
-            addIntraIndirectVFEdge(def,nodeId, ver->getMR()->getPointsTo());
-        }
-        else if(isa<ActualOUTSVFGNode>(node)) {
-            /// There's no need to connect actual out node to its definition site in the same function.
-        }
-        else if(const MSSAPHISVFGNode* phiNode = dyn_cast<MSSAPHISVFGNode>(node)) {
-            for (MemSSA::PHI::OPVers::const_iterator it = phiNode->opVerBegin(), eit = phiNode->opVerEnd();
-                    it != eit; it++) {
-                const MRVer* op = it->second;
-                NodeID def = getDef(op);
-                addIntraIndirectVFEdge(def,nodeId, op->getMR()->getPointsTo());
-            }
+        NodeID def = getDef(retMu->getVer());
+        edges.push_back(PendingVFEdge(SVFGEdge::IntraIndirect, def, nodeId, 0, &retMu->getVer()->getMR()->getPointsTo()));
+    }
+    else if(const ActualINSVFGNode* actualIn = dyn_cast<ActualINSVFGNode>(node)) {
+        const MRVer* ver = actualIn->getCallMU()->getVer();
+        NodeID def = getDef(ver);
+        edges.push_back(PendingVFEdge(SVFGEdge::IntraIndirect, def, nodeId, 0, &ver->getMR()->getPointsTo()));
+    }
+    else if(isa<ActualOUTSVFGNode>(node)) {
+        /// There's no need to connect actual out node to its definition site in the same function.
+    }
+    else if(const MSSAPHISVFGNode* phiNode = dyn_cast<MSSAPHISVFGNode>(node)) {
+        for (MemSSA::PHI::OPVers::const_iterator it = phiNode->opVerBegin(), eit = phiNode->opVerEnd();
+                it != eit; it++) {
+            const MRVer* op = it->second;
+            NodeID def = getDef(op);
+            edges.push_back(PendingVFEdge(SVFGEdge::IntraIndirect, def, nodeId, 0, &op->getMR()->getPointsTo()));
         }
     }
+}
 
+/*!
+ * Collect the edges of every node, nodes are taken in chunks by the threads
+ */
+void SVFG::collectVFEdges(const SVFGNodeList& nodes, std::vector<PendingVFEdgeList>& edgeLists, VFEdgeCollector collector) const {
 
-    connectFromGlobalToProgEntry();
+    u32_t numOfThreads = SVFGThreads;
+    if (numOfThreads == 0)
+        numOfThreads = std::thread::hardware_concurrency();
+
+    std::atomic<u32_t> next(0);
+    if (numOfThreads <= 1) {
+        collectVFEdgesWorker(nodes, edgeLists, collector, next);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    for (u32_t i = 0; i < numOfThreads; i++)
+        threads.push_back(std::thread(&SVFG::collectVFEdgesWorker, this, std::cref(nodes), std::ref(edgeLists), collector, std::ref(next)));
+    for (u32_t i = 0; i < numOfThreads; i++)
+        threads[i].join();
+}
+
+void SVFG::collectVFEdgesWorker(const SVFGNodeList& nodes, std::vector<PendingVFEdgeList>& edgeLists,
+                                VFEdgeCollector collector, std::atomic<u32_t>& next) const {
+    ProfileScope prof("collectVFEdges");
+    const u32_t chunkSize = 64;
+    u32_t numOfNodes = nodes.size();
+    for (u32_t start = next.fetch_add(chunkSize); start < numOfNodes; start = next.fetch_add(chunkSize)) {
+        u32_t end = std::min(start + chunkSize, numOfNodes);
+        for (u32_t i = start; i < end; i++)
+            (this->*collector)(nodes[i], edgeLists[i]);
+        Profiler::addCount("svfg.collectedNodes", end - start);
+    }
+}
+
+/*!
+ * Add the collected edges, an edge already in the graph gets the points-to of the new one
+ */
+void SVFG::addPendingVFEdges(const PendingVFEdgeList& edges) {
+    for(PendingVFEdgeList::const_iterator it = edges.begin(), eit = edges.end(); it!=eit; ++it) {
+        const PendingVFEdge& edge = *it;
+        switch(edge.kind) {
+        case SVFGEdge::IntraDirect:
+            addIntraDirectVFEdge(edge.src, edge.dst);
+            break;
+        case SVFGEdge::DirCall:
+            addCallDirectVFEdge(edge.src, edge.dst, edge.csId);
+            break;
+        case SVFGEdge::DirRet:
+            addRetDirectVFEdge(edge.src, edge.dst, edge.csId);
+            break;
+        case SVFGEdge::IntraIndirect:
+            addIntraIndirectVFEdge(edge.src, edge.dst, *edge.mrPts);
+            break;
+        case SVFGEdge::IndCall:
+            addCallIndirectVFEdge(edge.src, edge.dst, edge.cpts, edge.csId);
+            break;
+        case SVFGEdge::IndRet:
+            addRetIndirectVFEdge(edge.src, edge.dst, edge.cpts, edge.csId);
+            break;
+        default:
+            assert(false && "unexpected value-flow edge kind");
+        }
+    }
 }
 
 
@@ -431,7 +548,7 @@ void SVFG::connectFromGlobalToProgEntry()
         const StoreSVFGNode* store = *storeIt;
 
         /// connect this store to main function entry
-        const PointsTo& storePts = mssa->getPTA()->getPts(store->getPAGDstNodeID());
+        const PointsTo& storePts = mssa->getPTA()->getConstPts(store->getPAGDstNodeID());
 
         for (NodeBS::iterator fiIt = formalIns.begin(), fiEit = formalIns.end();
                 fiIt != fiEit; ++fiIt) {
@@ -502,7 +619,7 @@ SVFGEdge* SVFG::getSVFGEdge(const SVFGNode* src, const SVFGNode* dst, SVFGEdge::
 
     SVFGEdge * edge = NULL;
     Size_t counter = 0;
-    for (SVFGEdge::SVFGEdgeSetTy::iterator iter = src->OutEdgeBegin();
+    for (SVFGNode::const_iterator iter = src->OutEdgeBegin();
             iter != src->OutEdgeEnd(); ++iter) {
         if ((*iter)->getDstID() == dst->getId() && (*iter)->getEdgeKind() == kind) {
             counter++;
@@ -525,7 +642,7 @@ SVFGEdge* SVFG::addIntraDirectVFEdge(NodeID srcId, NodeID dstId) {
         return NULL;
     }
     else {
-        IntraDirSVFGEdge* directEdge = new IntraDirSVFGEdge(srcNode,dstNode);
+        IntraDirSVFGEdge* directEdge = new (arena) IntraDirSVFGEdge(srcNode,dstNode);
         return (addSVFGEdge(directEdge) ? directEdge : NULL);
     }
 }
@@ -541,7 +658,7 @@ SVFGEdge* SVFG::addCallDirectVFEdge(NodeID srcId, NodeID dstId, CallSiteID csId)
         return NULL;
     }
     else {
-        CallDirSVFGEdge* callEdge = new CallDirSVFGEdge(srcNode,dstNode,csId);
+        CallDirSVFGEdge* callEdge = new (arena) CallDirSVFGEdge(srcNode,dstNode,csId);
         return (addSVFGEdge(callEdge) ? callEdge : NULL);
     }
 }
@@ -557,7 +674,7 @@ SVFGEdge* SVFG::addRetDirectVFEdge(NodeID srcId, NodeID dstId, CallSiteID csId)
         return NULL;
     }
     else {
-        RetDirSVFGEdge* retEdge = new RetDirSVFGEdge(srcNode,dstNode,csId);
+        RetDirSVFGEdge* retEdge = new (arena) RetDirSVFGEdge(srcNode,dstNode,csId);
         return (addSVFGEdge(retEdge) ? retEdge : NULL);
     }
 }
@@ -571,11 +688,11 @@ SVFGEdge* SVFG::addIntraIndirectVFEdge(NodeID srcId, NodeID dstId, const PointsT
     SVFGNode* dstNode = getSVFGNode(dstId);
     if(SVFGEdge* edge = hasIntraSVFGEdge(srcNode,dstNode,SVFGEdge::IntraIndirect)) {
         assert(isa<IndirectSVFGEdge>(edge) && "this should be a indirect value flow edge!");
-        return (cast<IndirectSVFGEdge>(edge)->addPointsTo(cpts) ? edge : NULL);
+        return (cast<IndirectSVFGEdge>(edge)->addPointsTo(cpts, ptsPool) ? edge : NULL);
     }
     else {
-        IntraIndSVFGEdge* indirectEdge = new IntraIndSVFGEdge(srcNode,dstNode);
-        indirectEdge->addPointsTo(cpts);
+        IntraIndSVFGEdge* indirectEdge = new (arena) IntraIndSVFGEdge(srcNode,dstNode);
+        indirectEdge->addPointsTo(cpts, ptsPool);
         return (addSVFGEdge(indirectEdge) ? indirectEdge : NULL);
     }
 }
@@ -588,11 +705,11 @@ SVFGEdge* SVFG::addThreadMHPIndirectVFEdge(NodeID srcId, NodeID dstId, const Poi
     SVFGNode* dstNode = getSVFGNode(dstId);
     if(SVFGEdge* edge = hasThreadSVFGEdge(srcNode,dstNode,SVFGEdge::TheadMHPIndirect)) {
         assert(isa<IndirectSVFGEdge>(edge) && "this should be a indirect value flow edge!");
-        return (cast<IndirectSVFGEdge>(edge)->addPointsTo(cpts) ? edge : NULL);
+        return (cast<IndirectSVFGEdge>(edge)->addPointsTo(cpts, ptsPool) ? edge : NULL);
     }
     else {
-        ThreadMHPIndSVFGEdge* indirectEdge = new ThreadMHPIndSVFGEdge(srcNode,dstNode);
-        indirectEdge->addPointsTo(cpts);
+        ThreadMHPIndSVFGEdge* indirectEdge = new (arena) ThreadMHPIndSVFGEdge(srcNode,dstNode);
+        indirectEdge->addPointsTo(cpts, ptsPool);
         return (addSVFGEdge(indirectEdge) ? indirectEdge : NULL);
     }
 }
@@ -606,11 +723,11 @@ SVFGEdge* SVFG::addCallIndirectVFEdge(NodeID srcId, NodeID dstId, const PointsTo
     SVFGNode* dstNode = getSVFGNode(dstId);
     if(SVFGEdge* edge = hasInterSVFGEdge(srcNode,dstNode,SVFGEdge::IndCall,csId)) {
         assert(isa<CallIndSVFGEdge>(edge) && "this should be a indirect value flow edge!");
-        return (cast<CallIndSVFGEdge>(edge)->addPointsTo(cpts) ? edge : NULL);
+        return (cast<CallIndSVFGEdge>(edge)->addPointsTo(cpts, ptsPool) ? edge : NULL);
     }
     else {
-        CallIndSVFGEdge* callEdge = new CallIndSVFGEdge(srcNode,dstNode,csId);
-        callEdge->addPointsTo(cpts);
+        CallIndSVFGEdge* callEdge = new (arena) CallIndSVFGEdge(srcNode,dstNode,csId);
+        callEdge->addPointsTo(cpts, ptsPool);
         return (addSVFGEdge(callEdge) ? callEdge : NULL);
     }
 }
@@ -624,11 +741,11 @@ SVFGEdge* SVFG::addRetIndirectVFEdge(NodeID srcId, NodeID dstId, const PointsTo&
     SVFGNode* dstNode = getSVFGNode(dstId);
     if(SVFGEdge* edge = hasInterSVFGEdge(srcNode,dstNode,SVFGEdge::IndRet,csId)) {
         assert(isa<RetIndSVFGEdge>(edge) && "this should be a indirect value flow edge!");
-        return (cast<RetIndSVFGEdge>(edge)->addPointsTo(cpts) ? edge : NULL);
+        return (cast<RetIndSVFGEdge>(edge)->addPointsTo(cpts, ptsPool) ? edge : NULL);
     }
     else {
-        RetIndSVFGEdge* retEdge = new RetIndSVFGEdge(srcNode,dstNode,csId);
-        retEdge->addPointsTo(cpts);
+        RetIndSVFGEdge* retEdge = new (arena) RetIndSVFGEdge(srcNode,dstNode,csId);
+        retEdge->addPointsTo(cpts, ptsPool);
         return (addSVFGEdge(retEdge) ? retEdge : NULL);
     }
 }
@@ -637,12 +754,9 @@ SVFGEdge* SVFG::addRetIndirectVFEdge(NodeID srcId, NodeID dstId, const PointsTo&
  *
  */
 SVFGEdge* SVFG::addInterIndirectVFCallEdge(const ActualINSVFGNode* src, const FormalINSVFGNode* dst,CallSiteID csId) {
-    PointsTo cpts1 = src->getPointsTo();
-    PointsTo cpts2 = dst->getPointsTo();
-    if(cpts1.intersects(cpts2)) {
-        cpts1 &= cpts2;
-        return addCallIndirectVFEdge(src->getId(),dst->getId(),cpts1,csId);
-    }
+    PointsTo cpts;
+    if(getInterIndirectVFPts(src, dst, cpts))
+        return addCallIndirectVFEdge(src->getId(),dst->getId(),cpts,csId);
     return NULL;
 }
 
@@ -650,13 +764,9 @@ SVFGEdge* SVFG::addInterIndirectVFCallEdge(const ActualINSVFGNode* src, const Fo
  * Add inter VF edge from function exit mu to callsite chi
  */
 SVFGEdge* SVFG::addInterIndirectVFRetEdge(const FormalOUTSVFGNode* src, const ActualOUTSVFGNode* dst,CallSiteID csId) {
-
-    PointsTo cpts1 = src->getPointsTo();
-    PointsTo cpts2 = dst->getPointsTo();
-    if(cpts1.intersects(cpts2)) {
-        cpts1 &= cpts2;
-        return addRetIndirectVFEdge(src->getId(),dst->getId(),cpts1,csId);
-    }
+    PointsTo cpts;
+    if(getInterIndirectVFPts(src, dst, cpts))
+        return addRetIndirectVFEdge(src->getId(),dst->getId(),cpts,csId);
     return NULL;
 }
 
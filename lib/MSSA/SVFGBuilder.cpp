@@ -18,9 +18,15 @@
 #include "MSSA/SVFGBuilder.h"
 #include "WPA/Andersen.h"
 
+#include <llvm/Support/CommandLine.h>
+#include <thread>
+
 using namespace llvm;
 using namespace analysisUtil;
 
+static cl::opt<unsigned> MSSAThreads("mssa-threads", cl::init(1),
+                                     cl::desc("Number of threads building memory SSA of functions (0: hardware concurrency)"));
+
 /*!
  * Create SVFG
  */
@@ -44,24 +50,41 @@ void SVFGBuilder::releaseMemory(SVFG* vfg) {
  */
 bool SVFGBuilder::build(SVFG* graph,BVDataPTAImpl* pta) {
 
+    ProfileScope prof("SVFGBuilder");
+
     MemSSA mssa(pta);
 
     DBOUT(DGENERAL, outs() << pasMsg("Build Memory SSA \n"));
 
-    DominatorTree dt;
-    MemSSADF df;
+    u32_t numOfThreads = MSSAThreads;
+    if (numOfThreads == 0)
+        numOfThreads = std::thread::hardware_concurrency();
+
+    if (numOfThreads > 1) {
+        MemSSA::FunctionList funs;
+        for (llvm::Module::iterator iter = pta->getModule()->begin(), eiter = pta->getModule()->end();
+                iter != eiter; ++iter) {
+            if (!analysisUtil::isExtCall(&*iter))
+                funs.push_back(&*iter);
+        }
+        mssa.buildMemSSAInParallel(funs, numOfThreads);
+    }
+    else {
+        DominatorTree dt;
+        MemSSADF df;
 
-    for (llvm::Module::iterator iter = pta->getModule()->begin(), eiter = pta->getModule()->end();
-            iter != eiter; ++iter) {
+        for (llvm::Module::iterator iter = pta->getModule()->begin(), eiter = pta->getModule()->end();
+                iter != eiter; ++iter) {
 
-        llvm::Function& fun = *iter;
-        if (analysisUtil::isExtCall(&fun))
-            continue;
+            llvm::Function& fun = *iter;
+            if (analysisUtil::isExtCall(&fun))
+                continue;
 
-        dt.recalculate(fun);
-        df.runOnDT(dt);
+            dt.recalculate(fun);
+            df.runOnDT(dt);
 
-        mssa.buildMemSSA(fun, &df, &dt);
+            mssa.buildMemSSA(fun, &df, &dt);
+        }
     }
 
     mssa.performStat();
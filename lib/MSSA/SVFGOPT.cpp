@@ -381,7 +381,7 @@ bool SVFGOPT::checkSelfCycleEdges(const MSSAPHISVFGNode* node)
 {
     bool hasSelfCycle = false;
 
-    SVFGEdge::SVFGEdgeSetTy inEdges = node->getInEdges();
+    SVFGNode::GNodeEdgeSetTy inEdges = node->getInEdges();
     SVFGNode::const_iterator inEdgeIt = inEdges.begin();
     SVFGNode::const_iterator inEdgeEit = inEdges.end();
     for (; inEdgeIt != inEdgeEit; ++inEdgeIt) {
@@ -107,10 +107,10 @@ void MemSSAStat::performStat() {
 /*!
  * Print statistics
  */
-void MemSSAStat::printStat() {
+void MemSSAStat::printStat(std::string statname) {
 
     std::cout << "\n****Memory SSA Statistics****\n";
-    PTAStat::printStat();
+    PTAStat::printStat("MemSSA");
 }
 
 /*!
@@ -121,8 +121,8 @@ SVFGStat::SVFGStat(SVFG* g) : PTAStat(NULL)
     graph = g;
     clear();
     startClk();
-    connectDirSVFGEdgeTimeStart = connectDirSVFGEdgeTimeEnd = 0;
-    connectIndSVFGEdgeTimeStart = connectIndSVFGEdgeTimeEnd = 0;
+    connectDirSVFGEdgeTimeStart = connectDirSVFGEdgeTimeEnd = collectDirSVFGEdgeTimeEnd = 0;
+    connectIndSVFGEdgeTimeStart = connectIndSVFGEdgeTimeEnd = collectIndSVFGEdgeTimeEnd = 0;
     addTopLevelNodeTimeStart = addTopLevelNodeTimeEnd = 0;
     addAddrTakenNodeTimeStart = addAddrTakenNodeTimeEnd = 0;
     svfgOptTimeStart = svfgOptTimeEnd = 0;
@@ -169,6 +169,14 @@ void SVFGStat::performStat()
 
     timeStatMap["ConnIndEdgeTime"] = (connectIndSVFGEdgeTimeEnd - connectIndSVFGEdgeTimeStart)/TIMEINTERVAL;
 
+    timeStatMap["CollDirEdgeTime"] = (collectDirSVFGEdgeTimeEnd - connectDirSVFGEdgeTimeStart)/TIMEINTERVAL;
+
+    timeStatMap["MergeDirEdgeTime"] = (connectDirSVFGEdgeTimeEnd - collectDirSVFGEdgeTimeEnd)/TIMEINTERVAL;
+
+    timeStatMap["CollIndEdgeTime"] = (collectIndSVFGEdgeTimeEnd - connectIndSVFGEdgeTimeStart)/TIMEINTERVAL;
+
+    timeStatMap["MergeIndEdgeTime"] = (connectIndSVFGEdgeTimeEnd - collectIndSVFGEdgeTimeEnd)/TIMEINTERVAL;
+
     timeStatMap["TLNodeTime"] = (addTopLevelNodeTimeEnd - addTopLevelNodeTimeStart)/TIMEINTERVAL;
 
     timeStatMap["ATNodeTime"] = (addAddrTakenNodeTimeEnd - addAddrTakenNodeTimeStart)/TIMEINTERVAL;
@@ -201,6 +209,7 @@ void SVFGStat::performStat()
     PTNumStatMap["TotalEdge"] = totalInEdge;
     PTNumStatMap["DirectEdge"] = totalInEdge - totalIndInEdge;
     PTNumStatMap["IndirectEdge"] = totalIndInEdge;
+    PTNumStatMap["IndEdgePtsSet"] = graph->getPointsToPool().size();
 
     PTNumStatMap["IndCallEdge"] = totalIndCallEdge;
     PTNumStatMap["IndRetEdge"] = totalIndRetEdge;
@@ -279,7 +288,7 @@ void SVFGStat::processGraph()
 void SVFGStat::calculateNodeDegrees(SVFGNode* node, NodeSet& nodeHasIndInEdge, NodeSet& nodeHasIndOutEdge)
 {
     // Incoming edge
-    const SVFGEdge::SVFGEdgeSetTy& inEdges = node->getInEdges();
+    const SVFGNode::GNodeEdgeSetTy& inEdges = node->getInEdges();
     // total in edge
     if (inEdges.size() > maxInDegree)
         maxInDegree = inEdges.size();
@@ -287,8 +296,8 @@ void SVFGStat::calculateNodeDegrees(SVFGNode* node, NodeSet& nodeHasIndInEdge, N
 
     // indirect in edge
     Size_t indInEdges = 0;
-    SVFGEdge::SVFGEdgeSetTy::const_iterator edgeIt = inEdges.begin();
-    SVFGEdge::SVFGEdgeSetTy::const_iterator edgeEit = inEdges.end();
+    SVFGNode::const_iterator edgeIt = inEdges.begin();
+    SVFGNode::const_iterator edgeEit = inEdges.end();
     for (; edgeIt != edgeEit; ++edgeIt) {
         if (IndirectSVFGEdge* edge = dyn_cast<IndirectSVFGEdge>(*edgeIt)) {
             indInEdges++;
@@ -316,7 +325,7 @@ void SVFGStat::calculateNodeDegrees(SVFGNode* node, NodeSet& nodeHasIndInEdge, N
     /*-----------------------------------------------------*/
 
     // Outgoing edge
-    const SVFGEdge::SVFGEdgeSetTy& outEdges = node->getOutEdges();
+    const SVFGNode::GNodeEdgeSetTy& outEdges = node->getOutEdges();
     // total out edge
     if (outEdges.size() > maxOutDegree)
         maxOutDegree = outEdges.size();
@@ -378,8 +387,8 @@ void SVFGStat::performSCCStat(SVFGEdgeSet insensitiveCalRetEdges) {
                 maxNodeInCycle = subNodes.count();
         }
 
-        SVFGEdge::SVFGEdgeSetTy::const_iterator edgeIt = it->second->InEdgeBegin();
-        SVFGEdge::SVFGEdgeSetTy::const_iterator edgeEit = it->second->InEdgeEnd();
+        SVFGNode::const_iterator edgeIt = it->second->InEdgeBegin();
+        SVFGNode::const_iterator edgeEit = it->second->InEdgeEnd();
         for (; edgeIt != edgeEit; ++edgeIt) {
 
             const SVFGEdge *edge = *edgeIt;
@@ -450,14 +459,14 @@ void SVFGStat::performSCCStat(SVFGEdgeSet insensitiveCalRetEdges) {
 
 
     std::cout << "\n****SVFG SCC Stat****\n";
-    PTAStat::printStat();
+    PTAStat::printStat("SVFGSCC");
 
     delete svfgSCC;
 
 }
 
-void SVFGStat::printStat()
+void SVFGStat::printStat(std::string statname)
 {
     std::cout << "\n****SVFG Statistics****\n";
-    PTAStat::printStat();
+    PTAStat::printStat("SVFG");
 }
@@ -131,7 +131,7 @@ bool ConstraintGraph::addAddrCGEdge(NodeID src, NodeID dst) {
     ConstraintNode* dstNode = getConstraintNode(dst);
     if(hasEdge(srcNode,dstNode,ConstraintEdge::Addr))
         return false;
-    AddrCGEdge* edge = new AddrCGEdge(srcNode, dstNode, edgeIndex++);
+    AddrCGEdge* edge = new (arena) AddrCGEdge(srcNode, dstNode, edgeIndex++);
     bool added = AddrCGEdgeSet.insert(edge).second;
     assert(added && "not added??");
     srcNode->addOutgoingAddrEdge(edge);
@@ -150,11 +150,12 @@ bool ConstraintGraph::addCopyCGEdge(NodeID src, NodeID dst) {
             || srcNode == dstNode)
         return false;
 
-    CopyCGEdge* edge = new CopyCGEdge(srcNode, dstNode, edgeIndex++);
+    CopyCGEdge* edge = new (arena) CopyCGEdge(srcNode, dstNode, edgeIndex++);
     bool added = directEdgeSet.insert(edge).second;
     assert(added && "not added??");
     srcNode->addOutgoingCopyEdge(edge);
     dstNode->addIncomingCopyEdge(edge);
+    addNewDirectEdge(srcNode->getId(), dstNode->getId());
     return added;
 }
 
@@ -168,11 +169,12 @@ bool ConstraintGraph::addNormalGepCGEdge(NodeID src, NodeID dst, const LocationS
     if(hasEdge(srcNode,dstNode,ConstraintEdge::NormalGep))
         return false;
 
-    NormalGepCGEdge* edge = new NormalGepCGEdge(srcNode, dstNode,ls, edgeIndex++);
+    NormalGepCGEdge* edge = new (arena) NormalGepCGEdge(srcNode, dstNode,ls, edgeIndex++);
     bool added = directEdgeSet.insert(edge).second;
     assert(added && "not added??");
     srcNode->addOutgoingGepEdge(edge);
     dstNode->addIncomingGepEdge(edge);
+    addNewDirectEdge(srcNode->getId(), dstNode->getId());
     return added;
 }
 
@@ -185,11 +187,12 @@ bool ConstraintGraph::addVariantGepCGEdge(NodeID src, NodeID dst) {
     if(hasEdge(srcNode,dstNode,ConstraintEdge::VariantGep))
         return false;
 
-    VariantGepCGEdge* edge = new VariantGepCGEdge(srcNode, dstNode, edgeIndex++);
+    VariantGepCGEdge* edge = new (arena) VariantGepCGEdge(srcNode, dstNode, edgeIndex++);
     bool added = directEdgeSet.insert(edge).second;
     assert(added && "not added??");
     srcNode->addOutgoingGepEdge(edge);
     dstNode->addIncomingGepEdge(edge);
+    addNewDirectEdge(srcNode->getId(), dstNode->getId());
     return added;
 }
 
@@ -202,7 +205,7 @@ bool ConstraintGraph::addLoadCGEdge(NodeID src, NodeID dst) {
     if(hasEdge(srcNode,dstNode,ConstraintEdge::Load))
         return false;
 
-    LoadCGEdge* edge = new LoadCGEdge(srcNode, dstNode, edgeIndex++);
+    LoadCGEdge* edge = new (arena) LoadCGEdge(srcNode, dstNode, edgeIndex++);
     bool added = LoadCGEdgeSet.insert(edge).second;
     assert(added && "not added??");
     srcNode->addOutgoingLoadEdge(edge);
@@ -219,7 +222,7 @@ bool ConstraintGraph::addStoreCGEdge(NodeID src, NodeID dst) {
     if(hasEdge(srcNode,dstNode,ConstraintEdge::Store))
         return false;
 
-    StoreCGEdge* edge = new StoreCGEdge(srcNode, dstNode, edgeIndex++);
+    StoreCGEdge* edge = new (arena) StoreCGEdge(srcNode, dstNode, edgeIndex++);
     bool added = StoreCGEdgeSet.insert(edge).second;
     assert(added && "not added??");
     srcNode->addOutgoingStoreEdge(edge);
@@ -228,6 +231,61 @@ bool ConstraintGraph::addStoreCGEdge(NodeID src, NodeID dst) {
 }
 
 
+/*!
+ * Make the union-find arrays cover node id, each new node is a set of its own
+ */
+void ConstraintGraph::growRepArrays(NodeID id) {
+    NodeID size = repParent.size();
+    if (id < size)
+        return;
+    NodeID newSize = std::max(id + 1, size * 2);
+    repParent.resize(newSize);
+    repRank.resize(newSize, 0);
+    rootToRep.resize(newSize);
+    nextSubNode.resize(newSize);
+    for (NodeID n = size; n < newSize; n++) {
+        repParent[n] = n;
+        rootToRep[n] = n;
+        nextSubNode[n] = n;
+    }
+}
+
+/*!
+ * Find the root of the set of id and compress the path to it
+ */
+NodeID ConstraintGraph::compressRepPath(NodeID id) {
+    NodeID root = findRepRoot(id);
+    while (repParent[id] != root) {
+        NodeID parent = repParent[id];
+        repParent[id] = root;
+        id = parent;
+    }
+    return root;
+}
+
+/*!
+ * Union the set of node into the set of rep (union by rank).
+ * The rep node of rep's set becomes the rep node of the union, whichever root is kept.
+ */
+void ConstraintGraph::setRep(NodeID node, NodeID rep) {
+    growRepArrays(std::max(node, rep));
+    NodeID nodeRoot = compressRepPath(node);
+    NodeID repRoot = compressRepPath(rep);
+    if (nodeRoot == repRoot)
+        return;
+
+    NodeID newRep = rootToRep[repRoot];
+    if (repRank[nodeRoot] > repRank[repRoot])
+        std::swap(nodeRoot, repRoot);
+    else if (repRank[nodeRoot] == repRank[repRoot])
+        repRank[repRoot]++;
+    repParent[nodeRoot] = repRoot;
+    rootToRep[repRoot] = newRep;
+
+    /// splice the two circles of sub nodes
+    std::swap(nextSubNode[node], nextSubNode[rep]);
+}
+
 /*!
  * Re-target dst node of an edge
  *
@@ -26,6 +26,10 @@ using namespace llvm;
 static cl::opt<bool> singleStride("stride-only", cl::init(false),
                                   cl::desc("Only use single stride in LocMemoryModel"));
 
+std::string LocationSet::getOptionKey() {
+    return singleStride ? "stride-only=1" : "stride-only=0";
+}
+
 /*!
  * Add element num and stride pair
  */
@@ -42,6 +42,13 @@ static cl::opt<unsigned> maxFieldNumLimit("fieldlimit",  cl::init(10000),
 static cl::opt<bool> LocMemModel("locMM", cl::init(false),
                                  cl::desc("Bytes/bits modeling of memory locations"));
 
+std::string SymbolTableInfo::getOptionKey() {
+    std::string key;
+    raw_string_ostream os(key);
+    os << "fieldlimit=" << maxFieldNumLimit << " locMM=" << LocMemModel << " " << LocationSet::getOptionKey();
+    return os.str();
+}
+
 /*!
  * Get the symbol table instance
  */
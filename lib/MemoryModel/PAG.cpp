@@ -31,6 +31,16 @@ static cl::opt<bool> HANDBLACKHOLE("blk", cl::init(false),
 
 PAG* PAG::pag = NULL;
 
+/*!
+ * Options of PAG construction and of the memory model, part of the keys of results cached on disk
+ */
+std::string PAG::getOptionKey() {
+    std::string key;
+    raw_string_ostream os(key);
+    os << "vgep=" << HANDLEVGEP << " blk=" << HANDBLACKHOLE << " " << SymbolTableInfo::getOptionKey();
+    return os.str();
+}
+
 
 /*!
  * Add Address edge
@@ -41,7 +51,7 @@ bool PAG::addAddrEdge(NodeID src, NodeID dst) {
     if(hasIntraEdge(srcNode,dstNode, PAGEdge::Addr))
         return false;
     else
-        return addEdge(srcNode,dstNode, new AddrPE(srcNode, dstNode));
+        return addEdge(srcNode,dstNode, new (arena) AddrPE(srcNode, dstNode));
 }
 
 /*!
@@ -53,7 +63,7 @@ bool PAG::addCopyEdge(NodeID src, NodeID dst) {
     if(hasIntraEdge(srcNode,dstNode, PAGEdge::Copy))
         return false;
     else
-        return addEdge(srcNode,dstNode, new CopyPE(srcNode, dstNode));
+        return addEdge(srcNode,dstNode, new (arena) CopyPE(srcNode, dstNode));
 }
 
 /*!
@@ -65,7 +75,7 @@ bool PAG::addLoadEdge(NodeID src, NodeID dst) {
     if(hasIntraEdge(srcNode,dstNode, PAGEdge::Load))
         return false;
     else
-        return addEdge(srcNode,dstNode, new LoadPE(srcNode, dstNode));
+        return addEdge(srcNode,dstNode, new (arena) LoadPE(srcNode, dstNode));
 }
 
 /*!
@@ -77,7 +87,7 @@ bool PAG::addStoreEdge(NodeID src, NodeID dst) {
     if(hasIntraEdge(srcNode,dstNode, PAGEdge::Store))
         return false;
     else
-        return addEdge(srcNode,dstNode, new StorePE(srcNode, dstNode));
+        return addEdge(srcNode,dstNode, new (arena) StorePE(srcNode, dstNode));
 }
 
 /*!
@@ -89,7 +99,7 @@ bool PAG::addCallEdge(NodeID src, NodeID dst, const llvm::Instruction* cs) {
     if(hasInterEdge(srcNode,dstNode, PAGEdge::Call, cs))
         return false;
     else
-        return addEdge(srcNode,dstNode, new CallPE(srcNode, dstNode, cs));
+        return addEdge(srcNode,dstNode, new (arena) CallPE(srcNode, dstNode, cs));
 }
 
 /*!
@@ -101,7 +111,7 @@ bool PAG::addRetEdge(NodeID src, NodeID dst, const llvm::Instruction* cs) {
     if(hasInterEdge(srcNode,dstNode, PAGEdge::Ret, cs))
         return false;
     else
-        return addEdge(srcNode,dstNode, new RetPE(srcNode, dstNode, cs));
+        return addEdge(srcNode,dstNode, new (arena) RetPE(srcNode, dstNode, cs));
 }
 
 /*!
@@ -123,7 +133,7 @@ bool PAG::addThreadForkEdge(NodeID src, NodeID dst, const llvm::Instruction* cs)
     if(hasInterEdge(srcNode,dstNode, PAGEdge::ThreadFork, cs))
         return false;
     else
-        return addEdge(srcNode,dstNode, new TDForkPE(srcNode, dstNode, cs));
+        return addEdge(srcNode,dstNode, new (arena) TDForkPE(srcNode, dstNode, cs));
 }
 
 /*!
@@ -135,7 +145,7 @@ bool PAG::addThreadJoinEdge(NodeID src, NodeID dst, const llvm::Instruction* cs)
     if(hasInterEdge(srcNode,dstNode, PAGEdge::ThreadJoin, cs))
         return false;
     else
-        return addEdge(srcNode,dstNode, new TDJoinPE(srcNode, dstNode, cs));
+        return addEdge(srcNode,dstNode, new (arena) TDJoinPE(srcNode, dstNode, cs));
 }
 
 
@@ -167,7 +177,7 @@ bool PAG::addNormalGepEdge(NodeID src, NodeID dst, const LocationSet& ls) {
     if(hasIntraEdge(baseNode, dstNode, PAGEdge::NormalGep))
         return false;
     else
-        return addEdge(baseNode, dstNode, new NormalGepPE(baseNode, dstNode, ls+baseLS));
+        return addEdge(baseNode, dstNode, new (arena) NormalGepPE(baseNode, dstNode, ls+baseLS));
 }
 
 /*!
@@ -183,7 +193,7 @@ bool PAG::addVariantGepEdge(NodeID src, NodeID dst) {
     if(hasIntraEdge(baseNode, dstNode, PAGEdge::VariantGep))
         return false;
     else
-        return addEdge(baseNode, dstNode, new VariantGepPE(baseNode, dstNode));
+        return addEdge(baseNode, dstNode, new (arena) VariantGepPE(baseNode, dstNode));
 }
 
 /*!
@@ -416,7 +426,7 @@ NodeID PAG::getBaseValNode(NodeID nodeId) {
 
         assert(((ngeps.size()+vgeps.size())==1) && "one node can only be connected by at most one gep edge!");
 
-        PAGNode::iterator it;
+        PAGEdge::PAGEdgeSetTy::iterator it;
         if(!ngeps.empty())
             it = ngeps.begin();
         else
@@ -443,7 +453,7 @@ LocationSet PAG::getLocationSetFromBaseNode(NodeID nodeId) {
         return LocationSet(0);
 
     assert(geps.size()==1 && "one node can only be connected by at most one gep edge!");
-    PAGNode::iterator it = geps.begin();
+    PAGEdge::PAGEdgeSetTy::iterator it = geps.begin();
     const PAGEdge* edge = *it;
     assert(isa<NormalGepPE>(edge) && "not a get edge??");
     const NormalGepPE* gepEdge = cast<NormalGepPE>(edge);
@@ -93,6 +93,16 @@ PAG* PAGBuilder::build(llvm::Module& module) {
 void PAGBuilder::initalNode() {
     DBOUT(DPAGBuild, outs() << "Inital PAG Node ...\n");
 
+    addSymbolNodes();
+
+    /// let all undef value or non-determined pointers points-to black hole
+    pag->addBlackHoleAddrEdge(SymbolTableInfo::Symbolnfo()->blkPtrSymID());
+}
+
+/*
+ * Add a node for every symbol in the symbol table
+ */
+void PAGBuilder::addSymbolNodes() {
     SymbolTableInfo* symTable = SymbolTableInfo::Symbolnfo();
 
     pag->addBlackholeObjNode();
@@ -100,9 +110,6 @@ void PAGBuilder::initalNode() {
     pag->addBlackholePtrNode();
     pag->addNullPtrNode();
 
-    /// let all undef value or non-determined pointers points-to black hole
-    pag->addBlackHoleAddrEdge(symTable->blkPtrSymID());
-
     for (SymbolTableInfo::ValueToIDMapTy::iterator iter =
                 symTable->valSyms().begin(); iter != symTable->valSyms().end();
             ++iter) {
@@ -970,9 +977,9 @@ void PAGBuilderFromFile::addEdge(NodeID srcID, NodeID dstID,
     else if (edge == "variant-gep")
         pag->addVariantGepEdge(srcID, dstID);
     else if (edge == "call")
-        pag->addEdge(srcNode, dstNode, new CallPE(srcNode, dstNode, NULL));
+        pag->addEdge(srcNode, dstNode, new (pag->getArena()) CallPE(srcNode, dstNode, NULL));
     else if (edge == "ret")
-        pag->addEdge(srcNode, dstNode, new RetPE(srcNode, dstNode, NULL));
+        pag->addEdge(srcNode, dstNode, new (pag->getArena()) RetPE(srcNode, dstNode, NULL));
     else
         assert(false && "format not support, can not create such edge");
 }
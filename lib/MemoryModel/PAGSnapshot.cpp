@@ -0,0 +1,511 @@
+//===- PAGSnapshot.cpp -- Binary snapshot of PAG------------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PAGSnapshot.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  File layout (native byte order):
+ *    SnapshotHeader
+ *    char[optionsLen]                options of the memory model (see PAG::getOptionKey), padded
+ *    NodeRecord[numOfNodeRecords]    nodes created after the symbol nodes, in id order
+ *    EdgeRecord[numOfEdgeRecords]    edges in creation order
+ *    PhiRecord[numOfPhis]
+ *    PairRecord[numOfFunArgs]        (function, formal parameter) in argument order
+ *    PairRecord[numOfFunRets]        (function, return node)
+ *    PairRecord[numOfCSArgs]         (callsite, actual parameter) in argument order
+ *    PairRecord[numOfCSRets]         (callsite, callsite return node)
+ *    PairRecord[numOfIndCSs]         (indirect callsite, function pointer)
+ *    PairRecord[numOfLSPairs]        (element number, stride) pairs of the location sets
+ *
+ *  Symbol nodes are not stored, they are created from the symbol table which is
+ *  built before the PAG. Functions, basic blocks and instructions are referred to
+ *  by their position in the module. A location set of a record is its offset
+ *  and the range [firstPair, firstPair + numOfPairs) of the location set pairs.
+ */
+
+#include "MemoryModel/PAGSnapshot.h"
+#include "MemoryModel/PAGBuilder.h"
+#include "Util/AnalysisUtil.h"
+
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <stdint.h>
+#include <string.h>
+
+using namespace llvm;
+using namespace analysisUtil;
+
+namespace {
+
+const char SnapshotMagic[8] = {'S', 'V', 'F', 'P', 'A', 'G', '\0', '\0'};
+const u32_t SnapshotVersion = 2;
+
+struct SnapshotHeader {
+    char magic[8];
+    u32_t version;
+    char hash[32];
+    u32_t numOfSyms;
+    u32_t numOfNodes;
+    u32_t numOfFuns;
+    u32_t numOfBBs;
+    u32_t numOfInsts;
+    u32_t storeInstNum;
+    u32_t loadInstNum;
+    u32_t numOfNodeRecords;
+    u32_t numOfEdgeRecords;
+    u32_t numOfPhis;
+    u32_t numOfFunArgs;
+    u32_t numOfFunRets;
+    u32_t numOfCSArgs;
+    u32_t numOfCSRets;
+    u32_t numOfIndCSs;
+    u32_t numOfLSPairs;
+    u32_t optionsLen;
+};
+
+struct NodeRecord {
+    u32_t id;
+    u32_t kind;
+    u32_t ref;	///< value node of a GepValPN, or mem object of a GepObjPN
+    u32_t base;	///< base value node of a GepValPN
+    u32_t firstPair;
+    u32_t numOfPairs;
+    int64_t offset;
+};
+
+struct EdgeRecord {
+    u32_t kind;
+    u32_t src;
+    u32_t dst;
+    u32_t callInst;	///< callsite of call/ret/fork/join edges
+    u32_t inst;	///< instruction of the edge, 0 for global and function entry edges
+    u32_t entryFun;	///< function of a function entry edge
+    u32_t firstPair;	///< location set of normal gep edges
+    u32_t numOfPairs;
+    int64_t offset;
+};
+
+struct PhiRecord {
+    u32_t res;
+    u32_t op;
+    u32_t bb;
+};
+
+struct PairRecord {
+    u32_t first;
+    u32_t second;
+};
+
+inline bool edgeIDLess(const PAGEdge* lhs, const PAGEdge* rhs) {
+    return lhs->getEdgeID() < rhs->getEdgeID();
+}
+
+/// Options are padded so that the records after them stay aligned
+inline void padToRecords(std::string& str) {
+    str.resize((str.size() + sizeof(int64_t) - 1) / sizeof(int64_t) * sizeof(int64_t), ' ');
+}
+
+/// Append the (element number, stride) pairs of a location set
+inline void addLSPairs(std::vector<PairRecord>& lsPairs, const LocationSet& ls, u32_t& firstPair, u32_t& numOfPairs) {
+    firstPair = lsPairs.size();
+    numOfPairs = ls.getNumStridePair().size();
+    for (LocationSet::ElemNumStridePairVec::const_iterator it = ls.getNumStridePair().begin(),
+            eit = ls.getNumStridePair().end(); it != eit; ++it) {
+        PairRecord r = {it->first, it->second};
+        lsPairs.push_back(r);
+    }
+}
+
+inline bool isValidLSPairs(u32_t firstPair, u32_t numOfPairs, u32_t numOfLSPairs) {
+    return (u64_t)firstPair + numOfPairs <= numOfLSPairs;
+}
+
+inline LocationSet getLocationSet(int64_t offset, u32_t firstPair, u32_t numOfPairs, const PairRecord* lsPairs) {
+    LocationSet ls(offset);
+    for (u32_t i = firstPair; i < firstPair + numOfPairs; i++)
+        ls.addElemNumStridePair(std::make_pair(lsPairs[i].first, lsPairs[i].second));
+    return ls;
+}
+
+/// Kinds of the nodes which are not created from the symbol table
+inline bool isRecordNodeKind(u32_t kind) {
+    return kind == PAGNode::GepValNode || kind == PAGNode::GepObjNode
+           || kind == PAGNode::DummyValNode || kind == PAGNode::DummyObjNode;
+}
+
+template<class Record>
+inline void writeRecords(raw_ostream& os, const std::vector<Record>& records) {
+    if (!records.empty())
+        os.write((const char*)&records[0], records.size() * sizeof(Record));
+}
+
+}
+
+/*!
+ * Constructor
+ */
+PAGSnapshot::PAGSnapshot(const std::string& dir, llvm::Module& m) : module(m) {
+    hash = getModuleHash(module);
+    SmallString<128> path(dir);
+    sys::path::append(path, hash + ".pag");
+    file.assign(path.begin(), path.end());
+    numberValues();
+}
+
+/*!
+ * Number functions, basic blocks and instructions
+ */
+void PAGSnapshot::numberValues() {
+    for (Module::const_iterator fit = module.begin(), efit = module.end(); fit != efit; ++fit) {
+        const Function& fun = *fit;
+        funs.push_back(&fun);
+        funToIndex[&fun] = funs.size();
+        for (Function::const_iterator bit = fun.begin(), ebit = fun.end(); bit != ebit; ++bit) {
+            const BasicBlock& bb = *bit;
+            bbs.push_back(&bb);
+            bbToIndex[&bb] = bbs.size();
+            for (BasicBlock::const_iterator it = bb.begin(), eit = bb.end(); it != eit; ++it) {
+                insts.push_back(&*it);
+                instToIndex[&*it] = insts.size();
+            }
+        }
+    }
+}
+
+/*!
+ * Rebuild PAG from the snapshot.
+ * The whole file is checked before the PAG is created, so that a stale or
+ * truncated snapshot falls back to building the PAG from IR.
+ */
+PAG* PAGSnapshot::read() {
+    ErrorOr<std::unique_ptr<MemoryBuffer> > fileOrErr = MemoryBuffer::getFile(file, -1, false);
+    if (!fileOrErr)
+        return NULL;
+
+    const char* start = (*fileOrErr)->getBufferStart();
+    size_t size = (*fileOrErr)->getBufferSize();
+    if (size < sizeof(SnapshotHeader) || (uintptr_t)start % sizeof(int64_t) != 0)
+        return NULL;
+
+    /// Records are used in place, there is no per-element decoding
+    const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(start);
+    SymbolTableInfo* symTable = SymbolTableInfo::Symbolnfo();
+    std::string options = PAG::getOptionKey();
+    padToRecords(options);
+    if (memcmp(header->magic, SnapshotMagic, sizeof(SnapshotMagic))
+            || header->version != SnapshotVersion
+            || hash != std::string(header->hash, sizeof(header->hash))
+            || header->numOfSyms != symTable->getTotalSymNum()
+            || header->numOfFuns != funs.size() || header->numOfBBs != bbs.size() || header->numOfInsts != insts.size())
+        return NULL;
+
+    /// counts come from the file, so they are summed in 64 bits
+    u64_t numOfPairRecords = (u64_t)header->numOfFunArgs + header->numOfFunRets + header->numOfCSArgs
+                             + header->numOfCSRets + header->numOfIndCSs + header->numOfLSPairs;
+    u64_t expected = sizeof(SnapshotHeader) + (u64_t)header->optionsLen
+                     + (u64_t)header->numOfNodeRecords * sizeof(NodeRecord)
+                     + (u64_t)header->numOfEdgeRecords * sizeof(EdgeRecord)
+                     + (u64_t)header->numOfPhis * sizeof(PhiRecord)
+                     + numOfPairRecords * sizeof(PairRecord);
+    if (size != expected || (u64_t)header->numOfSyms + header->numOfNodeRecords != header->numOfNodes)
+        return NULL;
+
+    const char* cachedOptions = reinterpret_cast<const char*>(header + 1);
+    if (options != std::string(cachedOptions, header->optionsLen))
+        return NULL;
+
+    const NodeRecord* nodes = reinterpret_cast<const NodeRecord*>(cachedOptions + header->optionsLen);
+    const EdgeRecord* edges = reinterpret_cast<const EdgeRecord*>(nodes + header->numOfNodeRecords);
+    const PhiRecord* phis = reinterpret_cast<const PhiRecord*>(edges + header->numOfEdgeRecords);
+    const PairRecord* funArgs = reinterpret_cast<const PairRecord*>(phis + header->numOfPhis);
+    const PairRecord* funRets = funArgs + header->numOfFunArgs;
+    const PairRecord* csArgs = funRets + header->numOfFunRets;
+    const PairRecord* csRets = csArgs + header->numOfCSArgs;
+    const PairRecord* indCSs = csRets + header->numOfCSRets;
+    const PairRecord* lsPairs = indCSs + header->numOfIndCSs;
+
+    NodeID numOfNodes = header->numOfNodes;
+    for (u32_t i = 0; i < header->numOfNodeRecords; i++) {
+        if (nodes[i].id != header->numOfSyms + i || !isRecordNodeKind(nodes[i].kind)
+                || nodes[i].ref >= numOfNodes || nodes[i].base >= numOfNodes
+                || !isValidLSPairs(nodes[i].firstPair, nodes[i].numOfPairs, header->numOfLSPairs))
+            return NULL;
+    }
+    for (u32_t i = 0; i < header->numOfEdgeRecords; i++) {
+        const EdgeRecord& e = edges[i];
+        if (e.kind > PAGEdge::ThreadJoin || e.src >= numOfNodes || e.dst >= numOfNodes
+                || e.callInst > insts.size() || e.inst > insts.size() || e.entryFun > funs.size()
+                || !isValidLSPairs(e.firstPair, e.numOfPairs, header->numOfLSPairs))
+            return NULL;
+    }
+    for (u32_t i = 0; i < header->numOfPhis; i++) {
+        if (phis[i].res >= numOfNodes || phis[i].op >= numOfNodes || phis[i].bb > bbs.size())
+            return NULL;
+    }
+    for (const PairRecord* r = funArgs; r != csArgs; ++r) {
+        if (r->first == 0 || r->first > funs.size() || r->second >= numOfNodes)
+            return NULL;
+    }
+    for (const PairRecord* r = csArgs; r != indCSs + header->numOfIndCSs; ++r) {
+        if (r->first == 0 || r->first > insts.size() || r->second >= numOfNodes)
+            return NULL;
+    }
+
+    PAG* pag = PAG::getPAG();
+    PAGBuilder builder;
+    builder.addSymbolNodes();
+
+    for (u32_t i = 0; i < header->numOfNodeRecords; i++) {
+        const NodeRecord& n = nodes[i];
+        switch (n.kind) {
+        case PAGNode::GepValNode: {
+            LocationSet ls = getLocationSet(n.offset, n.firstPair, n.numOfPairs, lsPairs);
+            pag->GepValNodeMap[std::make_pair(n.base, ls)] = n.id;
+            pag->addNode(new GepValPN(pag->getPAGNode(n.ref)->getValue(), n.id, ls), n.id);
+            break;
+        }
+        case PAGNode::GepObjNode:
+            pag->addGepObjNode(symTable->getObj(n.ref), getLocationSet(n.offset, n.firstPair, n.numOfPairs, lsPairs), n.id);
+            break;
+        case PAGNode::DummyValNode:
+            pag->addDummyValNode(n.id);
+            break;
+        case PAGNode::DummyObjNode:
+            pag->addNode(new DummyObjPN(n.id, symTable->createDummyObj(n.id)), n.id);
+            break;
+        default:
+            assert(false && "node kinds are checked before the PAG is created");
+        }
+    }
+
+    for (u32_t i = 0; i < header->numOfEdgeRecords; i++) {
+        const EdgeRecord& e = edges[i];
+        PAGNode* src = pag->getPAGNode(e.src);
+        PAGNode* dst = pag->getPAGNode(e.dst);
+        const Instruction* callInst = e.callInst ? insts[e.callInst - 1] : NULL;
+        PAGEdge* edge = NULL;
+        switch (e.kind) {
+        case PAGEdge::Addr:
+            edge = new (pag->getArena()) AddrPE(src, dst);
+            break;
+        case PAGEdge::Copy:
+            edge = new (pag->getArena()) CopyPE(src, dst);
+            break;
+        case PAGEdge::Store:
+            edge = new (pag->getArena()) StorePE(src, dst);
+            break;
+        case PAGEdge::Load:
+            edge = new (pag->getArena()) LoadPE(src, dst);
+            break;
+        case PAGEdge::Call:
+            edge = new (pag->getArena()) CallPE(src, dst, callInst);
+            break;
+        case PAGEdge::Ret:
+            edge = new (pag->getArena()) RetPE(src, dst, callInst);
+            break;
+        case PAGEdge::NormalGep:
+            edge = new (pag->getArena()) NormalGepPE(src, dst, getLocationSet(e.offset, e.firstPair, e.numOfPairs, lsPairs));
+            break;
+        case PAGEdge::VariantGep:
+            edge = new (pag->getArena()) VariantGepPE(src, dst);
+            break;
+        case PAGEdge::ThreadFork:
+            edge = new (pag->getArena()) TDForkPE(src, dst, callInst);
+            break;
+        case PAGEdge::ThreadJoin:
+            edge = new (pag->getArena()) TDJoinPE(src, dst, callInst);
+            break;
+        }
+        /// PAG::addEdge() decides where an edge goes by the current location
+        if (e.inst)
+            pag->setCurrentLocation(insts[e.inst - 1], insts[e.inst - 1]->getParent());
+        else if (e.entryFun)
+            pag->setCurrentLocation(NULL, &funs[e.entryFun - 1]->getEntryBlock());
+        else
+            pag->setCurrentLocation(NULL, NULL);
+        pag->addEdge(src, dst, edge);
+    }
+    pag->setCurrentLocation(NULL, NULL);
+
+    for (u32_t i = 0; i < header->numOfPhis; i++)
+        pag->addPhiNode(pag->getPAGNode(phis[i].res), pag->getPAGNode(phis[i].op), phis[i].bb ? bbs[phis[i].bb - 1] : NULL);
+    for (u32_t i = 0; i < header->numOfFunArgs; i++)
+        pag->addFunArgs(funs[funArgs[i].first - 1], pag->getPAGNode(funArgs[i].second));
+    for (u32_t i = 0; i < header->numOfFunRets; i++)
+        pag->addFunRet(funs[funRets[i].first - 1], pag->getPAGNode(funRets[i].second));
+    for (u32_t i = 0; i < header->numOfCSArgs; i++)
+        pag->addCallSiteArgs(getLLVMCallSite(insts[csArgs[i].first - 1]), pag->getPAGNode(csArgs[i].second));
+    for (u32_t i = 0; i < header->numOfCSRets; i++)
+        pag->addCallSiteRets(getLLVMCallSite(insts[csRets[i].first - 1]), pag->getPAGNode(csRets[i].second));
+    for (u32_t i = 0; i < header->numOfIndCSs; i++)
+        pag->addIndirectCallsites(getLLVMCallSite(insts[indCSs[i].first - 1]), indCSs[i].second);
+
+    pag->storeInstNum = header->storeInstNum;
+    pag->loadInstNum = header->loadInstNum;
+
+    pag->initialiseCandidatePointers();
+
+    return pag;
+}
+
+/*!
+ * Write PAG into the snapshot
+ */
+bool PAGSnapshot::write(PAG* pag) {
+    SymbolTableInfo* symTable = SymbolTableInfo::Symbolnfo();
+    NodeID numOfSyms = symTable->getTotalSymNum();
+    NodeID numOfNodes = pag->getTotalNodeNum();
+
+    /// nodes which are not created from the symbol table
+    std::map<NodeID, PAG::NodeLocationSet> gepValToBase;
+    for (PAG::NodeLocationSetMap::const_iterator it = pag->GepValNodeMap.begin(), eit = pag->GepValNodeMap.end(); it != eit; ++it)
+        gepValToBase[it->second] = it->first;
+
+    std::vector<PairRecord> lsPairs;
+    std::vector<NodeRecord> nodes;
+    for (NodeID id = numOfSyms; id < numOfNodes; id++) {
+        PAGNode* node = pag->getPAGNode(id);
+        NodeRecord n = {id, (u32_t)node->getNodeKind(), 0, 0, 0, 0, 0};
+        if (GepValPN* gepVal = dyn_cast<GepValPN>(node)) {
+            n.ref = pag->getValueNode(gepVal->getValue());
+            n.base = gepValToBase[id].first;
+            n.offset = gepValToBase[id].second.getOffset();
+            addLSPairs(lsPairs, gepValToBase[id].second, n.firstPair, n.numOfPairs);
+        }
+        else if (GepObjPN* gepObj = dyn_cast<GepObjPN>(node)) {
+            n.ref = gepObj->getMemObj()->getSymId();
+            n.offset = gepObj->getLocationSet().getOffset();
+            addLSPairs(lsPairs, gepObj->getLocationSet(), n.firstPair, n.numOfPairs);
+        }
+        else if (!isa<DummyValPN>(node) && !isa<DummyObjPN>(node)) {
+            wrnMsg("unexpected PAG node kind, PAG snapshot not written");
+            return false;
+        }
+        nodes.push_back(n);
+    }
+
+    /// edges in creation order
+    std::vector<const PAGEdge*> allEdges;
+    for (PAGEdge::PAGKindToEdgeSetMapTy::const_iterator it = pag->PAGEdgeKindToSetMap.begin(),
+            eit = pag->PAGEdgeKindToSetMap.end(); it != eit; ++it)
+        allEdges.insert(allEdges.end(), it->second.begin(), it->second.end());
+    std::sort(allEdges.begin(), allEdges.end(), edgeIDLess);
+
+    llvm::DenseMap<const PAGEdge*, const Function*> entryEdgeToFun;
+    for (PAG::FunToPAGEdgeSetMap::const_iterator it = pag->funToEntryPAGEdges.begin(),
+            eit = pag->funToEntryPAGEdges.end(); it != eit; ++it) {
+        for (PAG::PAGEdgeSet::const_iterator eit2 = it->second.begin(), eeit2 = it->second.end(); eit2 != eeit2; ++eit2)
+            entryEdgeToFun[*eit2] = it->first;
+    }
+
+    std::vector<EdgeRecord> edges;
+    for (std::vector<const PAGEdge*>::const_iterator it = allEdges.begin(), eit = allEdges.end(); it != eit; ++it) {
+        const PAGEdge* edge = *it;
+        EdgeRecord e = {(u32_t)edge->getEdgeKind(), edge->getSrcID(), edge->getDstID(), 0,
+                        getIndex(instToIndex, edge->getInst()), 0, 0, 0, 0
+                       };
+        if (const CallPE* call = dyn_cast<CallPE>(edge))
+            e.callInst = getIndex(instToIndex, call->getCallInst());
+        else if (const RetPE* ret = dyn_cast<RetPE>(edge))
+            e.callInst = getIndex(instToIndex, ret->getCallInst());
+        else if (const TDForkPE* fork = dyn_cast<TDForkPE>(edge))
+            e.callInst = getIndex(instToIndex, fork->getCallInst());
+        else if (const TDJoinPE* join = dyn_cast<TDJoinPE>(edge))
+            e.callInst = getIndex(instToIndex, join->getCallInst());
+        else if (const NormalGepPE* gep = dyn_cast<NormalGepPE>(edge)) {
+            e.offset = gep->getLocationSet().getOffset();
+            addLSPairs(lsPairs, gep->getLocationSet(), e.firstPair, e.numOfPairs);
+        }
+        llvm::DenseMap<const PAGEdge*, const Function*>::const_iterator fit = entryEdgeToFun.find(edge);
+        if (fit != entryEdgeToFun.end())
+            e.entryFun = getIndex(funToIndex, fit->second);
+        edges.push_back(e);
+    }
+
+    std::vector<PhiRecord> phis;
+    for (PAG::PHINodeMap::const_iterator it = pag->phiNodeMap.begin(), eit = pag->phiNodeMap.end(); it != eit; ++it) {
+        for (PAG::PNodeBBPairList::const_iterator pit = it->second.begin(), epit = it->second.end(); pit != epit; ++pit) {
+            PhiRecord p = {it->first->getId(), pit->first->getId(), getIndex(bbToIndex, pit->second)};
+            phis.push_back(p);
+        }
+    }
+
+    std::vector<PairRecord> funArgs, funRets, csArgs, csRets, indCSs;
+    for (PAG::FunToArgsListMap::const_iterator it = pag->funArgsListMap.begin(), eit = pag->funArgsListMap.end(); it != eit; ++it) {
+        for (PAG::PAGNodeList::const_iterator ait = it->second.begin(), eait = it->second.end(); ait != eait; ++ait) {
+            PairRecord r = {getIndex(funToIndex, it->first), (*ait)->getId()};
+            funArgs.push_back(r);
+        }
+    }
+    for (PAG::FunToRetMap::const_iterator it = pag->funRetMap.begin(), eit = pag->funRetMap.end(); it != eit; ++it) {
+        PairRecord r = {getIndex(funToIndex, it->first), it->second->getId()};
+        funRets.push_back(r);
+    }
+    for (PAG::CSToArgsListMap::const_iterator it = pag->callSiteArgsListMap.begin(), eit = pag->callSiteArgsListMap.end(); it != eit; ++it) {
+        for (PAG::PAGNodeList::const_iterator ait = it->second.begin(), eait = it->second.end(); ait != eait; ++ait) {
+            PairRecord r = {getIndex(instToIndex, it->first.getInstruction()), (*ait)->getId()};
+            csArgs.push_back(r);
+        }
+    }
+    for (PAG::CSToRetMap::const_iterator it = pag->callSiteRetMap.begin(), eit = pag->callSiteRetMap.end(); it != eit; ++it) {
+        PairRecord r = {getIndex(instToIndex, it->first.getInstruction()), it->second->getId()};
+        csRets.push_back(r);
+    }
+    for (PAG::CallSiteToFunPtrMap::const_iterator it = pag->indCallSiteToFunPtrMap.begin(), eit = pag->indCallSiteToFunPtrMap.end(); it != eit; ++it) {
+        PairRecord r = {getIndex(instToIndex, it->first.getInstruction()), it->second};
+        indCSs.push_back(r);
+    }
+
+    std::string options = PAG::getOptionKey();
+    padToRecords(options);
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SnapshotMagic, sizeof(SnapshotMagic));
+    header.version = SnapshotVersion;
+    memcpy(header.hash, hash.data(), sizeof(header.hash));
+    header.numOfSyms = numOfSyms;
+    header.numOfNodes = numOfNodes;
+    header.numOfFuns = funs.size();
+    header.numOfBBs = bbs.size();
+    header.numOfInsts = insts.size();
+    header.storeInstNum = pag->storeInstNum;
+    header.loadInstNum = pag->loadInstNum;
+    header.numOfNodeRecords = nodes.size();
+    header.numOfEdgeRecords = edges.size();
+    header.numOfPhis = phis.size();
+    header.numOfFunArgs = funArgs.size();
+    header.numOfFunRets = funRets.size();
+    header.numOfCSArgs = csArgs.size();
+    header.numOfCSRets = csRets.size();
+    header.numOfIndCSs = indCSs.size();
+    header.numOfLSPairs = lsPairs.size();
+    header.optionsLen = options.size();
+
+    /// other runs may have the snapshot mapped, it is replaced instead of being rewritten in place
+    SmallString<128> tempFile;
+    raw_fd_ostream* tempOS = createTempFile(file, tempFile);
+    if (tempOS == NULL)
+        return false;
+    raw_fd_ostream& os = *tempOS;
+    os.write((const char*)&header, sizeof(header));
+    os.write(options.data(), options.size());
+    writeRecords(os, nodes);
+    writeRecords(os, edges);
+    writeRecords(os, phis);
+    writeRecords(os, funArgs);
+    writeRecords(os, funRets);
+    writeRecords(os, csArgs);
+    writeRecords(os, csRets);
+    writeRecords(os, indCSs);
+    writeRecords(os, lsPairs);
+    return commitTempFile(tempOS, tempFile, file);
+}
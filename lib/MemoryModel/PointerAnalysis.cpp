@@ -16,6 +16,7 @@
 
 #include "MemoryModel/PointerAnalysis.h"
 #include "MemoryModel/PAGBuilder.h"
+#include "MemoryModel/PAGSnapshot.h"
 #include "Util/GraphUtil.h"
 #include "Util/AnalysisUtil.h"
 #include "Util/PTAStat.h"
@@ -51,6 +52,9 @@ static cl::opt<bool> PAGPrint("print-pag", cl::init(false),
 static cl::opt<std::string> Graphtxt("graphtxt", cl::value_desc("filename"),
                                      cl::desc("graph txt file to build PAG"));
 
+static cl::opt<std::string> PAGCacheDir("pag-cache", cl::value_desc("directory"),
+                                        cl::desc("Directory of binary PAG snapshots keyed by module hash"));
+
 static cl::opt<unsigned> IndirectCallLimit("indCallLimit",  cl::init(50000),
         cl::desc("Indirect solved call edge limit"));
 
@@ -66,6 +70,9 @@ static cl::opt<bool> EnableThreadCallGraph("enable-tcg", cl::init(true),
 static cl::opt<bool> INCDFPTData("incdata", cl::init(true),
                                  cl::desc("Enable incremental DFPTData for flow-sensitive analysis"));
 
+static cl::opt<bool> PersistentPTS("persistent-pts", cl::init(false),
+                                   cl::desc("Share equal points-to sets among pointers in Andersen analysis"));
+
 PAG* PointerAnalysis::pag = NULL;
 llvm::Module* PointerAnalysis::mod = NULL;
 
@@ -102,6 +109,14 @@ void PointerAnalysis::destroy()
 }
 
 
+std::string PointerAnalysis::getOptionKey() {
+    std::string key;
+    raw_string_ostream os(key);
+    os << "preFieldSensitive=" << UsePreCompFieldSensitive << " indCallLimit=" << IndirectCallLimit
+       << " enable-tcg=" << EnableThreadCallGraph << " " << PAG::getOptionKey();
+    return os.str();
+}
+
 /*!
  * Initialization of pointer analysis
  */
@@ -118,6 +133,17 @@ void PointerAnalysis::initialize(Module& module) {
             PAGBuilderFromFile fileBuilder(Graphtxt.getValue());
             pag = fileBuilder.build();
 
+        } else if (!PAGCacheDir.getValue().empty()) {
+            PAGSnapshot snapshot(PAGCacheDir.getValue(), module);
+            pag = snapshot.read();
+            if (pag == NULL) {
+                PAGBuilder builder;
+                pag = builder.build(module);
+                snapshot.write(pag);
+            }
+            else
+                DBOUT(DGENERAL, outs() << pasMsg("PAG restored from " + snapshot.getFileName() + "\n"));
+
         } else {
             PAGBuilder builder;
             pag = builder.build(module);
@@ -139,6 +165,7 @@ void PointerAnalysis::initialize(Module& module) {
         ptaCallGraph = new ThreadCallGraph(mod);
     else
         ptaCallGraph = new PTACallGraph(mod);
+    csToResolvedPtsMap.clear();
     callGraphSCCDetection();
 }
 
@@ -257,8 +284,15 @@ void PointerAnalysis::dumpAllTypes()
 /*!
  * Constructor
  */
-BVDataPTAImpl::BVDataPTAImpl(PointerAnalysis::PTATY type) : PointerAnalysis(type) {
+BVDataPTAImpl::BVDataPTAImpl(PointerAnalysis::PTATY type) : PointerAnalysis(type), aliasCacheEnabled(false) {
     if(type == Andersen_WPA || type == AndersenWave_WPA || type == AndersenLCD_WPA) {
+        if(PersistentPTS)
+            ptD = new PersistentPTDataTy();
+        else
+            ptD = new PTDataTy();
+    }
+    else if (type == AndersenParallel_WPA) {
+        /// worker threads update points-to sets in place, which can not be shared
         ptD = new PTDataTy();
     }
     else if (type == AndersenWaveDiff_WPA) {
@@ -289,6 +323,27 @@ void BVDataPTAImpl::expandFIObjs(const PointsTo& pts, PointsTo& expandedPts) {
     }
 }
 
+/*!
+ * Field-expanded points-to set of a rep node
+ * The unordered map keeps its elements in place, so the returned set stays valid while other sets are added
+ */
+const PointsTo& BVDataPTAImpl::getExpandedPts(NodeID rep) {
+    NodeToPtsMap::iterator it = expandedPtsMap.find(rep);
+    if (it != expandedPtsMap.end())
+        return it->second;
+    PointsTo& expandedPts = expandedPtsMap[rep];
+    expandFIObjs(getConstPts(rep), expandedPts);
+    return expandedPts;
+}
+
+/*!
+ * Finalize analysis
+ */
+void BVDataPTAImpl::finalize() {
+    enableAliasCache();
+    PointerAnalysis::finalize();
+}
+
 /*!
  * Dump points-to of each pag node
  */
@@ -297,7 +352,7 @@ void BVDataPTAImpl::dumpTopLevelPtsTo() {
             nIter != this->getAllValidPtrs().end(); ++nIter) {
         const PAGNode* node = getPAG()->getPAGNode(*nIter);
         if (getPAG()->isValidTopLevelPtr(node)) {
-            PointsTo& pts = this->getPts(node->getId());
+            const PointsTo& pts = this->getConstPts(node->getId());
             outs() << "\nNodeID " << node->getId() << " ";
 
             if (pts.empty()) {
@@ -365,7 +420,7 @@ void PointerAnalysis::dumpPts(NodeID ptr, const PointsTo& pts) {
 void BVDataPTAImpl::dumpAllPts() {
     for(PAG::iterator it = pag->begin(), eit = pag->end(); it!=eit; it++) {
         outs() << "----------------------------------------------\n";
-        dumpPts(it->first, this->getPts(it->first));
+        dumpPts(it->first, this->getConstPts(it->first));
         outs() << "----------------------------------------------\n";
     }
 }
@@ -430,10 +485,20 @@ void PointerAnalysis::printIndCSTargets()
  * On the fly call graph construction
  * callsites is candidate indirect callsites need to be analyzed based on points-to results
  * newEdges is the new indirect call edges discovered
+ * A callsite is skipped if the points-to set of its function pointer has not grown since
+ * it was last resolved, otherwise only the newly added targets are resolved.
  */
 void BVDataPTAImpl::onTheFlyCallGraphSolve(const CallSiteToFunPtrMap& callsites, CallEdgeMap& newEdges,CallGraph* callgraph) {
     for(CallSiteToFunPtrMap::const_iterator iter = callsites.begin(), eiter = callsites.end(); iter!=eiter; ++iter) {
-        resolveIndCalls(iter->first,getPts(iter->second),newEdges,callgraph);
+        const PointsTo& pts = getConstPts(iter->second);
+        PointsTo& resolved = csToResolvedPtsMap[iter->first];
+        if(resolved.contains(pts))
+            continue;
+
+        PointsTo newTargets = pts;
+        newTargets.intersectWithComplement(resolved);
+        resolved |= newTargets;
+        resolveIndCalls(iter->first,newTargets,newEdges,callgraph);
     }
 }
 
@@ -478,6 +543,16 @@ void PointerAnalysis::resolveIndCalls(CallSite cs, const PointsTo& target, CallE
     }
 }
 
+/*!
+ * Answer a batch of alias queries
+ */
+void PointerAnalysis::alias(const AliasQueryList& queries, AliasResultList& results) {
+    results.clear();
+    results.reserve(queries.size());
+    for (AliasQueryList::const_iterator it = queries.begin(), eit = queries.end(); it != eit; ++it)
+        results.push_back(alias(it->first, it->second));
+}
+
 /*!
  * Find the alias check functions annotated in the C files
  * check whether the alias analysis results consistent with the alias check function itself
@@ -608,8 +683,24 @@ llvm::AliasResult BVDataPTAImpl::alias(const Value* V1,
  */
 llvm::AliasResult BVDataPTAImpl::alias(NodeID node1, NodeID node2) {
 
-    PointsTo& p1 = getPts(node1);
-    PointsTo& p2 = getPts(node2);
+    if (aliasCacheEnabled) {
+        NodeID rep1 = getPtsRepNode(node1);
+        NodeID rep2 = getPtsRepNode(node2);
+        const PointsTo& pts1 = getExpandedPts(rep1);
+        /// Pointers of the same rep have the same points-to set. They are MustAlias candidates,
+        /// but MayAlias is returned as they may still point to different objects of that set.
+        if (rep1 == rep2)
+            return pts1.empty() ? NoAlias : MayAlias;
+
+        const PointsTo& pts2 = getExpandedPts(rep2);
+        if (pts1.test(pag->getBlackHoleNode()) || pts2.test(pag->getBlackHoleNode()) || pts1.intersects(pts2))
+            return MayAlias;
+        else
+            return NoAlias;
+    }
+
+    const PointsTo& p1 = getConstPts(node1);
+    const PointsTo& p2 = getConstPts(node2);
     PointsTo pts1;
     expandFIObjs(p1,pts1);
     PointsTo pts2;
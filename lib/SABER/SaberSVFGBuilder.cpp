@@ -65,7 +65,7 @@ void SaberSVFGBuilder::collectGlobals(BVDataPTAImpl* pta) {
         NodeID id = worklist.back();
         worklist.pop_back();
         globs.set(id);
-        PointsTo& pts = pta->getPts(id);
+        const PointsTo& pts = pta->getConstPts(id);
         for(PointsTo::iterator it = pts.begin(), eit = pts.end(); it!=eit; ++it) {
             globs |= CollectPtsChain(pta,*it,cachedPtsMap);
         }
@@ -89,7 +89,7 @@ NodeBS& SaberSVFGBuilder::CollectPtsChain(BVDataPTAImpl* pta,NodeID id, NodeToPT
 
         while(!worklist.empty()) {
             NodeID nodeId = worklist.pop();
-            PointsTo& tmp = pta->getPts(nodeId);
+            const PointsTo& tmp = pta->getConstPts(nodeId);
             for(PointsTo::iterator it = tmp.begin(), eit = tmp.end(); it!=eit; ++it) {
                 pts |= CollectPtsChain(pta,*it,cachedPtsMap);
             }
@@ -105,7 +105,7 @@ NodeBS& SaberSVFGBuilder::CollectPtsChain(BVDataPTAImpl* pta,NodeID id, NodeToPT
 bool SaberSVFGBuilder::accessGlobal(BVDataPTAImpl* pta,const PAGNode* pagNode) {
 
     NodeID id = pagNode->getId();
-    PointsTo pts = pta->getPts(id);
+    PointsTo pts = pta->getConstPts(id);
     pts.set(id);
 
     return pts.intersects(globs);
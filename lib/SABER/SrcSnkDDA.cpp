@@ -18,6 +18,9 @@
 #include "SABER/SrcSnkDDA.h"
 #include "MSSA/SVFGStat.h"
 #include "Util/GraphUtil.h"
+#include "Util/Profiler.h"
+
+#include <thread>
 
 using namespace llvm;
 
@@ -27,49 +30,182 @@ static cl::opt<bool> DumpSlice("dump-slice", cl::init(false),
 static cl::opt<unsigned> cxtLimit("cxtlimit",  cl::init(3),
                                   cl::desc("Source-Sink Analysis Contexts Limit"));
 
+static cl::opt<unsigned> SaberThreads("saber-threads", cl::init(1),
+                                      cl::desc("Number of threads analysing slices of sources (0: hardware concurrency)"));
+
+/// Number of sources each thread analyses before the bugs found are reported
+static const u32_t SliceBatchSize = 16;
+
+thread_local SrcSnkDDA::SliceState* SrcSnkDDA::curState = NULL;
+
 void SrcSnkDDA::analyze(llvm::Module& module) {
 
+    ProfileScope prof("Saber");
+
     initialize(module);
 
-    ContextCond::setMaxCxtLen(cxtLimit);
+    mainState.callStrs.setMaxCxtLen(cxtLimit);
+
+    u32_t numOfThreads = SaberThreads;
+    if (numOfThreads == 0)
+        numOfThreads = std::thread::hardware_concurrency();
+    /// slices are annotated on the shared SVFG stat when dumped
+    if (DumpSlice)
+        numOfThreads = 1;
+
+    if (numOfThreads > 1) {
+        analyzeInParallel(module, numOfThreads);
+    }
+    else {
+        curState = &mainState;
+        for (SVFGNodeSetIter iter = sourcesBegin(), eiter = sourcesEnd();
+                iter != eiter; ++iter) {
+            setCurSlice(*iter);
+            analyzeSlice(*iter);
+            reportBug(getCurSlice());
+        }
+    }
+
+    finalize();
+}
+
+/*!
+ * Forward and backward analysis of the slice of a source, and guard computation of the slice
+ */
+void SrcSnkDDA::analyzeSlice(const SVFGNode* src) {
 
-    for (SVFGNodeSetIter iter = sourcesBegin(), eiter = sourcesEnd();
-            iter != eiter; ++iter) {
-        setCurSlice(*iter);
+    ProfileScope prof("slice");
+    Profiler::addCount("saber.slices");
 
-        DBOUT(DGENERAL, outs() << "Analysing slice:" << (*iter)->getId() << ")\n");
-        ContextCond cxt;
-        DPIm item((*iter)->getId(),cxt);
-        forwardTraverse(item);
+    DBOUT(DGENERAL, outs() << "Analysing slice:" << src->getId() << ")\n");
+    DPIm item(src->getId());
+    forwardTraverse(item);
 
-        /// do not consider there is bug when reaching a global SVFGNode
-        /// if we touch a global, then we assume the client uses this memory until the program exits.
-        if (getCurSlice()->isReachGlobal()) {
-            DBOUT(DSaber, outs() << "Forward analysis reaches globals for slice:" << (*iter)->getId() << ")\n");
+    /// do not consider there is bug when reaching a global SVFGNode
+    /// if we touch a global, then we assume the client uses this memory until the program exits.
+    if (getCurSlice()->isReachGlobal()) {
+        DBOUT(DSaber, outs() << "Forward analysis reaches globals for slice:" << src->getId() << ")\n");
+    }
+    else {
+        DBOUT(DSaber, outs() << "Forward process for slice:" << src->getId() << " (size = " << getCurSlice()->getForwardSliceSize() << ")\n");
+
+        for (SVFGNodeSetIter sit = getCurSlice()->sinksBegin(), esit =
+                    getCurSlice()->sinksEnd(); sit != esit; ++sit) {
+            DPIm item((*sit)->getId());
+            backwardTraverse(item);
         }
-        else {
-            DBOUT(DSaber, outs() << "Forward process for slice:" << (*iter)->getId() << " (size = " << getCurSlice()->getForwardSliceSize() << ")\n");
 
-            for (SVFGNodeSetIter sit = getCurSlice()->sinksBegin(), esit =
-                        getCurSlice()->sinksEnd(); sit != esit; ++sit) {
-                ContextCond cxt;
-                DPIm item((*sit)->getId(),cxt);
-                backwardTraverse(item);
-            }
+        DBOUT(DSaber, outs() << "Backward process for slice:" << src->getId() << " (size = " << getCurSlice()->getBackwardSliceSize() << ")\n");
 
-            DBOUT(DSaber, outs() << "Backward process for slice:" << (*iter)->getId() << " (size = " << getCurSlice()->getBackwardSliceSize() << ")\n");
+        AllPathReachability();
 
-            AllPathReachability();
+        DBOUT(DSaber, outs() << "Guard computation for slice:" << src->getId() << ")\n");
+    }
+}
 
-            DBOUT(DSaber, outs() << "Guard computation for slice:" << (*iter)->getId() << ")\n");
+/*!
+ * Analyse the sources in batches. The slices of a batch are analysed by the threads, each of
+ * which computes guards with its own path condition allocator. Afterwards the bugs of the batch
+ * are reported by this thread in the order of sources, so that the reports (and the program
+ * annotations) are the same as the sequential analysis.
+ */
+void SrcSnkDDA::analyzeInParallel(llvm::Module& module, u32_t numOfThreads) {
+
+    SVFGNodeList srcs(sourcesBegin(), sourcesEnd());
+    ProgSliceList slices(srcs.size(), NULL);
+
+    std::vector<SliceState*> states;
+    for (u32_t i = 0; i < numOfThreads; i++) {
+        PathCondAllocator* pa = new PathCondAllocator(true);
+        pa->allocate(module);
+        states.push_back(new SliceState(pa));
+        states.back()->callStrs.setMaxCxtLen(cxtLimit);
+    }
+
+    u32_t batchSize = numOfThreads * SliceBatchSize;
+    for (u32_t start = 0; start < srcs.size(); start += batchSize) {
+        u32_t end = std::min(start + batchSize, (u32_t)srcs.size());
+        std::atomic<u32_t> next(start);
+
+        std::vector<std::thread> threads;
+        for (u32_t i = 0; i < numOfThreads; i++)
+            threads.push_back(std::thread(&SrcSnkDDA::runSliceWorker, this, std::cref(srcs), std::ref(slices), states[i], end, std::ref(next)));
+        for (u32_t i = 0; i < numOfThreads; i++)
+            threads[i].join();
+
+        curState = &mainState;
+        for (u32_t i = start; i < end; i++) {
+            mainState.slice = slices[i];
+            reportBug(slices[i]);
+            delete slices[i];
+            slices[i] = NULL;
         }
+        mainState.slice = NULL;
+    }
 
-        reportBug(getCurSlice());
+    for (u32_t i = 0; i < numOfThreads; i++) {
+        PathCondAllocator* pa = states[i]->pathAllocator;
+        workerBDDMemUsage += pa->getCondMgrMemUsage();
+        workerBDDNum += pa->getCondMgrCondNum();
+        workerBDDMaxLiveNum += pa->getCondMgrMaxLiveCondNumber();
+        delete pa;
+        delete states[i];
     }
+}
 
-    finalize();
+/*!
+ * Take sources before end one at a time and keep their slices for bug reporting
+ */
+void SrcSnkDDA::runSliceWorker(const SVFGNodeList& srcs, ProgSliceList& slices, SliceState* state,
+                               u32_t end, std::atomic<u32_t>& next) {
+    curState = state;
+    for (u32_t i = next++; i < end; i = next++) {
+        state->slice = NULL;
+        setCurSlice(srcs[i]);
+        analyzeSlice(srcs[i]);
+        slices[i] = state->slice;
+    }
+    state->slice = NULL;
+    curState = NULL;
 }
 
+/*!
+ * CFL forward traverse solve, on the worklist of the current thread
+ */
+void SrcSnkDDA::forwardTraverse(DPIm& it) {
+    pushIntoWorklist(it);
+
+    while (!isWorklistEmpty()) {
+        DPIm item = popFromWorklist();
+        forwardProcess(item);
+
+        GNODE* v = getNode(getNodeIDFromItem(item));
+        child_iterator EI = GTraits::child_begin(v);
+        child_iterator EE = GTraits::child_end(v);
+        for (; EI != EE; ++EI) {
+            forwardpropagate(item,*(EI.getCurrent()) );
+        }
+    }
+}
+
+/*!
+ * CFL backward traverse solve, on the worklist of the current thread
+ */
+void SrcSnkDDA::backwardTraverse(DPIm& it) {
+    pushIntoWorklist(it);
+
+    while (!isWorklistEmpty()) {
+        DPIm item = popFromWorklist();
+        backwardProcess(item);
+
+        GNODE* v = getNode(getNodeIDFromItem(item));
+        inv_child_iterator EI = InvGTraits::child_begin(v);
+        inv_child_iterator EE = InvGTraits::child_end(v);
+        for (; EI != EE; ++EI) {
+            backwardpropagate(item,*(EI.getCurrent()) );
+        }
+    }
+}
 
 /*!
  * Propagate information forward by matching context
@@ -99,7 +235,7 @@ void SrcSnkDDA::forwardpropagate(const DPIm& item, SVFGEdge* edge) {
         else
             csId = cast<CallIndSVFGEdge>(edge)->getCallSiteId();
 
-        newItem.pushContext(csId);
+        newItem.pushContext(getSliceState()->callStrs, csId);
         DBOUT(DSaber, outs() << " push cxt [" << csId << "] ");
     }
     // match context for return
@@ -110,7 +246,7 @@ void SrcSnkDDA::forwardpropagate(const DPIm& item, SVFGEdge* edge) {
         else
             csId = cast<RetIndSVFGEdge>(edge)->getCallSiteId();
 
-        if (newItem.matchContext(csId) == false) {
+        if (newItem.matchContext(getSliceState()->callStrs, csId) == false) {
             DBOUT(DSaber, outs() << "-|-\n");
             return;
         }
@@ -126,7 +262,7 @@ void SrcSnkDDA::forwardpropagate(const DPIm& item, SVFGEdge* edge) {
         addForwardVisited(dstNode, newItem);
 
     if(pushIntoWorklist(newItem))
-        DBOUT(DSaber,outs() << " --> " << edge->getDstID() << ", cxt size: " << newItem.getContexts().cxtSize() <<")\n");
+        DBOUT(DSaber,outs() << " --> " << edge->getDstID() << ", cxt size: " << getSliceState()->callStrs.getCxtSize(newItem.getContexts()) <<")\n");
 
 }
 
@@ -141,32 +277,33 @@ void SrcSnkDDA::backwardpropagate(const DPIm& item, SVFGEdge* edge) {
     else
         addBackwardVisited(srcNode);
 
-    ContextCond cxt;
-    DPIm newItem(srcNode->getId(), cxt);
+    DPIm newItem(srcNode->getId());
     pushIntoWorklist(newItem);
 }
 
 /// Guarded reachability search
 void SrcSnkDDA::AllPathReachability() {
+    ProgSlice* slice = getCurSlice();
     /// annotate SVFG with slice information for debugging purpose
     if(DumpSlice)
-        annotateSlice(_curSlice);
+        annotateSlice(slice);
 
-    _curSlice->AllPathReachableSolve();
+    slice->AllPathReachableSolve();
 
-    if(isSatisfiableForAll(_curSlice)== true)
-        _curSlice->setAllReachable();
+    if(isSatisfiableForAll(slice)== true)
+        slice->setAllReachable();
 }
 
 /// Set current slice
 void SrcSnkDDA::setCurSlice(const SVFGNode* src) {
-    if(_curSlice!=NULL) {
-        delete _curSlice;
-        _curSlice = NULL;
-        clearVisitedMap();
+    SliceState* state = getSliceState();
+    if(state->slice!=NULL) {
+        delete state->slice;
+        state->slice = NULL;
     }
+    clearVisitedMap();
 
-    _curSlice = new ProgSlice(src,getPathAllocator(), getSVFG());
+    state->slice = new ProgSlice(src, state->pathAllocator, getSVFG());
 }
 
 void SrcSnkDDA::annotateSlice(ProgSlice* slice) {
@@ -187,7 +324,8 @@ void SrcSnkDDA::dumpSlices() {
 
 void SrcSnkDDA::printBDDStat() {
 
-    outs() << "BDD Mem usage: " << PathCondAllocator::getMemUsage() << "\n";
-    outs() << "BDD Number: " << PathCondAllocator::getCondNum() << "\n";
-    outs() << "BDD max live number: " << PathCondAllocator::getMaxLiveCondNumber() << "\n";
+    /// the worker managers are summed into the global one, the max live number is the sum of their peaks
+    outs() << "BDD Mem usage: " << PathCondAllocator::getMemUsage() + workerBDDMemUsage << "\n";
+    outs() << "BDD Number: " << PathCondAllocator::getCondNum() + workerBDDNum << "\n";
+    outs() << "BDD max live number: " << PathCondAllocator::getMaxLiveCondNumber() + workerBDDMaxLiveNum << "\n";
 }
@@ -27,6 +27,8 @@
 #include <llvm/IR/InstIterator.h>	// for inst iteration
 #include <llvm/Analysis/CFG.h>	// for CFG
 #include <llvm/IR/CFG.h>		// for CFG
+#include <llvm/Support/MD5.h>	// for module hash
+#include <llvm/Support/FileSystem.h>	// for temporary files
 #include "Util/Conditions.h"
 #include <sys/resource.h>		/// increase stack size
 
@@ -374,7 +376,7 @@ std::string analysisUtil::pasMsg(std::string msg) {
 /*!
  * Dump points-to set
  */
-void analysisUtil::dumpPointsToSet(unsigned node, llvm::SparseBitVector<> bs) {
+void analysisUtil::dumpPointsToSet(unsigned node, PointsTo bs) {
     outs() << "node " << node << " points-to: {";
     dumpSet(bs);
     outs() << "}\n";
@@ -384,7 +386,7 @@ void analysisUtil::dumpPointsToSet(unsigned node, llvm::SparseBitVector<> bs) {
 /*!
  * Dump alias set
  */
-void analysisUtil::dumpAliasSet(unsigned node, llvm::SparseBitVector<> bs) {
+void analysisUtil::dumpAliasSet(unsigned node, PointsTo bs) {
     outs() << "node " << node << " alias set: {";
     dumpSet(bs);
     outs() << "}\n";
@@ -393,8 +395,8 @@ void analysisUtil::dumpAliasSet(unsigned node, llvm::SparseBitVector<> bs) {
 /*!
  * Dump bit vector set
  */
-void analysisUtil::dumpSet(llvm::SparseBitVector<> bs, llvm::raw_ostream & O) {
-    for (llvm::SparseBitVector<>::iterator ii = bs.begin(), ie = bs.end();
+void analysisUtil::dumpSet(PointsTo bs, llvm::raw_ostream & O) {
+    for (PointsTo::iterator ii = bs.begin(), ie = bs.end();
             ii != ie; ii++) {
         O << " " << *ii << " ";
     }
@@ -471,3 +473,60 @@ void analysisUtil::increaseStackSize()
         }
     }
 }
+
+/*!
+ * Hash the printed IR of a module
+ */
+std::string analysisUtil::getModuleHash(const llvm::Module& module) {
+    std::string ir;
+    raw_string_ostream irOS(ir);
+    module.print(irOS, NULL);
+
+    MD5 hasher;
+    hasher.update(irOS.str());
+    MD5::MD5Result result;
+    hasher.final(result);
+
+    static const char hexDigits[] = "0123456789abcdef";
+    std::string hash;
+    for (unsigned i = 0; i < sizeof(result); i++) {
+        hash.push_back(hexDigits[result[i] >> 4]);
+        hash.push_back(hexDigits[result[i] & 0xf]);
+    }
+    return hash;
+}
+
+/*!
+ * Create a temporary file in the directory of file
+ */
+raw_fd_ostream* analysisUtil::createTempFile(const std::string& file, SmallVectorImpl<char>& tempFile) {
+    int fd;
+    std::error_code errInfo = sys::fs::createUniqueFile(file + "-%%%%%%%%.tmp", fd, tempFile);
+    if (errInfo) {
+        errs() << errMsg("can not create temporary file for " + file + ": " + errInfo.message()) << "\n";
+        return NULL;
+    }
+    return new raw_fd_ostream(fd, true);
+}
+
+/*!
+ * Replace file by the temporary file written through os
+ */
+bool analysisUtil::commitTempFile(raw_fd_ostream* os, const SmallVectorImpl<char>& tempFile, const std::string& file) {
+    std::string temp(tempFile.begin(), tempFile.end());
+    os->close();
+    bool failed = os->has_error();
+    /// an unhandled write error is fatal when the stream is destroyed
+    os->clear_error();
+    delete os;
+
+    std::error_code errInfo;
+    if (!failed)
+        errInfo = sys::fs::rename(temp, file);
+    if (failed || errInfo) {
+        sys::fs::remove(temp);
+        errs() << errMsg("can not write " + file) << "\n";
+        return false;
+    }
+    return true;
+}
@@ -114,7 +114,7 @@ PTACallGraphEdge* PTACallGraph::hasGraphEdge(PTACallGraphNode* src, PTACallGraph
  * get CallGraph edge via nodes
  */
 PTACallGraphEdge* PTACallGraph::getGraphEdge(PTACallGraphNode* src, PTACallGraphNode* dst,PTACallGraphEdge::CEDGEK kind) {
-    for (PTACallGraphEdge::CallGraphEdgeSet::iterator iter = src->OutEdgeBegin();
+    for (PTACallGraphNode::iterator iter = src->OutEdgeBegin();
             iter != src->OutEdgeEnd(); ++iter) {
         PTACallGraphEdge* edge = (*iter);
         if (edge->getEdgeKind() == kind && edge->getDstID() == dst->getId())
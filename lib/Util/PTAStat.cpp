@@ -17,6 +17,7 @@
 #include <iomanip>
 #include "Util/PTACallGraph.h"
 #include "Util/PTAStat.h"
+#include "Util/Profiler.h"
 #include "MemoryModel/PointerAnalysis.h"
 #include "MemoryModel/PAG.h"
 
@@ -230,14 +231,14 @@ void PTAStat::callgraphStat() {
     PTNumStatMap["CalRetPairInCycle"] = edgeInCycle;
 
     std::cout << "\n****CallGraph SCC Stat****\n";
-    PTAStat::printStat();
+    PTAStat::printStat("CallGraphSCC");
 
     PTNumStatMap.clear();
 
     delete callgraphSCC;
 }
 
-void PTAStat::printStat() {
+void PTAStat::printStat(std::string statname) {
 
     StringRef fullName(SymbolTableInfo::Symbolnfo()->getModule()->getModuleIdentifier());
     StringRef name = fullName.split('/').second;
@@ -248,15 +249,18 @@ void PTAStat::printStat() {
     for(NUMStatMap::iterator it = generalNumMap.begin(), eit = generalNumMap.end(); it!=eit; ++it) {
         // format out put with width 20 space
         std::cout << std::setw(field_width) << it->first << it->second << "\n";
+        Profiler::setStat(statname, it->first, it->second);
     }
     std::cout << "-------------------------------------------------------\n";
     for(TIMEStatMap::iterator it = timeStatMap.begin(), eit = timeStatMap.end(); it!=eit; ++it) {
         // format out put with width 20 space
         std::cout << std::setw(field_width) << it->first << it->second << "\n";
+        Profiler::setStat(statname, it->first, it->second);
     }
     for(NUMStatMap::iterator it = PTNumStatMap.begin(), eit = PTNumStatMap.end(); it!=eit; ++it) {
         // format out put with width 20 space
         std::cout << std::setw(field_width) << it->first << it->second << "\n";
+        Profiler::setStat(statname, it->first, it->second);
     }
 
     std::cout << "#######################################################" << std::endl;
@@ -30,7 +30,7 @@ using namespace analysisUtil;
 
 u64_t DPItem::maximumBudget = ULONG_MAX - 1;
 u32_t ContextCond::maximumCxtLen = 0;
-u32_t ContextCond::maximumCxt = 0;
+std::atomic<u32_t> ContextCond::maximumCxt(0);
 u32_t VFPathCond::maximumPathLen = 0;
 u32_t VFPathCond::maximumPath = 0;
 
@@ -358,7 +358,7 @@ PathCondAllocator::Condition* PathCondAllocator::getPHIComplementCond(const Basi
         return condNeg(cond);
     }
 
-    return trueCond();
+    return getTrueCond();
 }
 
 /*!
@@ -446,8 +446,13 @@ PathCondAllocator::Condition* PathCondAllocator::ComputeIntraVFGGuard(const llvm
  * Release memory
  */
 void PathCondAllocator::destroy() {
-    delete bddCondMgr;
-    bddCondMgr = NULL;
+    if (ownsCondMgr)
+        delete condMgr;
+    else {
+        delete bddCondMgr;
+        bddCondMgr = NULL;
+    }
+    condMgr = NULL;
 }
 
 /*!
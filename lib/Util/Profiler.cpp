@@ -0,0 +1,235 @@
+//===- Profiler.cpp -- Wall-clock phase and counter profiling----------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * Profiler.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "Util/Profiler.h"
+#include "Util/AnalysisUtil.h"
+#include <llvm/Support/CommandLine.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+
+using namespace llvm;
+
+bool Profiler::enabled = false;
+
+static cl::opt<bool, true> Profile("profile", cl::location(Profiler::enabled),
+                                   cl::desc("Profile the wall-clock time of analysis phases and per-thread counters"));
+
+static cl::opt<std::string> ProfileJson("profile-json", cl::init(""),
+                                        cl::desc("Write the profile and the statistics as JSON to this file"));
+
+namespace {
+
+/*!
+ * A phase of a thread, its children are keyed by the address of their names
+ */
+struct PhaseNode {
+    typedef std::map<const char*, PhaseNode*> ChildMap;
+
+    PhaseNode(const char* n, PhaseNode* p) : name(n), parent(p), calls(0), wallMs(0) {}
+    ~PhaseNode() {
+        for (ChildMap::iterator it = children.begin(), eit = children.end(); it != eit; ++it)
+            delete it->second;
+    }
+
+    const char* name;
+    PhaseNode* parent;
+    ChildMap children;
+    Profiler::Count calls;
+    double wallMs;
+};
+
+/*!
+ * Phases and counters of one thread, only written by that thread
+ */
+struct ThreadProfile {
+    typedef std::map<const char*, Profiler::Count> CounterMap;
+
+    ThreadProfile(u32_t i) : id(i), root("", NULL), cur(&root) {}
+
+    u32_t id;
+    PhaseNode root;
+    PhaseNode* cur;
+    CounterMap counters;
+};
+
+/// Phases merged over threads by path
+struct PhaseSummary {
+    PhaseSummary() : calls(0), wallMs(0), threads(0), lastThread(~0U) {}
+    Profiler::Count calls;
+    double wallMs;
+    u32_t threads;
+    u32_t lastThread;
+};
+
+typedef std::map<std::string, PhaseSummary> PhaseSummaryMap;
+typedef std::map<std::string, std::vector<Profiler::Count> > CounterSummaryMap;
+typedef std::map<std::string, std::map<std::string, double> > StatGroupMap;
+
+/// Profiles of all threads that have been profiled, kept after the threads exit
+std::mutex profilesMutex;
+std::vector<ThreadProfile*> profiles;
+StatGroupMap stats;
+
+thread_local ThreadProfile* localProfile = NULL;
+
+ThreadProfile* getLocalProfile() {
+    if (localProfile == NULL) {
+        std::lock_guard<std::mutex> lock(profilesMutex);
+        localProfile = new ThreadProfile(profiles.size());
+        profiles.push_back(localProfile);
+    }
+    return localProfile;
+}
+
+/// Names are keyed by address, so one thread may have several children of the same path
+void summarizePhases(u32_t tid, const PhaseNode* node, const std::string& path, PhaseSummaryMap& summaries) {
+    for (PhaseNode::ChildMap::const_iterator it = node->children.begin(), eit = node->children.end(); it != eit; ++it) {
+        const PhaseNode* child = it->second;
+        std::string childPath = path.empty() ? child->name : path + "/" + child->name;
+        PhaseSummary& summary = summaries[childPath];
+        summary.calls += child->calls;
+        summary.wallMs += child->wallMs;
+        if (summary.lastThread != tid) {
+            summary.lastThread = tid;
+            summary.threads++;
+        }
+        summarizePhases(tid, child, childPath, summaries);
+    }
+}
+
+void writeJsonString(std::ostream& os, const std::string& str) {
+    os << '"';
+    for (std::string::const_iterator it = str.begin(), eit = str.end(); it != eit; ++it) {
+        if (*it == '"' || *it == '\\')
+            os << '\\';
+        os << *it;
+    }
+    os << '"';
+}
+
+void writeJson(std::ostream& os, const PhaseSummaryMap& phases, const CounterSummaryMap& counters) {
+    os << "{\n  \"threads\": " << profiles.size() << ",\n  \"phases\": [";
+    for (PhaseSummaryMap::const_iterator it = phases.begin(), eit = phases.end(); it != eit; ++it) {
+        os << (it == phases.begin() ? "\n" : ",\n") << "    {\"path\": ";
+        writeJsonString(os, it->first);
+        os << ", \"calls\": " << it->second.calls << ", \"wall_ms\": " << it->second.wallMs
+           << ", \"threads\": " << it->second.threads << "}";
+    }
+    os << "\n  ],\n  \"counters\": {";
+    for (CounterSummaryMap::const_iterator it = counters.begin(), eit = counters.end(); it != eit; ++it) {
+        Profiler::Count total = 0;
+        for (u32_t i = 0; i < it->second.size(); i++)
+            total += it->second[i];
+        os << (it == counters.begin() ? "\n    " : ",\n    ");
+        writeJsonString(os, it->first);
+        os << ": {\"total\": " << total << ", \"threads\": [";
+        for (u32_t i = 0; i < it->second.size(); i++)
+            os << (i ? ", " : "") << it->second[i];
+        os << "]}";
+    }
+    os << "\n  },\n  \"stats\": {";
+    for (StatGroupMap::const_iterator git = stats.begin(), geit = stats.end(); git != geit; ++git) {
+        os << (git == stats.begin() ? "\n    " : ",\n    ");
+        writeJsonString(os, git->first);
+        os << ": {";
+        for (std::map<std::string, double>::const_iterator it = git->second.begin(), eit = git->second.end(); it != eit; ++it) {
+            os << (it == git->second.begin() ? "\n      " : ",\n      ");
+            writeJsonString(os, it->first);
+            os << ": " << it->second;
+        }
+        os << "\n    }";
+    }
+    os << "\n  }\n}\n";
+}
+
+}
+
+/*!
+ * Open a phase nested in the current phase of this thread
+ */
+void Profiler::beginPhase(const char* name) {
+    ThreadProfile* profile = getLocalProfile();
+    PhaseNode*& child = profile->cur->children[name];
+    if (child == NULL)
+        child = new PhaseNode(name, profile->cur);
+    profile->cur = child;
+}
+
+/*!
+ * Close the current phase of this thread
+ */
+void Profiler::endPhase(double elapsed) {
+    ThreadProfile* profile = getLocalProfile();
+    PhaseNode* phase = profile->cur;
+    assert(phase->parent && "no phase to end");
+    phase->calls++;
+    phase->wallMs += elapsed;
+    profile->cur = phase->parent;
+}
+
+void Profiler::addThreadCount(const char* name, Count n) {
+    getLocalProfile()->counters[name] += n;
+}
+
+void Profiler::setStat(const std::string& group, const std::string& name, double value) {
+    if (!enabled)
+        return;
+    std::lock_guard<std::mutex> lock(profilesMutex);
+    stats[group][name] = value;
+}
+
+/*!
+ * Merge the threads by phase path and counter name, call it once the worker threads have joined
+ */
+void Profiler::report() {
+    if (!enabled)
+        return;
+
+    std::lock_guard<std::mutex> lock(profilesMutex);
+
+    PhaseSummaryMap phases;
+    CounterSummaryMap counters;
+    for (u32_t i = 0; i < profiles.size(); i++) {
+        const ThreadProfile* profile = profiles[i];
+        summarizePhases(profile->id, &profile->root, "", phases);
+        for (ThreadProfile::CounterMap::const_iterator it = profile->counters.begin(), eit = profile->counters.end(); it != eit; ++it) {
+            std::vector<Count>& perThread = counters[it->first];
+            perThread.resize(profiles.size(), 0);
+            perThread[profile->id] += it->second;
+        }
+    }
+
+    std::cout << "\n****Profile (wall clock, " << profiles.size() << " threads)****\n";
+    std::cout.flags(std::ios::left);
+    for (PhaseSummaryMap::const_iterator it = phases.begin(), eit = phases.end(); it != eit; ++it)
+        std::cout << std::setw(48) << it->first << std::setw(12) << it->second.calls << it->second.wallMs << " ms\n";
+    for (CounterSummaryMap::const_iterator it = counters.begin(), eit = counters.end(); it != eit; ++it) {
+        Count total = 0;
+        for (u32_t i = 0; i < it->second.size(); i++)
+            total += it->second[i];
+        std::cout << std::setw(48) << it->first << total << "\n";
+    }
+    std::cout << "#######################################################" << std::endl;
+
+    if (!ProfileJson.empty()) {
+        std::ofstream os(ProfileJson.c_str());
+        if (os)
+            writeJson(os, phases, counters);
+        else
+            errs() << analysisUtil::errMsg("can not write profile to " + ProfileJson.getValue()) << "\n";
+    }
+}
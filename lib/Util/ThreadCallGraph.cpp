@@ -86,7 +86,7 @@ void ThreadCallGraph::updateCallGraph(PointerAnalysis* pta) {
         const Value* forkedval=tdAPI->getForkedFun(*it);
         if(dyn_cast<Function>(forkedval)==NULL) {
             PAG* pag = pta->getPAG();
-            const PointsTo& targets = pta->getPts(pag->getValueNode(forkedval));
+            const PointsTo& targets = pta->getConstPts(pag->getValueNode(forkedval));
             for (PointsTo::iterator ii = targets.begin(), ie = targets.end(); ii != ie; ii++) {
                 if(ObjPN* objPN = dyn_cast<ObjPN>(pag->getPAGNode(*ii))) {
                     const MemObj* obj = pag->getObject(objPN);
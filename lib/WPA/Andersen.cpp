@@ -19,10 +19,29 @@
 #include "Util/AnalysisUtil.h"
 
 #include <llvm/Support/CommandLine.h> // for tool output file
+#include <llvm/Support/FileSystem.h>	// for sys::fs::F_None
 
 using namespace llvm;
 using namespace analysisUtil;
 
+static cl::opt<std::string> WorklistTrace("wl-trace", cl::value_desc("filename"),
+        cl::desc("Record worklist operations of the constraint solver into a file"));
+
+static cl::opt<WorkListOrder> WorklistOrder("wl-order", cl::init(WL_FIFO),
+        cl::desc("Order of the constraint solver worklist"),
+        cl::values(
+            clEnumValN(WL_FIFO, "fifo", "First in first out"),
+            clEnumValN(WL_LIFO, "lifo", "Last in first out"),
+            clEnumValN(WL_TOPO, "topo", "Lowest topological rank first"),
+            clEnumValN(WL_LRF, "lrf", "Two-phase least recently fired first"),
+            clEnumValEnd));
+
+static cl::opt<bool> SelectiveRevPts("selective-revpts", cl::init(true),
+                                     cl::desc("Keep reverse points-to only for field objects during solving"));
+
+static cl::opt<bool> IncSCC("inc-scc", cl::init(true),
+                            cl::desc("Update SCCs with the copy/gep edges added instead of detecting them on the whole constraint graph"));
+
 
 Size_t Andersen::numOfProcessedAddr = 0;
 Size_t Andersen::numOfProcessedCopy = 0;
@@ -31,6 +50,10 @@ Size_t Andersen::numOfProcessedLoad = 0;
 Size_t Andersen::numOfProcessedStore = 0;
 
 Size_t Andersen::numOfSCCDetection = 0;
+Size_t Andersen::numOfIncSCCDetection = 0;
+Size_t Andersen::numOfOfflineMergedNodes = 0;
+Size_t Andersen::numOfHCDMerges = 0;
+double Andersen::timeOfOfflineReduction = 0;
 double Andersen::timeOfSCCDetection = 0;
 double Andersen::timeOfSCCMerges = 0;
 double Andersen::timeOfCollapse = 0;
@@ -52,6 +75,57 @@ bool Andersen::runOnModule(llvm::Module& module) {
     return false;
 }
 
+/*!
+ * Set the worklist order and open the worklist trace file
+ */
+void Andersen::initWorklist() {
+    setWorklistOrder(WorklistOrder);
+
+    if (WorklistTrace.getValue().empty() || worklistTrace)
+        return;
+
+    std::error_code errInfo;
+    worklistTrace = new raw_fd_ostream(WorklistTrace.getValue(), errInfo, sys::fs::F_None);
+    if (errInfo) {
+        errs() << errMsg("can not open worklist trace file: " + errInfo.message()) << "\n";
+        delete worklistTrace;
+        worklistTrace = NULL;
+        return;
+    }
+    setWorklistTrace(worklistTrace);
+}
+
+/*!
+ * Reverse points-to is only used by collapseField() during solving, which asks for
+ * the reverse points-to of field objects. Track those objects only, the rest is
+ * rebuilt when a client asks for reverse points-to after solving.
+ */
+void Andersen::initRevPts() {
+    if (!SelectiveRevPts)
+        return;
+
+    PTDataTy* ptd = getPTDataTy();
+    ptd->setSelectiveRevPts(true);
+    for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it) {
+        if (isa<GepObjPN>(it->second))
+            ptd->trackRevPts(it->first);
+    }
+}
+
+/*!
+ * Direct edges are recorded from now on so that SCCs can be updated incrementally.
+ * The topological order is set by the first SCC detection on the whole graph.
+ */
+void Andersen::initIncSCC() {
+    delete incSCC;
+    incSCC = NULL;
+    if (!IncSCC)
+        return;
+
+    incSCC = new CGIncSCC(consCG);
+    consCG->setRecordNewDirectEdges(true);
+}
+
 /*!
  * Start constraint solving
  */
@@ -62,6 +136,9 @@ void Andersen::processNode(NodeID nodeId) {
         dumpStat();
     }
 
+    if (!hcdCycles.empty())
+        mergeHCDCycle(nodeId);
+
     ConstraintNode* node = consCG->getConstraintNode(nodeId);
 
     for (ConstraintNode::const_iterator it = node->outgoingAddrsBegin(), eit =
@@ -69,8 +146,8 @@ void Andersen::processNode(NodeID nodeId) {
         processAddr(cast<AddrCGEdge>(*it));
     }
 
-    for (PointsTo::iterator piter = getPts(nodeId).begin(), epiter =
-                getPts(nodeId).end(); piter != epiter; ++piter) {
+    const PointsTo& pts = getConstPts(nodeId);
+    for (PointsTo::iterator piter = pts.begin(), epiter = pts.end(); piter != epiter; ++piter) {
         NodeID ptd = *piter;
         // handle load
         for (ConstraintNode::const_iterator it = node->outgoingLoadsBegin(),
@@ -170,8 +247,8 @@ bool Andersen::processCopy(NodeID node, const ConstraintEdge* edge) {
 
     assert((isa<CopyCGEdge>(edge)) && "not copy/call/ret ??");
     NodeID dst = edge->getDstID();
-    PointsTo& srcPts = getPts(node);
-    bool changed = unionPts(dst,srcPts);
+    /// node is a rep node, union by node so that persistent points-to data unions the IDs of the sets
+    bool changed = unionPts(dst,node);
     if (changed)
         pushIntoWorklist(dst);
 
@@ -186,14 +263,14 @@ bool Andersen::processCopy(NodeID node, const ConstraintEdge* edge) {
  */
 void Andersen::processGep(NodeID node, const GepCGEdge* edge) {
 
-    PointsTo& srcPts = getPts(edge->getSrcID());
+    const PointsTo& srcPts = getConstPts(edge->getSrcID());
     processGepPts(srcPts, edge);
 }
 
 /*!
  * Compute points-to for gep edges
  */
-void Andersen::processGepPts(PointsTo& pts, const GepCGEdge* edge)
+void Andersen::processGepPts(const PointsTo& pts, const GepCGEdge* edge)
 {
     numOfProcessedGep++;
 
@@ -222,6 +299,7 @@ void Andersen::processGepPts(PointsTo& pts, const GepCGEdge* edge)
             // because offset here are ignored, and it always return the base obj
             else if (const NormalGepCGEdge* normalGepEdge = dyn_cast<NormalGepCGEdge>(edge)) {
                 NodeID fieldSrcPtdNode = consCG->getGepObjNode(ptd,	normalGepEdge->getLocationSet());
+                getPTDataTy()->trackRevPts(fieldSrcPtdNode);
                 tmpDstPts.set(fieldSrcPtdNode);
             }
             else {
@@ -240,8 +318,6 @@ void Andersen::processGepPts(PointsTo& pts, const GepCGEdge* edge)
  */
 void Andersen::mergeSccCycle()
 {
-    NodeBS changedRepNodes;
-
     NodeStack revTopoOrder;
     NodeStack & topoOrder = getSCCDetector()->topoNodeStack();
     while (!topoOrder.empty()) {
@@ -250,13 +326,7 @@ void Andersen::mergeSccCycle()
         revTopoOrder.push(repNodeId);
 
         // merge sub nodes to rep node
-        mergeSccNodes(repNodeId, changedRepNodes);
-    }
-
-    // update rep/sub relation in the constraint graph.
-    // each node will have a rep node
-    for(NodeBS::iterator it = changedRepNodes.begin(), eit = changedRepNodes.end(); it!=eit; ++it) {
-        updateNodeRepAndSubs(*it);
+        mergeSccNodes(repNodeId, getSCCDetector()->subNodes(repNodeId));
     }
 
     // restore the topological order for later solving.
@@ -267,20 +337,29 @@ void Andersen::mergeSccCycle()
     }
 }
 
+/*
+ * Merge constraint graph nodes of the SCCs found by incremental SCC detection.
+ */
+void Andersen::mergeNewSccs()
+{
+    const CGIncSCC::RepToSubsMap& newSCCs = incSCC->getNewSCCs();
+    for (CGIncSCC::RepToSubsMap::const_iterator it = newSCCs.begin(), eit = newSCCs.end(); it != eit; ++it)
+        mergeSccNodes(it->first, it->second);
+
+    incSCC->clearNewSCCs();
+}
+
 
 /**
  * Union points-to of subscc nodes into its rep nodes
  * Move incoming/outgoing direct edges of sub node to rep node
  */
-void Andersen::mergeSccNodes(NodeID repNodeId, NodeBS & chanegdRepNodes)
+void Andersen::mergeSccNodes(NodeID repNodeId, const NodeBS& subNodes)
 {
-    const NodeBS& subNodes = getSCCDetector()->subNodes(repNodeId);
     for (NodeBS::iterator nodeIt = subNodes.begin(); nodeIt != subNodes.end(); nodeIt++) {
         NodeID subNodeId = *nodeIt;
-        if (subNodeId != repNodeId) {
+        if (subNodeId != repNodeId)
             mergeNodeToRep(subNodeId, repNodeId);
-            chanegdRepNodes.set(subNodeId);
-        }
     }
 }
 
@@ -290,9 +369,8 @@ void Andersen::mergeSccNodes(NodeID repNodeId, NodeBS & chanegdRepNodes)
 bool Andersen::collapseNodePts(NodeID nodeId)
 {
     bool changed = false;
-    PointsTo& nodePts = getPts(nodeId);
     /// Points to set may be changed during collapse, so use a clone instead.
-    PointsTo ptsClone = nodePts;
+    PointsTo ptsClone = getConstPts(nodeId);
     for (PointsTo::iterator ptsIt = ptsClone.begin(), ptsEit = ptsClone.end(); ptsIt != ptsEit; ptsIt++) {
         if (consCG->isFieldInsensitiveObj(*ptsIt))
             continue;
@@ -330,24 +408,24 @@ bool Andersen::collapseField(NodeID nodeId)
         NodeID fieldId = *fieldIt;
         if (fieldId != baseId) {
             // use the reverse pts of this field node to find all pointers point to it
-            PointsTo & revPts = getRevPts(fieldId);
+            PointsTo & revPts = getPTDataTy()->getRevPts(fieldId);
             for (PointsTo::iterator ptdIt = revPts.begin(), ptdEit = revPts.end();
                     ptdIt != ptdEit; ptdIt++) {
                 // change the points-to target from field to base node
-                PointsTo & pts = getPts(*ptdIt);
-                pts.reset(fieldId);
-                pts.set(baseId);
+                NodeID ptr = sccRepNode(*ptdIt);
+                clearPts(ptr, fieldId);
+                addPts(ptr, baseId);
 
                 changed = true;
             }
             // merge field node into base node, including edges and pts.
             NodeID fieldRepNodeId = consCG->sccRepNode(fieldId);
-            if (fieldRepNodeId != baseRepNodeId)
+            if (fieldRepNodeId != baseRepNodeId) {
                 mergeNodeToRep(fieldRepNodeId, baseRepNodeId);
-
-            // field's rep node FR has got new rep node BR during mergeNodeToRep(),
-            // update all FR's sub nodes' rep node to BR.
-            updateNodeRepAndSubs(fieldRepNodeId);
+                // field and base may not be on a cycle, the topological order is broken
+                if (incSCC)
+                    incSCC->invalidate();
+            }
         }
     }
 
@@ -367,21 +445,63 @@ bool Andersen::collapseField(NodeID nodeId)
 NodeStack& Andersen::SCCDetect() {
     numOfSCCDetection++;
 
-    double sccStart = stat->getClk();
-    WPAConstraintSolver::SCCDetect();
-    double sccEnd = stat->getClk();
+    bool incremental = false;
+    {
+        ProfileScope prof("sccDetect", &timeOfSCCDetection, true);
+        incremental = updateSCCIncrementally();
+        if (!incremental)
+            WPAConstraintSolver::SCCDetect();
+    }
 
-    timeOfSCCDetection +=  (sccEnd - sccStart)/TIMEINTERVAL;
+    {
+        ProfileScope prof("sccMerge", &timeOfSCCMerges, true);
+        if (incremental)
+            mergeNewSccs();
+        else
+            mergeSccCycle();
+    }
 
-    double mergeStart = stat->getClk();
+    if (incSCC == NULL)
+        return getSCCDetector()->topoNodeStack();
 
-    mergeSccCycle();
+    // edges moved to rep nodes during merging are in topological order already
+    consCG->clearNewDirectEdges();
+    if (incremental)
+        return incSCC->topoNodeStack();
 
-    double mergeEnd = stat->getClk();
+    incSCC->reset(getSCCDetector()->topoNodeStack());
+    return getSCCDetector()->topoNodeStack();
+}
 
-    timeOfSCCMerges +=  (mergeEnd - mergeStart)/TIMEINTERVAL;
+/*!
+ * Update SCCs and the topological order with the direct edges added since the last detection.
+ * Return false if SCCs need to be detected on the whole graph, i.e. the order has been
+ * invalidated or updating it visits more than a detection on the whole graph would do.
+ */
+bool Andersen::updateSCCIncrementally() {
+    if (incSCC == NULL || !incSCC->isValid())
+        return false;
 
-    return getSCCDetector()->topoNodeStack();
+    Size_t budget = consCG->getTotalNodeNum() + consCG->getDirectCGEdges().size();
+    incSCC->resetNumOfVisits();
+
+    const ConstraintGraph::NodePairVector& newEdges = consCG->getNewDirectEdges();
+    for (ConstraintGraph::NodePairVector::const_iterator it = newEdges.begin(), eit = newEdges.end(); it != eit; ++it) {
+        NodeID src = it->first;
+        NodeID dst = it->second;
+        // the edge may have been removed since it was added
+        if (!consCG->hasConstraintNode(src) || !consCG->hasConstraintNode(dst) || !consCG->hasDirectEdge(src, dst))
+            continue;
+
+        incSCC->addEdge(src, dst);
+        if (incSCC->getNumOfVisits() > budget) {
+            incSCC->invalidate();
+            return false;
+        }
+    }
+
+    numOfIncSCCDetection++;
+    return true;
 }
 
 /// Update call graph for the input indirect callsites
@@ -426,25 +546,17 @@ void Andersen::mergeNodeToRep(NodeID nodeId,NodeID newRepId) {
 
     consCG->removeConstraintNode(node);
 
-    /// set rep and sub relations
+    /// set rep and sub relations, sub nodes of node get newRepId as their rep as well
     consCG->setRep(node->getId(),newRepId);
-    NodeBS& newSubs = consCG->sccSubNodes(newRepId);
-    newSubs.set(node->getId());
-}
 
-/*
- * Updates subnodes of its rep, and rep node of its subs
- */
-void Andersen::updateNodeRepAndSubs(NodeID nodeId) {
-    NodeID repId = consCG->sccRepNode(nodeId);
-    NodeBS repSubs;
-    /// update nodeToRepMap, for each subs of current node updates its rep to newRepId
-    //  update nodeToSubsMap, union its subs with its rep Subs
-    NodeBS& nodeSubs = consCG->sccSubNodes(nodeId);
-    for(NodeBS::iterator sit = nodeSubs.begin(), esit = nodeSubs.end(); sit!=esit; ++sit) {
-        NodeID subId = *sit;
-        consCG->setRep(subId,repId);
+    /// the rep points to what the node points to, the cycles found offline for the node hold for the rep,
+    /// together with those of the rep itself
+    if (!hcdCycles.empty()) {
+        NodeToNodeBSMap::iterator it = hcdCycles.find(nodeId);
+        if (it != hcdCycles.end()) {
+            NodeBS cycleNodes = it->second;
+            hcdCycles.erase(it);
+            hcdCycles[newRepId] |= cycleNodes;
+        }
     }
-    repSubs |= nodeSubs;
-    consCG->setSubs(repId,repSubs);
 }
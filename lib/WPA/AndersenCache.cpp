@@ -0,0 +1,391 @@
+//===- AndersenCache.cpp -- Persistent cache of Andersen's results-----------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenCache.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  The results of Andersen's analysis are stored in a binary file keyed by
+ *  the hash of the module. A later run on an unchanged module maps the
+ *  file into memory and restores the results instead of solving constraints.
+ *
+ *  File layout (native byte order, all fields are 32-bit unless noted):
+ *    header:   magic[8] version analysisTy hash[32] optionsLen options[optionsLen]
+ *              numOfInitialNodes numOfNodes
+ *    gep objs: num {id baseId offset(64-bit) numOfPairs {elemNum stride}*}*
+ *                                               field objects created during solving, in id order
+ *    fi objs:  num {id}*                        objects collapsed into field-insensitive ones
+ *    reps:     num {node rep}*                  constraint graph SCC rep map
+ *    pts:      num {rep size {elem}*}*          points-to sets of rep nodes
+ *    callees:  num {funPtr calleeObj}*          resolved indirect call edges
+ *
+ *  The options are the ones affecting the results (see Andersen::getOptionKey).
+ *  The whole file is checked against the PAG before any result is restored.
+ *  It is written into a temporary file which replaces it by a rename, so that
+ *  other runs mapping it never see it truncated.
+ */
+
+#include "MemoryModel/PAG.h"
+#include "WPA/Andersen.h"
+#include "Util/AnalysisUtil.h"
+
+#include <llvm/Support/CommandLine.h> // for tool output file
+#include <llvm/Support/MemoryBuffer.h>
+#include <string.h>
+
+using namespace llvm;
+using namespace analysisUtil;
+
+static cl::opt<std::string> AnderCache("ander-cache", cl::value_desc("filename"),
+                                       cl::desc("Read Andersen's results from (or write them into) a cache file keyed by module hash"));
+
+namespace {
+
+const char CacheMagic[8] = {'S', 'V', 'F', 'P', 'T', 'A', 'C', '\0'};
+const u32_t CacheVersion = 2;
+
+/*!
+ * Bounds-checked reader over a memory-mapped cache file
+ */
+class CacheReader {
+public:
+    CacheReader(const char* b, const char* e) : cur(b), end(e) {}
+
+    inline bool read(void* data, size_t size) {
+        if ((size_t)(end - cur) < size)
+            return false;
+        memcpy(data, cur, size);
+        cur += size;
+        return true;
+    }
+    inline bool read(u32_t& v) {
+        return read(&v, sizeof(v));
+    }
+    /// Return the position of num 32-bit words and skip them, NULL if the file is truncated
+    inline const char* skip(u64_t num) {
+        if ((size_t)(end - cur) / sizeof(u32_t) < num)
+            return NULL;
+        const char* pos = cur;
+        cur += (size_t)num * sizeof(u32_t);
+        return pos;
+    }
+    inline bool atEnd() const {
+        return cur == end;
+    }
+
+private:
+    const char* cur;
+    const char* end;
+};
+
+inline u32_t wordAt(const char* pos, u32_t i) {
+    u32_t v;
+    memcpy(&v, pos + (size_t)i * sizeof(u32_t), sizeof(v));
+    return v;
+}
+
+inline void write(raw_ostream& os, u32_t v) {
+    os.write((const char*)&v, sizeof(v));
+}
+
+/// Pad a string with spaces to whole 32-bit words
+inline void padToWords(std::string& str) {
+    str.resize((str.size() + sizeof(u32_t) - 1) / sizeof(u32_t) * sizeof(u32_t), ' ');
+}
+
+inline bool isCachedFIObj(PAG* pag, NodeID id, NodeID numOfNodes) {
+    return id < numOfNodes && pag->hasGNode(id) && isa<FIObjPN>(pag->getPAGNode(id));
+}
+
+inline bool isCachedFunObj(PAG* pag, NodeID id, NodeID numOfNodes) {
+    return id < numOfNodes && pag->hasGNode(id) && isa<ObjPN>(pag->getPAGNode(id))
+           && pag->getObject(id)->getRefVal() && isa<Function>(pag->getObject(id)->getRefVal());
+}
+
+inline bool isSameLocationSet(const LocationSet& lhs, const LocationSet& rhs) {
+    return !(lhs < rhs) && !(rhs < lhs);
+}
+
+/// A field object created during solving
+struct GepObjEntry {
+    GepObjEntry(NodeID b, const LocationSet& l) : base(b), ls(l) {}
+    NodeID base;
+    LocationSet ls;
+};
+
+}
+
+/*!
+ * Restore the results from the cache file if it is built for the same module,
+ * return false if the constraints still need to be solved
+ */
+bool Andersen::readResultCache(llvm::Module& module) {
+    if (AnderCache.getValue().empty() || pag->isBuiltFromFile())
+        return false;
+
+    numOfInitialNodes = pag->getTotalNodeNum();
+
+    moduleHash = getModuleHash(module);
+
+    if (!readResultCacheFile(AnderCache.getValue()))
+        return false;
+
+    DBOUT(DGENERAL, outs() << pasMsg("Andersen results restored from cache\n"));
+    return true;
+}
+
+bool Andersen::readResultCacheFile(const std::string& filename) {
+    ErrorOr<std::unique_ptr<MemoryBuffer> > fileOrErr = MemoryBuffer::getFile(filename, -1, false);
+    if (!fileOrErr)
+        return false;
+    CacheReader reader((*fileOrErr)->getBufferStart(), (*fileOrErr)->getBufferEnd());
+
+    /// header
+    char magic[sizeof(CacheMagic)];
+    char hash[32];
+    std::string options = getOptionKey();
+    padToWords(options);
+    const char* cachedOptions;
+    u32_t version, ptaTy, optionsLen, initialNodes, totalNodes;
+    if (!reader.read(magic, sizeof(magic)) || memcmp(magic, CacheMagic, sizeof(magic))
+            || !reader.read(version) || version != CacheVersion
+            || !reader.read(ptaTy) || ptaTy != (u32_t)getAnalysisTy()
+            || !reader.read(hash, sizeof(hash)) || moduleHash != std::string(hash, sizeof(hash))
+            || !reader.read(optionsLen) || optionsLen != options.size()
+            || (cachedOptions = reader.skip(optionsLen / sizeof(u32_t))) == NULL
+            || memcmp(cachedOptions, options.data(), optionsLen)
+            || !reader.read(initialNodes) || initialNodes != numOfInitialNodes
+            || !reader.read(totalNodes) || totalNodes < initialNodes)
+        return false;
+
+    /// Check every section against the PAG before changing anything, so that a truncated or
+    /// inconsistent file is rejected as a whole. Sizes are computed in 64 bits.
+    u32_t numOfGeps, numOfFIObjs, numOfReps, numOfPts, numOfCallees;
+    const char *fiObjs, *reps, *pts, *callees;
+
+    /// Field objects are created lazily while solving, their creation is replayed in id order so that
+    /// the node ids in the cached points-to sets refer to the same objects. Each of them must be new.
+    if (!reader.read(numOfGeps) || numOfGeps != totalNodes - initialNodes)
+        return false;
+    SymbolTableInfo* symInfo = SymbolTableInfo::Symbolnfo();
+    std::vector<GepObjEntry> geps;
+    std::set<std::pair<NodeID, LocationSet> > newGeps;
+    for (u32_t i = 0; i < numOfGeps; i++) {
+        u32_t id, base, numOfPairs;
+        Size_t offset;
+        const char* pairs;
+        if (!reader.read(id) || id != initialNodes + i
+                || !reader.read(base) || !isCachedFIObj(pag, base, initialNodes)
+                || !reader.read(&offset, sizeof(offset))
+                || !reader.read(numOfPairs) || (pairs = reader.skip((u64_t)numOfPairs * 2)) == NULL)
+            return false;
+        LocationSet ls(offset);
+        for (u32_t j = 0; j < numOfPairs; j++)
+            ls.addElemNumStridePair(std::make_pair(wordAt(pairs, 2 * j), wordAt(pairs, 2 * j + 1)));
+        const MemObj* obj = pag->getObject(base);
+        if (obj->isFieldInsensitive() || !isSameLocationSet(symInfo->getModulusOffset(obj->getTypeInfo(), ls), ls)
+                || pag->hasGepObjNode(base, ls) || !newGeps.insert(std::make_pair(base, ls)).second) {
+            wrnMsg("Andersen result cache does not match the PAG, solve constraints instead");
+            return false;
+        }
+        geps.push_back(GepObjEntry(base, ls));
+    }
+
+    if (!reader.read(numOfFIObjs) || (fiObjs = reader.skip(numOfFIObjs)) == NULL)
+        return false;
+    for (u32_t i = 0; i < numOfFIObjs; i++) {
+        if (!isCachedFIObj(pag, wordAt(fiObjs, i), initialNodes))
+            return false;
+    }
+
+    if (!reader.read(numOfReps) || (reps = reader.skip((u64_t)numOfReps * 2)) == NULL)
+        return false;
+    for (u32_t i = 0; i < numOfReps; i++) {
+        NodeID node = wordAt(reps, 2 * i);
+        NodeID rep = wordAt(reps, 2 * i + 1);
+        if (node >= totalNodes || rep >= totalNodes || node == rep)
+            return false;
+    }
+
+    if (!reader.read(numOfPts))
+        return false;
+    pts = reader.skip(0);
+    for (u32_t i = 0; i < numOfPts; i++) {
+        u32_t id, size;
+        const char* elems;
+        if (!reader.read(id) || id >= totalNodes || !reader.read(size) || (elems = reader.skip(size)) == NULL)
+            return false;
+        for (u32_t j = 0; j < size; j++) {
+            if (wordAt(elems, j) >= totalNodes)
+                return false;
+        }
+    }
+
+    if (!reader.read(numOfCallees) || (callees = reader.skip((u64_t)numOfCallees * 2)) == NULL || !reader.atEnd())
+        return false;
+    for (u32_t i = 0; i < numOfCallees; i++) {
+        if (wordAt(callees, 2 * i) >= initialNodes || !isCachedFunObj(pag, wordAt(callees, 2 * i + 1), initialNodes))
+            return false;
+    }
+
+    /// restore the results
+    for (u32_t i = 0; i < numOfGeps; i++) {
+        if (consCG->getGepObjNode(geps[i].base, geps[i].ls) != initialNodes + i) {
+            /// the field objects created so far are valid, they are used when solving
+            wrnMsg("Andersen result cache does not match the PAG, solve constraints instead");
+            return false;
+        }
+    }
+
+    for (u32_t i = 0; i < numOfFIObjs; i++)
+        consCG->setObjFieldInsensitive(wordAt(fiObjs, i));
+
+    for (u32_t i = 0; i < numOfReps; i++) {
+        NodeID node = wordAt(reps, 2 * i);
+        NodeID rep = wordAt(reps, 2 * i + 1);
+        if (consCG->hasConstraintNode(node) && consCG->hasConstraintNode(rep))
+            mergeNodeToRep(node, rep);
+        else
+            consCG->setRep(node, rep);
+    }
+
+    const char* pos = pts;
+    for (u32_t i = 0; i < numOfPts; i++) {
+        NodeID id = wordAt(pos, 0);
+        u32_t size = wordAt(pos, 1);
+        PointsTo target;
+        for (u32_t j = 0; j < size; j++)
+            target.set(wordAt(pos, 2 + j));
+        unionPts(id, target);
+        pos += (size_t)(2 + size) * sizeof(u32_t);
+    }
+
+    /// Callees are recorded per function pointer, apply them to every callsite using the pointer
+    std::map<NodeID, NodeBS> funPtrToCallees;
+    for (u32_t i = 0; i < numOfCallees; i++)
+        funPtrToCallees[wordAt(callees, 2 * i)].set(wordAt(callees, 2 * i + 1));
+
+    const CallSiteToFunPtrMap& callsites = getIndirectCallsites();
+    NodePairSet cpySrcNodes;
+    for (CallSiteToFunPtrMap::const_iterator it = callsites.begin(), eit = callsites.end(); it != eit; ++it) {
+        std::map<NodeID, NodeBS>::const_iterator cit = funPtrToCallees.find(it->second);
+        if (cit == funPtrToCallees.end())
+            continue;
+        llvm::CallSite cs = it->first;
+        for (NodeBS::iterator fit = cit->second.begin(), efit = cit->second.end(); fit != efit; ++fit) {
+            const Function* callee = cast<Function>(pag->getObject(*fit)->getRefVal());
+            if (cs.arg_size() != callee->arg_size() || getIndCallMap()[cs].count(callee))
+                continue;
+            getIndCallMap()[cs].insert(callee);
+            ptaCallGraph->addIndirectCallGraphEdge(cs.getInstruction(), callee);
+            consCG->connectCaller2CalleeParams(cs, callee, cpySrcNodes);
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * Write the results into the cache file after solving
+ */
+void Andersen::writeResultCache() {
+    if (AnderCache.getValue().empty() || pag->isBuiltFromFile())
+        return;
+
+    SmallString<128> tempFile;
+    raw_fd_ostream* tempOS = createTempFile(AnderCache.getValue(), tempFile);
+    if (tempOS == NULL)
+        return;
+    raw_fd_ostream& os = *tempOS;
+
+    NodeID totalNodes = pag->getTotalNodeNum();
+
+    os.write(CacheMagic, sizeof(CacheMagic));
+    write(os, CacheVersion);
+    write(os, getAnalysisTy());
+    os.write(moduleHash.data(), moduleHash.size());
+    std::string options = getOptionKey();
+    padToWords(options);
+    write(os, options.size());
+    os.write(options.data(), options.size());
+    write(os, numOfInitialNodes);
+    write(os, totalNodes);
+
+    std::vector<NodeID> geps;
+    for (NodeID id = numOfInitialNodes; id < totalNodes; id++) {
+        assert(isa<GepObjPN>(pag->getPAGNode(id)) && "only field objects are expected to be created during solving");
+        geps.push_back(id);
+    }
+    write(os, geps.size());
+    for (std::vector<NodeID>::const_iterator it = geps.begin(), eit = geps.end(); it != eit; ++it) {
+        GepObjPN* gepNode = cast<GepObjPN>(pag->getPAGNode(*it));
+        const LocationSet& ls = gepNode->getLocationSet();
+        Size_t offset = ls.getOffset();
+        write(os, *it);
+        write(os, pag->getFIObjNode(gepNode->getMemObj()));
+        os.write((const char*)&offset, sizeof(offset));
+        write(os, ls.getNumStridePair().size());
+        for (LocationSet::ElemNumStridePairVec::const_iterator pit = ls.getNumStridePair().begin(),
+                epit = ls.getNumStridePair().end(); pit != epit; ++pit) {
+            write(os, pit->first);
+            write(os, pit->second);
+        }
+    }
+
+    std::vector<NodeID> fiObjs;
+    for (NodeID id = 0; id < totalNodes; id++) {
+        if (pag->hasGNode(id) && isa<FIObjPN>(pag->getPAGNode(id)) && consCG->isFieldInsensitiveObj(id))
+            fiObjs.push_back(id);
+    }
+    write(os, fiObjs.size());
+    for (std::vector<NodeID>::const_iterator it = fiObjs.begin(), eit = fiObjs.end(); it != eit; ++it)
+        write(os, *it);
+
+    /// write the rep map in node id order
+    std::vector<NodePair> reps;
+    for (NodeID id = 0; id < totalNodes; id++) {
+        NodeID rep = sccRepNode(id);
+        if (rep != id)
+            reps.push_back(std::make_pair(id, rep));
+    }
+    write(os, reps.size());
+    for (std::vector<NodePair>::const_iterator it = reps.begin(), eit = reps.end(); it != eit; ++it) {
+        write(os, it->first);
+        write(os, it->second);
+    }
+
+    std::vector<NodeID> ptrs;
+    for (NodeID id = 0; id < totalNodes; id++) {
+        if (sccRepNode(id) == id && !getConstPts(id).empty())
+            ptrs.push_back(id);
+    }
+    write(os, ptrs.size());
+    for (std::vector<NodeID>::const_iterator it = ptrs.begin(), eit = ptrs.end(); it != eit; ++it) {
+        const PointsTo& pts = getConstPts(*it);
+        write(os, *it);
+        write(os, pts.count());
+        for (PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit != epit; ++pit)
+            write(os, *pit);
+    }
+
+    std::set<NodePair> callees;
+    for (CallEdgeMap::const_iterator it = getIndCallMap().begin(), eit = getIndCallMap().end(); it != eit; ++it) {
+        NodeID funPtr = pag->getFunPtr(it->first);
+        for (FunctionSet::const_iterator fit = it->second.begin(), efit = it->second.end(); fit != efit; ++fit)
+            callees.insert(std::make_pair(funPtr, pag->getObjectNode(*fit)));
+    }
+    write(os, callees.size());
+    for (std::set<NodePair>::const_iterator it = callees.begin(), eit = callees.end(); it != eit; ++it) {
+        write(os, it->first);
+        write(os, it->second);
+    }
+
+    commitTempFile(tempOS, tempFile, AnderCache.getValue());
+}
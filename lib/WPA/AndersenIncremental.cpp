@@ -0,0 +1,453 @@
+//===- AndersenIncremental.cpp -- Incremental Andersen's analysis------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenIncremental.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  Re-solve a solved constraint graph after the PAG edges of some functions
+ *  are added or removed.
+ *
+ *  Added edges only make points-to sets grow, their constraints are added and
+ *  their source nodes are pushed into the worklist.
+ *
+ *  A removed edge may invalidate every points-to set reachable from it. The
+ *  affected nodes are found by a forward traversal from the removed edges
+ *  (direct and load edges, and the objects stored into by a store pointer).
+ *  Their points-to sets and the copy edges derived from them by load/store
+ *  edges are dropped, and they are re-derived from the unaffected nodes around
+ *  them. The solve falls back to one from scratch when the affected nodes have
+ *  been merged into an SCC, hold the target of an indirect call, or exceed
+ *  the budget, or when an added edge flows into a node merged offline.
+ */
+
+#include "MemoryModel/PAG.h"
+#include "WPA/Andersen.h"
+#include "Util/AnalysisUtil.h"
+
+#include <llvm/Support/CommandLine.h>
+
+using namespace llvm;
+using namespace analysisUtil;
+
+static cl::opt<unsigned> IncSolveBudget("ander-inc-budget", cl::init(100000),
+                                        cl::desc("Maximum number of nodes re-derived by an incremental solve before solving from scratch"));
+
+static cl::opt<bool> IncSolveVerify("ander-inc-verify", cl::init(false),
+                                    cl::desc("Compare the results of each incremental solve with a solve from scratch"));
+
+namespace {
+
+/// PAG edges turned into copy edges on the constraint graph
+inline bool isCopyPAGEdge(PAGEdge::GEdgeFlag kind) {
+    return kind == PAGEdge::Copy || kind == PAGEdge::Call || kind == PAGEdge::Ret
+           || kind == PAGEdge::ThreadFork || kind == PAGEdge::ThreadJoin;
+}
+
+/// Constraint edge kind of a PAG edge
+inline ConstraintEdge::ConstraintEdgeK getConstraintEdgeKind(const PAGEdge* edge) {
+    switch (edge->getEdgeKind()) {
+    case PAGEdge::Addr:
+        return ConstraintEdge::Addr;
+    case PAGEdge::Store:
+        return ConstraintEdge::Store;
+    case PAGEdge::Load:
+        return ConstraintEdge::Load;
+    case PAGEdge::NormalGep:
+        return ConstraintEdge::NormalGep;
+    case PAGEdge::VariantGep:
+        return ConstraintEdge::VariantGep;
+    default:
+        assert(isCopyPAGEdge(edge->getEdgeKind()) && "new PAG edge kind?");
+        return ConstraintEdge::Copy;
+    }
+}
+
+
+/*!
+ * Static statistics of Andersen's analysis, restored when destroyed
+ */
+class AndersenStatSnapshot {
+public:
+    AndersenStatSnapshot() {
+        for (u32_t i = 0; i < NumOfCounts; i++)
+            counts[i] = *getCount(i);
+        for (u32_t i = 0; i < NumOfTimes; i++)
+            times[i] = *getTime(i);
+    }
+    ~AndersenStatSnapshot() {
+        for (u32_t i = 0; i < NumOfCounts; i++)
+            *getCount(i) = counts[i];
+        for (u32_t i = 0; i < NumOfTimes; i++)
+            *getTime(i) = times[i];
+    }
+
+private:
+    static const u32_t NumOfCounts = 11;
+    static const u32_t NumOfTimes = 7;
+
+    static Size_t* getCount(u32_t i) {
+        static Size_t* const counts[NumOfCounts] = {
+            &Andersen::numOfProcessedAddr, &Andersen::numOfProcessedCopy, &Andersen::numOfProcessedGep,
+            &Andersen::numOfProcessedLoad, &Andersen::numOfProcessedStore, &Andersen::numOfSCCDetection,
+            &Andersen::numOfIncSCCDetection, &Andersen::numOfOfflineMergedNodes, &Andersen::numOfHCDMerges,
+            &Andersen::AveragePointsToSetSize, &Andersen::MaxPointsToSetSize
+        };
+        return counts[i];
+    }
+    static double* getTime(u32_t i) {
+        static double* const times[NumOfTimes] = {
+            &Andersen::timeOfOfflineReduction, &Andersen::timeOfSCCDetection, &Andersen::timeOfSCCMerges,
+            &Andersen::timeOfCollapse, &Andersen::timeOfProcessCopyGep, &Andersen::timeOfProcessLoadStore,
+            &Andersen::timeOfUpdateCallGraph
+        };
+        return times[i];
+    }
+
+    Size_t counts[NumOfCounts];
+    double times[NumOfTimes];
+};
+
+}
+
+/*!
+ * Re-solve after the PAG edges of some functions are changed
+ */
+void Andersen::solveIncrementally(const FunToPAGEdgeDiffMap& diffs) {
+
+    /// points-to sets are changed again
+    disableAliasCache();
+
+    PAGEdge::PAGEdgeSetTy addedEdges;
+    PAGEdge::PAGEdgeSetTy removedEdges;
+    for (FunToPAGEdgeDiffMap::const_iterator it = diffs.begin(), eit = diffs.end(); it != eit; ++it) {
+        const PAGEdgeDiff& diff = it->second;
+        for (PAGEdge::PAGEdgeSetTy::const_iterator edgeIt = diff.removedEdges.begin(),
+                edgeEit = diff.removedEdges.end(); edgeIt != edgeEit; ++edgeIt) {
+            if (removedPAGEdges.insert(*edgeIt).second)
+                removedEdges.insert(*edgeIt);
+        }
+        for (PAGEdge::PAGEdgeSetTy::const_iterator edgeIt = diff.addedEdges.begin(),
+                edgeEit = diff.addedEdges.end(); edgeIt != edgeEit; ++edgeIt) {
+            removedPAGEdges.erase(*edgeIt);
+            removedEdges.erase(*edgeIt);
+            addedEdges.insert(*edgeIt);
+        }
+    }
+
+    DBOUT(DGENERAL, outs() << pasMsg("Start Solving Constraints Incrementally\n"));
+
+    /// nodes merged by value numbering are only equivalent with the edges they were labelled with
+    if (isIncrementalSolver() && !hasOfflineMergedDst(addedEdges) && removeConstraints(removedEdges)) {
+        /// a removed edge may break a cycle found offline
+        if (!removedEdges.empty())
+            hcdCycles.clear();
+        addConstraints(addedEdges);
+        solveWorklist();
+    }
+    else {
+        DBOUT(DGENERAL, outs() << pasMsg("Solving Constraints from Scratch\n"));
+        solveFromScratch();
+    }
+
+    DBOUT(DGENERAL, outs() << pasMsg("Finish Solving Constraints Incrementally\n"));
+
+    if (IncSolveVerify)
+        verifyWithSolveFromScratch("incremental solve");
+
+    finalize();
+}
+
+/*!
+ * Remove the constraints of removed PAG edges.
+ * Nodes whose points-to sets may depend on these edges are collected first, the
+ * graph and the points-to sets are only changed if all of them can be re-derived.
+ */
+bool Andersen::removeConstraints(const PAGEdge::PAGEdgeSetTy& edges) {
+    if (edges.empty())
+        return true;
+
+    NodeBS affected;
+    NodeBS affectedObjs;
+    NodeVector worklist;
+    u32_t numOfVisited = 0;
+
+    /// nodes whose points-to set may change
+    for (PAGEdge::PAGEdgeSetTy::const_iterator it = edges.begin(), eit = edges.end(); it != eit; ++it) {
+        const PAGEdge* edge = *it;
+        NodeID src = sccRepNode(edge->getSrcID());
+        NodeID dst = sccRepNode(edge->getDstID());
+        if (!consCG->hasConstraintNode(src) || !consCG->hasConstraintNode(dst))
+            continue;
+        if (src == dst || hasSubNodes(src) || hasSubNodes(dst))
+            return false;
+
+        if (edge->getEdgeKind() == PAGEdge::Store) {
+            const PointsTo& pts = getConstPts(dst);
+            for (PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit != epit; ++pit) {
+                if (affected.test_and_set(sccRepNode(*pit)))
+                    worklist.push_back(sccRepNode(*pit));
+            }
+        }
+        else if (affected.test_and_set(dst))
+            worklist.push_back(dst);
+    }
+
+    while (!worklist.empty()) {
+        NodeID id = worklist.back();
+        worklist.pop_back();
+
+        if (++numOfVisited > IncSolveBudget || hasSubNodes(id)
+                || consCG->isPWCNode(id) || pag->isFunPtr(id))
+            return false;
+
+        ConstraintNode* node = consCG->getConstraintNode(id);
+        for (ConstraintNode::const_iterator it = node->directOutEdgeBegin(), eit =
+                    node->directOutEdgeEnd(); it != eit; ++it) {
+            if (affected.test_and_set((*it)->getDstID()))
+                worklist.push_back((*it)->getDstID());
+        }
+        for (ConstraintNode::const_iterator it = node->outgoingLoadsBegin(), eit =
+                    node->outgoingLoadsEnd(); it != eit; ++it) {
+            if (affected.test_and_set((*it)->getDstID()))
+                worklist.push_back((*it)->getDstID());
+        }
+        if (node->incomingStoresBegin() != node->incomingStoresEnd()) {
+            const PointsTo& pts = getConstPts(id);
+            for (PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit != epit; ++pit) {
+                if (affected.test_and_set(sccRepNode(*pit)))
+                    worklist.push_back(sccRepNode(*pit));
+            }
+        }
+    }
+
+    /// copy edges added by load/store edges into the affected nodes, they have an object
+    /// on one side, except the ones which were on the PAG
+    EdgeSet derivedEdges;
+    for (NodeBS::iterator nit = affected.begin(), neit = affected.end(); nit != neit; ++nit) {
+        NodeID id = *nit;
+        bool isObj = isa<ObjPN>(pag->getPAGNode(id));
+        if (isObj)
+            affectedObjs.set(id);
+
+        ConstraintNode* node = consCG->getConstraintNode(id);
+        for (ConstraintNode::const_iterator it = node->directInEdgeBegin(), eit =
+                    node->directInEdgeEnd(); it != eit; ++it) {
+            const ConstraintEdge* edge = *it;
+            NodeID src = edge->getSrcID();
+            if (!isa<CopyCGEdge>(edge) || (!isObj && !isa<ObjPN>(pag->getPAGNode(src))))
+                continue;
+            /// a merged object may carry copy edges of its value sub nodes
+            if (!isObj && hasSubNodes(src))
+                return false;
+            if (!hasPAGCopyEdge(src, id))
+                derivedEdges.insert(edge);
+        }
+    }
+
+    DBOUT(DAndersen, outs() << "re-derive " << affected.count() << " nodes\n");
+
+    for (PAGEdge::PAGEdgeSetTy::const_iterator it = edges.begin(), eit = edges.end(); it != eit; ++it)
+        removeConstraintEdge(*it);
+
+    for (EdgeSet::iterator it = derivedEdges.begin(), eit = derivedEdges.end(); it != eit; ++it) {
+        /// a derived edge may also be the constraint edge of a removed PAG edge
+        ConstraintEdge* edge = consCG->getEdge(consCG->getConstraintNode((*it)->getSrcID()),
+                                               consCG->getConstraintNode((*it)->getDstID()), ConstraintEdge::Copy);
+        if (edge == *it)
+            consCG->removeDirectEdge(edge);
+    }
+
+    for (NodeBS::iterator nit = affected.begin(), neit = affected.end(); nit != neit; ++nit)
+        getPTDataTy()->clearFullPts(*nit);
+
+    /// re-derive from the unaffected nodes around the affected ones
+    for (NodeBS::iterator nit = affected.begin(), neit = affected.end(); nit != neit; ++nit) {
+        ConstraintNode* node = consCG->getConstraintNode(*nit);
+        for (ConstraintNode::const_iterator it = node->incomingAddrsBegin(), eit =
+                    node->incomingAddrsEnd(); it != eit; ++it)
+            processAddr(cast<AddrCGEdge>(*it));
+        for (ConstraintNode::const_iterator it = node->directInEdgeBegin(), eit =
+                    node->directInEdgeEnd(); it != eit; ++it) {
+            if (!affected.test((*it)->getSrcID()))
+                pushIntoWorklist((*it)->getSrcID());
+        }
+        for (ConstraintNode::const_iterator it = node->incomingLoadsBegin(), eit =
+                    node->incomingLoadsEnd(); it != eit; ++it) {
+            if (!affected.test((*it)->getSrcID()))
+                pushIntoWorklist((*it)->getSrcID());
+        }
+    }
+
+    if (!affectedObjs.empty()) {
+        ConstraintEdge::ConstraintEdgeSetTy& stores = consCG->getStoreCGEdges();
+        for (ConstraintEdge::ConstraintEdgeSetTy::iterator it = stores.begin(), eit = stores.end(); it != eit; ++it) {
+            NodeID dst = (*it)->getDstID();
+            if (!affected.test(dst) && getConstPts(dst).intersects(affectedObjs))
+                pushIntoWorklist(dst);
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * Add the constraints of added PAG edges and push the nodes to propagate from
+ */
+void Andersen::addConstraints(const PAGEdge::PAGEdgeSetTy& edges) {
+    for (PAGEdge::PAGEdgeSetTy::const_iterator it = edges.begin(), eit = edges.end(); it != eit; ++it) {
+        const PAGEdge* edge = *it;
+        NodeID src = sccRepNode(edge->getSrcID());
+        NodeID dst = sccRepNode(edge->getDstID());
+
+        /// nodes added into the PAG after the constraint graph is built
+        if (!consCG->hasConstraintNode(src))
+            consCG->addConstraintNode(new ConstraintNode(src), src);
+        if (!consCG->hasConstraintNode(dst))
+            consCG->addConstraintNode(new ConstraintNode(dst), dst);
+
+        switch (getConstraintEdgeKind(edge)) {
+        case ConstraintEdge::Addr:
+            if (consCG->addAddrCGEdge(src, dst))
+                processAddr(cast<AddrCGEdge>(consCG->getEdge(consCG->getConstraintNode(src),
+                                             consCG->getConstraintNode(dst), ConstraintEdge::Addr)));
+            break;
+        case ConstraintEdge::Copy:
+            if (src != dst && consCG->addCopyCGEdge(src, dst))
+                pushIntoWorklist(src);
+            break;
+        case ConstraintEdge::NormalGep:
+            if (consCG->addNormalGepCGEdge(src, dst, cast<NormalGepPE>(edge)->getLocationSet()))
+                pushIntoWorklist(src);
+            break;
+        case ConstraintEdge::VariantGep:
+            if (consCG->addVariantGepCGEdge(src, dst))
+                pushIntoWorklist(src);
+            break;
+        case ConstraintEdge::Load:
+            if (consCG->addLoadCGEdge(src, dst))
+                pushIntoWorklist(src);
+            break;
+        case ConstraintEdge::Store:
+            if (consCG->addStoreCGEdge(src, dst))
+                pushIntoWorklist(dst);
+            break;
+        }
+    }
+}
+
+/*!
+ * Remove the constraint edge of a PAG edge.
+ * A copy edge is kept if another PAG edge between the same nodes is still there.
+ */
+void Andersen::removeConstraintEdge(const PAGEdge* edge) {
+    NodeID src = sccRepNode(edge->getSrcID());
+    NodeID dst = sccRepNode(edge->getDstID());
+    if (!consCG->hasConstraintNode(src) || !consCG->hasConstraintNode(dst))
+        return;
+
+    ConstraintEdge::ConstraintEdgeK kind = getConstraintEdgeKind(edge);
+    ConstraintEdge* cgEdge = consCG->getEdge(consCG->getConstraintNode(src), consCG->getConstraintNode(dst), kind);
+    if (cgEdge == NULL)
+        return;
+
+    if (AddrCGEdge* addr = dyn_cast<AddrCGEdge>(cgEdge))
+        consCG->removeAddrEdge(addr);
+    else if (LoadCGEdge* load = dyn_cast<LoadCGEdge>(cgEdge))
+        consCG->removeLoadEdge(load);
+    else if (StoreCGEdge* store = dyn_cast<StoreCGEdge>(cgEdge))
+        consCG->removeStoreEdge(store);
+    else if (kind != ConstraintEdge::Copy || !hasPAGCopyEdge(src, dst))
+        consCG->removeDirectEdge(cgEdge);
+}
+
+/*!
+ * Whether src and dst are connected by a copy/call/ret/thread edge on the PAG which is not removed
+ */
+bool Andersen::hasPAGCopyEdge(NodeID src, NodeID dst) const {
+    PAGNode* srcNode = pag->getPAGNode(src);
+    const PAGEdge::PEDGEK kinds[] = {PAGEdge::Copy, PAGEdge::Call, PAGEdge::Ret, PAGEdge::ThreadFork, PAGEdge::ThreadJoin};
+    for (u32_t i = 0; i < sizeof(kinds) / sizeof(kinds[0]); i++) {
+        if (!srcNode->hasOutgoingEdges(kinds[i]))
+            continue;
+        for (PAGEdge::PAGEdgeSetTy::iterator it = srcNode->getOutgoingEdgesBegin(kinds[i]),
+                eit = srcNode->getOutgoingEdgesEnd(kinds[i]); it != eit; ++it) {
+            if ((*it)->getDstID() == dst && removedPAGEdges.count(*it) == 0)
+                return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ * Process the nodes in the worklist without SCC detection, and the call edges
+ * resolved from the new points-to sets
+ */
+void Andersen::solveWorklist() {
+    do {
+        reanalyze = false;
+
+        while (!isWorklistEmpty())
+            processNode(popFromWorklist());
+
+        ProfileScope prof("updateCallGraph", &timeOfUpdateCallGraph, true);
+        if (updateCallGraph(getIndirectCallsites()))
+            reanalyze = true;
+
+    } while (reanalyze);
+}
+
+/*!
+ * Rebuild the constraint graph and the call graph, and solve all constraints again
+ */
+void Andersen::solveFromScratch() {
+    delete consCG;
+    consCG = NULL;
+    PointerAnalysis::destroy();
+    getPTDataTy()->clear();
+
+    initialize(*getModule());
+    for (PAGEdge::PAGEdgeSetTy::const_iterator it = removedPAGEdges.begin(), eit = removedPAGEdges.end(); it != eit; ++it)
+        removeConstraintEdge(*it);
+
+    solveConstraints();
+}
+
+/*!
+ * Compare the points-to set of every PAG node with the one computed from scratch.
+ * The current results are saved and this analysis is solved again from scratch,
+ * so that no other analysis shares the PAG while solving. The statistics, which are
+ * static, are restored afterwards to count the solves being verified only.
+ */
+bool Andersen::verifyWithSolveFromScratch(const std::string& solveName) {
+    std::map<NodeID, PointsTo> solvedPts;
+    for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+        solvedPts[it->first] = getConstPts(it->first);
+
+    {
+        AndersenStatSnapshot statSnapshot;
+        solveFromScratch();
+    }
+
+    u32_t numOfMismatches = 0;
+    for (std::map<NodeID, PointsTo>::const_iterator it = solvedPts.begin(), eit = solvedPts.end(); it != eit; ++it) {
+        if (it->second != getConstPts(it->first)) {
+            numOfMismatches++;
+            DBOUT(DAndersen, outs() << "points-to of node " << it->first << " differs from the one solved from scratch\n");
+        }
+    }
+
+    if (numOfMismatches) {
+        outs() << errMsg(solveName + " differs from the solve from scratch on ") << numOfMismatches << " nodes\n";
+        return false;
+    }
+    outs() << sucMsg(solveName + " is the same as the solve from scratch\n");
+    return true;
+}
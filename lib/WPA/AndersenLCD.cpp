@@ -34,6 +34,9 @@ void AndersenLCD::processNode(NodeID nodeId) {
         dumpStat();
     }
 
+    if (!hcdCycles.empty())
+        mergeHCDCycle(nodeId);
+
     ConstraintNode* node = consCG->getConstraintNode(nodeId);
 
     for (ConstraintNode::const_iterator it = node->outgoingAddrsBegin(), eit =  node->outgoingAddrsEnd(); it != eit;
@@ -41,8 +44,8 @@ void AndersenLCD::processNode(NodeID nodeId) {
         processAddr(cast<AddrCGEdge>(*it));
     }
 
-    for (PointsTo::iterator piter = getPts(nodeId).begin(), epiter = getPts(
-                nodeId).end(); piter != epiter; ++piter) {
+    const PointsTo& pts = getConstPts(nodeId);
+    for (PointsTo::iterator piter = pts.begin(), epiter = pts.end(); piter != epiter; ++piter) {
         NodeID ptd = *piter;
         // handle load
         for (ConstraintNode::const_iterator it = node->outgoingLoadsBegin(), eit = node->outgoingLoadsEnd(); it != eit;
@@ -84,8 +87,8 @@ bool AndersenLCD::processCopy(NodeID node, const ConstraintEdge* edge) {
 
     assert((isa<CopyCGEdge>(edge)) && "not copy/call/ret ??");
     NodeID dst = edge->getDstID();
-    PointsTo& srcPts = getPts(node);
-    PointsTo& dstPts = getPts(dst);
+    const PointsTo& srcPts = getConstPts(node);
+    const PointsTo& dstPts = getConstPts(dst);
     /// Lazy cycle detection when points-to of source and destination are identical
     /// and we haven't seen this edge before
     if (srcPts == dstPts) {
@@ -93,7 +96,7 @@ bool AndersenLCD::processCopy(NodeID node, const ConstraintEdge* edge) {
             return true;
         }
     } else {
-        if (unionPts(dst, srcPts))
+        if (unionPts(dst, node))
             pushIntoWorklist(dst);
     }
     return false;
@@ -0,0 +1,407 @@
+//===- AndersenOffline.cpp -- Offline constraint graph reduction-------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenOffline.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  The constraint graph is reduced before solving.
+ *
+ *  Hash-based value numbering (HVN) labels every node with the points-to
+ *  sources flowing into it. Objects and the nodes which get edges while
+ *  solving (formal parameters, varargs and the returns of indirect callsites)
+ *  get a fresh label. The label of the other nodes is derived from the labels
+ *  of the nodes flowing into them: a copy edge passes its label on, a gep edge
+ *  gives one label per (label, location set) and a load edge one label per
+ *  label of the pointer. Nodes with the same non-empty label end up with the
+ *  same points-to set and are merged before solving.
+ *
+ *  Hybrid cycle detection (HCD) looks for cycles of copy edges through a
+ *  single dereference *p, i.e. a store into *p and a load from *p. Once an
+ *  object o in pts(p) is processed, o is on a copy cycle with the other nodes
+ *  of such a cycle, so it is merged into the cycle when p is processed instead
+ *  of waiting for the next SCC detection to find it.
+ */
+
+#include "MemoryModel/PAG.h"
+#include "WPA/Andersen.h"
+#include "Util/AnalysisUtil.h"
+
+#include <llvm/Support/CommandLine.h>
+#include <algorithm>
+
+using namespace llvm;
+using namespace analysisUtil;
+
+static cl::opt<bool> AnderHVN("ander-hvn", cl::init(true),
+                              cl::desc("Merge pointer-equivalent nodes of the constraint graph before solving"));
+
+static cl::opt<bool> AnderHCD("ander-hcd", cl::init(true),
+                              cl::desc("Collapse the load/store cycles found before solving when their pointers are processed"));
+
+namespace {
+
+/*!
+ * Adjacency list graph for offline cycle detection
+ */
+struct OfflineNode {
+    OfflineNode(NodeID i) : id(i) {}
+    NodeID id;
+    std::vector<OfflineNode*> succs;
+};
+
+struct OfflineGraph {
+    typedef std::vector<OfflineNode*> OfflineNodeVector;
+
+    ~OfflineGraph() {
+        for (OfflineNodeVector::iterator it = nodes.begin(), eit = nodes.end(); it != eit; ++it)
+            delete *it;
+    }
+
+    inline void addNode(NodeID id) {
+        if (id >= idToNode.size())
+            idToNode.resize(id + 1, NULL);
+        if (idToNode[id] == NULL) {
+            idToNode[id] = new OfflineNode(id);
+            nodes.push_back(idToNode[id]);
+        }
+    }
+    inline void addEdge(NodeID src, NodeID dst) {
+        addNode(src);
+        addNode(dst);
+        idToNode[src]->succs.push_back(idToNode[dst]);
+    }
+
+    OfflineNodeVector nodes;
+    OfflineNodeVector idToNode;
+};
+
+}
+
+namespace llvm {
+template<> struct GraphTraits<OfflineGraph*> {
+    typedef OfflineNode NodeType;
+    typedef OfflineGraph::OfflineNodeVector::iterator ChildIteratorType;
+    typedef OfflineGraph::OfflineNodeVector::iterator nodes_iterator;
+
+    static inline ChildIteratorType direct_child_begin(NodeType* N) {
+        return N->succs.begin();
+    }
+    static inline ChildIteratorType direct_child_end(NodeType* N) {
+        return N->succs.end();
+    }
+    static inline nodes_iterator nodes_begin(OfflineGraph* G) {
+        return G->nodes.begin();
+    }
+    static inline nodes_iterator nodes_end(OfflineGraph* G) {
+        return G->nodes.end();
+    }
+    static inline NodeType* getNode(OfflineGraph* G, NodeID id) {
+        return G->idToNode[id];
+    }
+    static inline unsigned getNodeID(NodeType* N) {
+        return N->id;
+    }
+};
+}
+
+typedef SCCDetection<OfflineGraph*> OfflineSCC;
+
+std::string Andersen::getOptionKey() {
+    std::string key = PointerAnalysis::getOptionKey();
+    key += AnderHVN ? " ander-hvn=1" : " ander-hvn=0";
+    key += AnderHCD ? " ander-hcd=1" : " ander-hcd=0";
+    return key;
+}
+
+/*!
+ * Reduce the constraint graph before solving
+ */
+void Andersen::reduceConstraintGraph() {
+    offlineMergedNodes.clear();
+    hcdCycles.clear();
+
+    double start = stat->getClk();
+
+    if (AnderHVN)
+        mergeEquivalentNodes();
+
+    if (AnderHCD && usesHCDCycles())
+        findHCDCycles();
+
+    double end = stat->getClk();
+    timeOfOfflineReduction += (end - start) / TIMEINTERVAL;
+}
+
+/*!
+ * Label the nodes in topological order of the direct and load edges and merge the nodes
+ * with the same label. Label 0 is an empty points-to set.
+ */
+void Andersen::mergeEquivalentNodes() {
+    OfflineGraph graph;
+    for (ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it) {
+        NodeID id = it->first;
+        ConstraintNode* node = it->second;
+        graph.addNode(id);
+        for (ConstraintNode::const_iterator edgeIt = node->directOutEdgeBegin(), edgeEit = node->directOutEdgeEnd();
+                edgeIt != edgeEit; ++edgeIt)
+            graph.addEdge(id, (*edgeIt)->getDstID());
+        for (ConstraintNode::const_iterator edgeIt = node->outgoingLoadsBegin(), edgeEit = node->outgoingLoadsEnd();
+                edgeIt != edgeEit; ++edgeIt)
+            graph.addEdge(id, (*edgeIt)->getDstID());
+    }
+
+    OfflineSCC scc(&graph);
+    scc.find();
+
+    /// nodes whose points-to sets do not only come from the edges on the graph now
+    NodeBS indirectNodes;
+    for (ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it) {
+        const PAGNode* pagNode = pag->getPAGNode(it->first);
+        if (isa<ObjPN>(pagNode) || isa<VarArgPN>(pagNode))
+            indirectNodes.set(it->first);
+    }
+    for (PAG::FunToArgsListMap::iterator it = pag->getFunArgsMap().begin(), eit = pag->getFunArgsMap().end(); it != eit; ++it) {
+        for (PAG::PAGNodeList::const_iterator argIt = it->second.begin(), argEit = it->second.end(); argIt != argEit; ++argIt)
+            indirectNodes.set((*argIt)->getId());
+    }
+    const CallSiteToFunPtrMap& callsites = getIndirectCallsites();
+    for (CallSiteToFunPtrMap::const_iterator it = callsites.begin(), eit = callsites.end(); it != eit; ++it) {
+        if (pag->callsiteHasRet(it->first))
+            indirectNodes.set(pag->getCallSiteRet(it->first)->getId());
+    }
+
+    std::vector<u32_t> labels(graph.idToNode.size(), 0);
+    u32_t lastLabel = 0;
+    NodeToNodeMap addrLabels;
+    NodeToNodeMap loadLabels;
+    NodeToNodeMap variantGepLabels;
+    std::map<std::pair<u32_t, LocationSet>, u32_t> normalGepLabels;
+    std::map<std::vector<u32_t>, u32_t> unionLabels;
+
+    NodeStack& topoOrder = scc.topoNodeStack();
+    while (!topoOrder.empty()) {
+        NodeID rep = topoOrder.top();
+        topoOrder.pop();
+        const NodeBS& members = scc.subNodes(rep);
+
+        /// a cycle of copy edges shares one points-to set, a cycle through a gep or load edge does not
+        bool copyCycle = true;
+        bool indirect = false;
+        std::vector<u32_t> inputs;
+        for (NodeBS::iterator it = members.begin(), eit = members.end(); it != eit; ++it) {
+            ConstraintNode* node = consCG->getConstraintNode(*it);
+            if (indirectNodes.test(*it))
+                indirect = true;
+
+            for (ConstraintNode::const_iterator edgeIt = node->incomingAddrsBegin(), edgeEit = node->incomingAddrsEnd();
+                    edgeIt != edgeEit; ++edgeIt) {
+                std::pair<NodeToNodeMap::iterator, bool> res = addrLabels.insert(std::make_pair((*edgeIt)->getSrcID(), 0));
+                if (res.second)
+                    res.first->second = ++lastLabel;
+                inputs.push_back(res.first->second);
+            }
+
+            for (ConstraintNode::const_iterator edgeIt = node->directInEdgeBegin(), edgeEit = node->directInEdgeEnd();
+                    edgeIt != edgeEit; ++edgeIt) {
+                NodeID src = (*edgeIt)->getSrcID();
+                if (scc.repNode(src) == rep) {
+                    if (isa<GepCGEdge>(*edgeIt))
+                        copyCycle = false;
+                    continue;
+                }
+                u32_t srcLabel = labels[src];
+                if (srcLabel == 0)
+                    continue;
+                if (const NormalGepCGEdge* gep = dyn_cast<NormalGepCGEdge>(*edgeIt)) {
+                    u32_t& label = normalGepLabels[std::make_pair(srcLabel, gep->getLocationSet())];
+                    if (label == 0)
+                        label = ++lastLabel;
+                    inputs.push_back(label);
+                }
+                else if (isa<VariantGepCGEdge>(*edgeIt)) {
+                    NodeID& label = variantGepLabels[srcLabel];
+                    if (label == 0)
+                        label = ++lastLabel;
+                    inputs.push_back(label);
+                }
+                else
+                    inputs.push_back(srcLabel);
+            }
+
+            for (ConstraintNode::const_iterator edgeIt = node->incomingLoadsBegin(), edgeEit = node->incomingLoadsEnd();
+                    edgeIt != edgeEit; ++edgeIt) {
+                NodeID src = (*edgeIt)->getSrcID();
+                if (scc.repNode(src) == rep) {
+                    copyCycle = false;
+                    continue;
+                }
+                if (labels[src] == 0)
+                    continue;
+                NodeID& label = loadLabels[labels[src]];
+                if (label == 0)
+                    label = ++lastLabel;
+                inputs.push_back(label);
+            }
+        }
+
+        if (!copyCycle) {
+            for (NodeBS::iterator it = members.begin(), eit = members.end(); it != eit; ++it)
+                labels[*it] = ++lastLabel;
+            continue;
+        }
+
+        u32_t label = 0;
+        if (indirect)
+            label = ++lastLabel;
+        else {
+            std::sort(inputs.begin(), inputs.end());
+            inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+            if (inputs.size() == 1)
+                label = inputs.front();
+            else if (inputs.size() > 1) {
+                u32_t& unionLabel = unionLabels[inputs];
+                if (unionLabel == 0)
+                    unionLabel = ++lastLabel;
+                label = unionLabel;
+            }
+        }
+        for (NodeBS::iterator it = members.begin(), eit = members.end(); it != eit; ++it)
+            labels[*it] = label;
+    }
+
+    /// the node with the smallest id of each label is the rep
+    NodeToNodeMap labelToRep;
+    for (NodeID id = 0; id < labels.size(); id++) {
+        if (labels[id] == 0)
+            continue;
+        std::pair<NodeToNodeMap::iterator, bool> res = labelToRep.insert(std::make_pair(labels[id], id));
+        if (res.second)
+            continue;
+        NodeID rep = res.first->second;
+        mergeNodeToRep(id, rep);
+        offlineMergedNodes.set(id);
+        offlineMergedNodes.set(rep);
+        numOfOfflineMergedNodes++;
+    }
+}
+
+/*!
+ * Detect SCCs on the graph of copy edges and dereferences, where a load p --load--> a
+ * is *p --> a and a store b --store--> p is b --> *p. The ref node of p is the node
+ * numbered p + the number of PAG nodes.
+ */
+void Andersen::findHCDCycles() {
+    NodeID refBase = pag->getTotalNodeNum();
+
+    OfflineGraph graph;
+    for (ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it) {
+        NodeID id = it->first;
+        ConstraintNode* node = it->second;
+        for (ConstraintNode::const_iterator edgeIt = node->directOutEdgeBegin(), edgeEit = node->directOutEdgeEnd();
+                edgeIt != edgeEit; ++edgeIt) {
+            if (isa<CopyCGEdge>(*edgeIt))
+                graph.addEdge(id, (*edgeIt)->getDstID());
+        }
+        for (ConstraintNode::const_iterator edgeIt = node->outgoingLoadsBegin(), edgeEit = node->outgoingLoadsEnd();
+                edgeIt != edgeEit; ++edgeIt)
+            graph.addEdge(refBase + id, (*edgeIt)->getDstID());
+        for (ConstraintNode::const_iterator edgeIt = node->incomingStoresBegin(), edgeEit = node->incomingStoresEnd();
+                edgeIt != edgeEit; ++edgeIt)
+            graph.addEdge((*edgeIt)->getSrcID(), refBase + id);
+    }
+
+    OfflineSCC scc(&graph);
+    scc.find();
+
+    for (OfflineGraph::OfflineNodeVector::const_iterator it = graph.nodes.begin(), eit = graph.nodes.end(); it != eit; ++it) {
+        NodeID rep = (*it)->id;
+        if (scc.repNode(rep) != rep || !scc.isInCycle(rep))
+            continue;
+
+        /// with two dereferences on a cycle, o in pts(p) is only on it if the other pointer points to something
+        NodeID ptr = 0;
+        NodeID cycleNode = 0;
+        u32_t numOfDerefs = 0;
+        u32_t numOfVars = 0;
+        const NodeBS& members = scc.subNodes(rep);
+        for (NodeBS::iterator mit = members.begin(), emit = members.end(); mit != emit; ++mit) {
+            if (*mit >= refBase) {
+                ptr = *mit - refBase;
+                numOfDerefs++;
+            }
+            else if (numOfVars++ == 0)
+                cycleNode = *mit;
+        }
+        if (numOfDerefs == 1 && numOfVars > 0)
+            hcdCycles[ptr].set(cycleNode);
+    }
+}
+
+/*!
+ * Merge each object pointed by nodeId into the cycles found offline through *nodeId.
+ * There is more than one cycle if nodes with their own cycles were merged into nodeId,
+ * an object pointed by nodeId is on each of them, so they are merged into one as well.
+ * nodeId is being processed, it is kept as a rep.
+ */
+void Andersen::mergeHCDCycle(NodeID nodeId) {
+    NodeToNodeBSMap::const_iterator it = hcdCycles.find(nodeId);
+    if (it == hcdCycles.end())
+        return;
+
+    /// collect the targets first, merging changes the points-to set of nodeId if it is on a cycle
+    NodeBS targets;
+    const PointsTo& pts = getConstPts(nodeId);
+    for (PointsTo::iterator pit = pts.begin(), epit = pts.end(); pit != epit; ++pit) {
+        /// loads and stores ignore these objects, they are not on the cycle
+        if (!pag->isConstantObj(*pit) && !isNonPointerObj(*pit))
+            targets.set(*pit);
+    }
+    if (targets.empty())
+        return;
+    targets |= it->second;
+
+    NodeID cycleRep = sccRepNode(it->second.find_first());
+    bool merged = false;
+    for (NodeBS::iterator tit = targets.begin(), etit = targets.end(); tit != etit; ++tit) {
+        NodeID objRep = sccRepNode(*tit);
+        if (objRep == cycleRep)
+            continue;
+        if (objRep == nodeId) {
+            mergeNodeToRep(cycleRep, nodeId);
+            cycleRep = nodeId;
+        }
+        else
+            mergeNodeToRep(objRep, cycleRep);
+        merged = true;
+        numOfHCDMerges++;
+    }
+
+    if (merged) {
+        pushIntoWorklist(cycleRep);
+        if (incSCC)
+            incSCC->invalidate();
+    }
+}
+
+/*!
+ * Whether an added PAG edge adds points-to targets to a node merged offline.
+ * A store adds targets to the objects its pointer points to, which are never merged offline.
+ */
+bool Andersen::hasOfflineMergedDst(const PAGEdge::PAGEdgeSetTy& edges) const {
+    if (offlineMergedNodes.empty())
+        return false;
+
+    for (PAGEdge::PAGEdgeSetTy::const_iterator it = edges.begin(), eit = edges.end(); it != eit; ++it) {
+        if ((*it)->getEdgeKind() != PAGEdge::Store && offlineMergedNodes.test((*it)->getDstID()))
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,252 @@
+//===- AndersenParallel.cpp -- Parallel work-stealing Andersen's analysis------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenParallel.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "WPA/Andersen.h"
+#include "Util/AnalysisUtil.h"
+
+#include <llvm/Support/CommandLine.h> // for tool output file
+#include <thread>
+
+using namespace llvm;
+using namespace analysisUtil;
+
+static cl::opt<unsigned> ParallelThreads("pander-threads", cl::init(0),
+        cl::desc("Number of worker threads of parallel Andersen (0: hardware concurrency)"));
+
+static cl::opt<bool> ParallelVerify("pander-verify", cl::init(false),
+                                    cl::desc("Compare the points-to sets of parallel Andersen with a sequential solve from scratch"));
+
+AndersenParallel* AndersenParallel::parAndersen = NULL;
+
+/*!
+ * Constructor
+ */
+AndersenParallel::AndersenParallel(PTATY type)
+    : Andersen(type), ptsLocks(new std::mutex[NumOfPtsLocks]), inDequeSize(0), pendingNodes(0), sequential(false) {
+    numOfThreads = ParallelThreads;
+    if (numOfThreads == 0)
+        numOfThreads = std::thread::hardware_concurrency();
+    if (numOfThreads == 0)
+        numOfThreads = 1;
+
+    for (u32_t i = 0; i < numOfThreads; i++)
+        deques.push_back(std::unique_ptr<WorkDeque>(new WorkDeque()));
+    processedNodes.resize(numOfThreads);
+    processedCopys.resize(numOfThreads, 0);
+}
+
+/*!
+ * Solve constraints round by round.
+ * (1) copy edges are processed in parallel until the frontier is exhausted;
+ * (2) addr/load/store/gep edges of every processed node are handled in sequential,
+ *     nodes whose points-to sets are changed form the frontier of the next round.
+ */
+void AndersenParallel::solve() {
+    if (sequential) {
+        Andersen::solve();
+        return;
+    }
+
+    /// Merge SCCs and get the initial frontier in topological order
+    NodeStack& nodeStack = SCCDetect();
+    NodeVector frontier;
+    while (!nodeStack.empty()) {
+        frontier.push_back(nodeStack.top());
+        nodeStack.pop();
+    }
+
+    while (!frontier.empty()) {
+        numOfIteration++;
+        if (0 == numOfIteration % OnTheFlyIterBudgetForStat) {
+            dumpStat();
+        }
+
+        NodeBS processed;
+        {
+            ProfileScope prof("copyGep", &timeOfProcessCopyGep);
+            parallelPropagate(frontier, processed);
+        }
+
+        {
+            ProfileScope prof("loadStore", &timeOfProcessLoadStore);
+            for (NodeBS::iterator it = processed.begin(), eit = processed.end(); it != eit; ++it)
+                processNodeIndirect(*it);
+        }
+
+        frontier.clear();
+        while (!isWorklistEmpty())
+            frontier.push_back(popFromWorklist());
+    }
+}
+
+/*!
+ * The sequential results are kept after the verification
+ */
+void AndersenParallel::finalize() {
+    if (ParallelVerify) {
+        sequential = true;
+        verifyWithSolveFromScratch("parallel solve");
+        sequential = false;
+    }
+    Andersen::finalize();
+}
+
+/*!
+ * Make sure every rep node on the constraint graph has its points-to entry
+ */
+void AndersenParallel::preparePtsMap() {
+    for (ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it)
+        getPts(it->first);
+
+    /// New field objects may be created during gep processing, node IDs are dense.
+    u32_t size = getPAG()->getTotalNodeNum();
+    if (size > inDequeSize) {
+        inDeque.reset(new std::atomic<bool>[size]);
+        inDequeSize = size;
+    }
+    for (u32_t i = 0; i < inDequeSize; i++)
+        inDeque[i] = false;
+}
+
+/*!
+ * Propagate along copy edges from the frontier using all workers
+ */
+void AndersenParallel::parallelPropagate(const NodeVector& frontier, NodeBS& processed) {
+    preparePtsMap();
+
+    /// distribute the frontier over the deques in round-robin
+    u32_t tid = 0;
+    for (NodeVector::const_iterator it = frontier.begin(), eit = frontier.end(); it != eit; ++it) {
+        pushIntoDeque(tid, sccRepNode(*it));
+        tid = (tid + 1) % numOfThreads;
+    }
+
+    std::vector<std::thread> workers;
+    for (u32_t i = 1; i < numOfThreads; i++)
+        workers.push_back(std::thread(&AndersenParallel::runWorker, this, i));
+    runWorker(0);
+    for (u32_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+
+    for (u32_t i = 0; i < numOfThreads; i++) {
+        NodeVector& nodes = processedNodes[i];
+        for (NodeVector::const_iterator it = nodes.begin(), eit = nodes.end(); it != eit; ++it)
+            processed.set(*it);
+        nodes.clear();
+        numOfProcessedCopy += processedCopys[i];
+        processedCopys[i] = 0;
+    }
+}
+
+/*!
+ * Worker loop: pop from its own deque, otherwise steal from others.
+ * Exit when no pushed node is left unprocessed.
+ */
+void AndersenParallel::runWorker(u32_t tid) {
+    ProfileScope prof("copyWorker");
+    Profiler::Count numOfNodes = 0;
+    while (true) {
+        NodeID nodeId;
+        bool found = deques[tid]->pop(nodeId);
+        for (u32_t i = 1; !found && i < numOfThreads; i++)
+            found = deques[(tid + i) % numOfThreads]->steal(nodeId);
+
+        if (found) {
+            inDeque[nodeId] = false;
+            processNodeCopys(tid, nodeId);
+            numOfNodes++;
+            pendingNodes--;
+        }
+        else if (pendingNodes == 0)
+            break;
+        else
+            std::this_thread::yield();
+    }
+    Profiler::addCount("ander.parallelNodes", numOfNodes);
+}
+
+/*!
+ * Process copy edges of a node.
+ * Source points-to set is copied under its lock first, so that at most one lock is held at a time.
+ * Reverse points-to is updated afterwards in processNodeIndirect().
+ */
+void AndersenParallel::processNodeCopys(u32_t tid, NodeID nodeId) {
+    processedNodes[tid].push_back(nodeId);
+
+    ConstraintNode* node = consCG->getConstraintNode(nodeId);
+    PointsTo srcPts;
+    {
+        std::lock_guard<std::mutex> guard(getPtsLock(nodeId));
+        srcPts = getPts(nodeId);
+    }
+    if (srcPts.empty())
+        return;
+
+    for (ConstraintNode::const_iterator it = node->directOutEdgeBegin(), eit =
+                node->directOutEdgeEnd(); it != eit; ++it) {
+        if (isa<CopyCGEdge>(*it) == false)
+            continue;
+
+        processedCopys[tid]++;
+        NodeID dst = sccRepNode((*it)->getDstID());
+        bool changed = false;
+        {
+            std::lock_guard<std::mutex> guard(getPtsLock(dst));
+            changed = (getPts(dst) |= srcPts);
+        }
+        if (changed)
+            pushIntoDeque(tid, dst);
+    }
+}
+
+/*!
+ * Handle addr/load/store/gep constraints of a node in sequential.
+ * Nodes changed here are pushed into the solver's worklist for the next round.
+ */
+void AndersenParallel::processNodeIndirect(NodeID nodeId) {
+    getPTDataTy()->updateRevPts(nodeId);
+
+    ConstraintNode* node = consCG->getConstraintNode(nodeId);
+
+    for (ConstraintNode::const_iterator it = node->outgoingAddrsBegin(), eit =
+                node->outgoingAddrsEnd(); it != eit; ++it) {
+        processAddr(cast<AddrCGEdge>(*it));
+    }
+
+    const PointsTo& pts = getConstPts(nodeId);
+    for (PointsTo::iterator piter = pts.begin(), epiter = pts.end(); piter != epiter; ++piter) {
+        NodeID ptd = *piter;
+        // handle load
+        for (ConstraintNode::const_iterator it = node->outgoingLoadsBegin(),
+                eit = node->outgoingLoadsEnd(); it != eit; ++it) {
+            if (processLoad(ptd, *it))
+                pushIntoWorklist(ptd);
+        }
+
+        // handle store
+        for (ConstraintNode::const_iterator it = node->incomingStoresBegin(),
+                eit = node->incomingStoresEnd(); it != eit; ++it) {
+            if (processStore(ptd, *it))
+                pushIntoWorklist((*it)->getSrcID());
+        }
+    }
+
+    // handle gep, copy edges have been handled by the workers
+    for (ConstraintNode::const_iterator it = node->directOutEdgeBegin(), eit =
+                node->directOutEdgeEnd(); it != eit; ++it) {
+        if (GepCGEdge* gepEdge = dyn_cast<GepCGEdge>(*it))
+            processGep(nodeId, gepEdge);
+    }
+}
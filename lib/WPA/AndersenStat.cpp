@@ -15,6 +15,7 @@
  */
 #include "WPA/WPAStat.h"
 #include "WPA/Andersen.h"
+#include "Util/Profiler.h"
 
 using namespace llvm;
 using namespace analysisUtil;
@@ -50,7 +51,7 @@ void AndersenStat::collectCycleInfo(ConstraintGraph* consCG) {
     for(ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it!=eit; ++it) {
         // sub nodes have been removed from the constraint graph, only rep nodes are left.
         NodeID repNode = consCG->sccRepNode(it->first);
-        NodeBS& subNodes = pta->sccSubNodes(repNode);
+        NodeBS subNodes = pta->sccSubNodes(repNode);
         NodeBS clone = subNodes;
         for (NodeBS::iterator it = subNodes.begin(), eit = subNodes.end(); it != eit; ++it) {
             NodeID nodeId = *it;
@@ -89,7 +90,7 @@ void AndersenStat::statNullPtr() {
         PAGEdge::PAGEdgeSetTy& outGoingLoad = pagNode->getOutgoingEdges(PAGEdge::Load);
         if (inComingStore.empty()==false || outGoingLoad.empty()==false) {
             ///TODO: change the condition here to fetch the points-to set
-            PointsTo& pts = pta->getPts(pagNodeId);
+            const PointsTo& pts = pta->getConstPts(pagNodeId);
             if(pta->containBlackHoleNode(pts)) {
                 _NumOfConstantPtr++;
             }
@@ -163,7 +164,7 @@ void AndersenStat::performStat() {
     for (PAG::iterator iter = pta->getPAG()->begin(), eiter = pta->getPAG()->end();
             iter != eiter; ++iter) {
         NodeID node = iter->first;
-        PointsTo& pts = pta->getPts(node);
+        const PointsTo& pts = pta->getConstPts(node);
         u32_t size = pts.count();
         totalPointers++;
         totalPtsSize+=size;
@@ -185,9 +186,13 @@ void AndersenStat::performStat() {
     timeStatMap[SCCMergeTime] =  Andersen::timeOfSCCMerges;
     timeStatMap[CollapseTime] =  Andersen::timeOfCollapse;
 
-    timeStatMap[ProcessLoadStoreTime] =  Andersen::timeOfProcessLoadStore;
-    timeStatMap[ProcessCopyGepTime] =  Andersen::timeOfProcessCopyGep;
+    /// per-node times are only taken with -profile
+    if (Profiler::isEnabled()) {
+        timeStatMap[ProcessLoadStoreTime] =  Andersen::timeOfProcessLoadStore;
+        timeStatMap[ProcessCopyGepTime] =  Andersen::timeOfProcessCopyGep;
+    }
     timeStatMap[UpdateCallGraphTime] =  Andersen::timeOfUpdateCallGraph;
+    timeStatMap["OfflineReductionTime"] =  Andersen::timeOfOfflineReduction;
 
     PTNumStatMap[TotalNumOfPointers] = pag->getValueNodeNum() + pag->getFieldValNodeNum();
     PTNumStatMap[TotalNumOfObjects] = pag->getObjectNodeNum() + pag->getFieldObjNodeNum();
@@ -226,6 +231,9 @@ void AndersenStat::performStat() {
     PTNumStatMap[NumOfIndirectEdgeSolved] = pta->getNumOfResolvedIndCallEdge();
 
     PTNumStatMap[NumOfSCCDetection] = Andersen::numOfSCCDetection;
+    PTNumStatMap["NumOfIncSCCDetect"] = Andersen::numOfIncSCCDetection;
+    PTNumStatMap["NumOfOfflineMerged"] = Andersen::numOfOfflineMergedNodes;
+    PTNumStatMap["NumOfHCDMerges"] = Andersen::numOfHCDMerges;
     PTNumStatMap[NumOfCycles] = _NumOfCycles;
     PTNumStatMap[NumOfPWCCycles] = _NumOfPWCCycles;
     PTNumStatMap[NumOfNodesInCycles] = _NumOfNodesInCycles;
@@ -241,8 +249,8 @@ void AndersenStat::performStat() {
 /*!
  * Print all statistics
  */
-void AndersenStat::printStat() {
+void AndersenStat::printStat(std::string statname) {
 
     std::cout << "\n****Andersen Pointer Analysis Statistics****\n";
-    PTAStat::printStat();
+    PTAStat::printStat("Andersen");
 }
@@ -16,6 +16,7 @@
 
 #include "WPA/Andersen.h"
 #include "Util/AnalysisUtil.h"
+#include "Util/Profiler.h"
 
 #include <llvm/Support/CommandLine.h> // for tool output file
 using namespace llvm;
@@ -28,7 +29,7 @@ AndersenWave* AndersenWave::waveAndersen = NULL;
  */
 void AndersenWave::processNode(NodeID nodeId)
 {
-    double propStart = stat->getClk();
+    ProfileScope prof("copyGep", &timeOfProcessCopyGep);
 
     // If this is a PWC node, collapse all its points-to targets.
     // collapseNodePts() may change the points-to set of the nodes which have been processed
@@ -53,8 +54,6 @@ void AndersenWave::processNode(NodeID nodeId)
         if (collapseField(nodeId))
             reanalyze = true;
     }
-    double propEnd = stat->getClk();
-    timeOfProcessCopyGep += (propEnd - propStart) / TIMEINTERVAL;
 }
 
 /*!
@@ -62,7 +61,7 @@ void AndersenWave::processNode(NodeID nodeId)
  */
 void AndersenWave::postProcessNode(NodeID nodeId)
 {
-    double insertStart = stat->getClk();
+    ProfileScope prof("loadStore", &timeOfProcessLoadStore);
 
     ConstraintNode* node = consCG->getConstraintNode(nodeId);
 
@@ -78,9 +77,6 @@ void AndersenWave::postProcessNode(NodeID nodeId)
         if (handleStore(nodeId, *it))
             reanalyze = true;
     }
-
-    double insertEnd = stat->getClk();
-    timeOfProcessLoadStore += (insertEnd - insertStart) / TIMEINTERVAL;
 }
 
 /*!
@@ -104,8 +100,8 @@ void AndersenWave::handleCopyGep(ConstraintNode* node)
 bool AndersenWave::handleLoad(NodeID nodeId, const ConstraintEdge* edge)
 {
     bool changed = false;
-    for (PointsTo::iterator piter = getPts(nodeId).begin(), epiter = getPts(nodeId).end();
-            piter != epiter; ++piter) {
+    const PointsTo& pts = getConstPts(nodeId);
+    for (PointsTo::iterator piter = pts.begin(), epiter = pts.end(); piter != epiter; ++piter) {
         if (processLoad(*piter, edge)) {
             changed = true;
         }
@@ -119,8 +115,8 @@ bool AndersenWave::handleLoad(NodeID nodeId, const ConstraintEdge* edge)
 bool AndersenWave::handleStore(NodeID nodeId, const ConstraintEdge* edge)
 {
     bool changed = false;
-    for (PointsTo::iterator piter = getPts(nodeId).begin(), epiter = getPts(nodeId).end();
-            piter != epiter; ++piter) {
+    const PointsTo& pts = getConstPts(nodeId);
+    for (PointsTo::iterator piter = pts.begin(), epiter = pts.end(); piter != epiter; ++piter) {
         if (processStore(*piter, edge)) {
             changed = true;
         }
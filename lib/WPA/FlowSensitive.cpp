@@ -17,6 +17,7 @@
 #include "WPA/WPAStat.h"
 #include "WPA/FlowSensitive.h"
 #include "WPA/Andersen.h"
+#include "Util/Profiler.h"
 #include <llvm/Support/Debug.h>		// DEBUG TYPE
 
 using namespace llvm;
@@ -29,6 +30,7 @@ FlowSensitive* FlowSensitive::fspta = NULL;
  */
 void FlowSensitive::initialize(llvm::Module& module) {
     PointerAnalysis::initialize(module);
+    disableAliasCache();
 
     AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(module);
     svfg = new SVFGOPT(getPTACallGraph());
@@ -43,6 +45,8 @@ void FlowSensitive::initialize(llvm::Module& module) {
  * Start analysis
  */
 void FlowSensitive::analyze(llvm::Module& module) {
+    ProfileScope prof("FlowSensitive");
+
     /// Initialization for the Solver
     initialize(module);
 
@@ -93,7 +97,7 @@ void FlowSensitive::finalize()
         }
     }
 
-    PointerAnalysis::finalize();
+    BVDataPTAImpl::finalize();
 }
 
 /*!
@@ -101,11 +105,8 @@ void FlowSensitive::finalize()
  */
 NodeStack& FlowSensitive::SCCDetect()
 {
-    double start = stat->getClk();
-    NodeStack& nodeStack = WPASVFGFSSolver::SCCDetect();
-    double end = stat->getClk();
-    sccTime += (end - start) / TIMEINTERVAL;
-    return nodeStack;
+    ProfileScope prof("sccDetect", &sccTime, true);
+    return WPASVFGFSSolver::SCCDetect();
 }
 
 /*!
@@ -124,7 +125,7 @@ void FlowSensitive::processNode(NodeID nodeId) {
  */
 bool FlowSensitive::processSVFGNode(SVFGNode* node)
 {
-    double start = stat->getClk();
+    ProfileScope prof("processNode", &processTime);
     bool changed = false;
     if(AddrSVFGNode* addr = dyn_cast<AddrSVFGNode>(node)) {
         numOfProcessedAddr++;
@@ -170,9 +171,6 @@ bool FlowSensitive::processSVFGNode(SVFGNode* node)
     else
         assert(false && "unexpected kind of SVFG nodes");
 
-    double end = stat->getClk();
-    processTime += (end - start) / TIMEINTERVAL;
-
     return changed;
 }
 
@@ -185,7 +183,7 @@ bool FlowSensitive::processSVFGNode(SVFGNode* node)
  *    IN set has been updated.
  */
 bool FlowSensitive::propFromSrcToDst(SVFGEdge* edge) {
-    double start = stat->getClk();
+    ProfileScope prof("propagate", &propagationTime);
     bool changed = false;
 
     if (DirectSVFGEdge* dirEdge = dyn_cast<DirectSVFGEdge>(edge))
@@ -195,8 +193,6 @@ bool FlowSensitive::propFromSrcToDst(SVFGEdge* edge) {
     else
         assert(false && "new kind of svfg edge?");
 
-    double end = stat->getClk();
-    propagationTime += (end - start) /TIMEINTERVAL;
     return changed;
 }
 
@@ -205,7 +201,7 @@ bool FlowSensitive::propFromSrcToDst(SVFGEdge* edge) {
  */
 bool FlowSensitive::propAlongDirectEdge(const DirectSVFGEdge* edge)
 {
-    double start = stat->getClk();
+    ProfileScope prof("direct", &directPropaTime);
     bool changed = false;
 
     SVFGNode* src = edge->getSrcNode();
@@ -224,8 +220,6 @@ bool FlowSensitive::propAlongDirectEdge(const DirectSVFGEdge* edge)
         changed = true;
     }
 
-    double end = stat->getClk();
-    directPropaTime += (end - start) / TIMEINTERVAL;
     return changed;
 }
 
@@ -266,7 +260,7 @@ bool FlowSensitive::propagateFromFRToAR(const FormalRetSVFGNode* fr, const SVFGN
  */
 bool FlowSensitive::propAlongIndirectEdge(const IndirectSVFGEdge* edge)
 {
-    double start = stat->getClk();
+    ProfileScope prof("indirect", &indirectPropaTime);
 
     SVFGNode* src = edge->getSrcNode();
     SVFGNode* dst = edge->getDstNode();
@@ -293,8 +287,6 @@ bool FlowSensitive::propAlongIndirectEdge(const IndirectSVFGEdge* edge)
         }
     }
 
-    double end = stat->getClk();
-    indirectPropaTime += (end - start) / TIMEINTERVAL;
     return changed;
 }
 
@@ -319,15 +311,13 @@ bool FlowSensitive::propVarPtsFromSrcToDst(NodeID var, const SVFGNode* src, cons
  * Process address node
  */
 bool FlowSensitive::processAddr(const AddrSVFGNode* addr) {
-    double start = stat->getClk();
+    ProfileScope prof("addr", &addrTime);
     NodeID srcID = addr->getPAGSrcNodeID();
     /// TODO: If this object has been set as field-insensitive, just
     ///       add the insensitive object node into dst pointer's pts.
     if (isFieldInsensitive(srcID))
         srcID = getFIObjNode(srcID);
     bool changed = addPts(addr->getPAGDstNodeID(), srcID);
-    double end = stat->getClk();
-    addrTime += (end - start) / TIMEINTERVAL;
     return changed;
 }
 
@@ -335,11 +325,8 @@ bool FlowSensitive::processAddr(const AddrSVFGNode* addr) {
  * Process copy node
  */
 bool FlowSensitive::processCopy(const CopySVFGNode* copy) {
-    double start = stat->getClk();
-    bool changed = unionPts(copy->getPAGDstNodeID(), copy->getPAGSrcNodeID());
-    double end = stat->getClk();
-    copyGepTime += (end - start) / TIMEINTERVAL;
-    return changed;
+    ProfileScope prof("copy", &copyGepTime);
+    return unionPts(copy->getPAGDstNodeID(), copy->getPAGSrcNodeID());
 }
 
 /*!
@@ -361,7 +348,7 @@ bool FlowSensitive::processPhi(const PHISVFGNode* phi) {
  * Process gep node
  */
 bool FlowSensitive::processGep(const GepSVFGNode* edge) {
-    double start = stat->getClk();
+    ProfileScope prof("gep", &copyGepTime);
     bool changed = false;
     const PointsTo& srcPts = getPts(edge->getPAGSrcNodeID());
 
@@ -387,8 +374,6 @@ bool FlowSensitive::processGep(const GepSVFGNode* edge) {
     if (unionPts(edge->getPAGDstNodeID(), tmpDstPts))
         changed = true;
 
-    double end = stat->getClk();
-    copyGepTime += (end - start) / TIMEINTERVAL;
     return changed;
 }
 
@@ -400,7 +385,7 @@ bool FlowSensitive::processGep(const GepSVFGNode* edge) {
  * pts(dst) = union pts(node)
  */
 bool FlowSensitive::processLoad(const LoadSVFGNode* load) {
-    double start = stat->getClk();
+    ProfileScope prof("load", &loadTime);
     bool changed = false;
 
     NodeID dstVar = load->getPAGDstNodeID();
@@ -427,8 +412,6 @@ bool FlowSensitive::processLoad(const LoadSVFGNode* load) {
         }
     }
 
-    double end = stat->getClk();
-    loadTime += (end - start) / TIMEINTERVAL;
     return changed;
 }
 
@@ -451,10 +434,10 @@ bool FlowSensitive::processStore(const StoreSVFGNode* store) {
     if (dstPts.empty())
         return false;
 
-    double start = stat->getClk();
     bool changed = false;
 
     if(getPts(store->getPAGSrcNodeID()).empty() == false) {
+        ProfileScope prof("store", &storeTime);
         for (PointsTo::iterator it = dstPts.begin(), eit = dstPts.end(); it != eit; ++it) {
             NodeID ptd = *it;
 
@@ -466,10 +449,7 @@ bool FlowSensitive::processStore(const StoreSVFGNode* store) {
         }
     }
 
-    double end = stat->getClk();
-    storeTime += (end - start) / TIMEINTERVAL;
-
-    double updateStart = stat->getClk();
+    ProfileScope prof("strongWeakUpdate", &updateTime);
     // also merge the DFInSet to DFOutSet.
     /// check if this is a strong updates store
     NodeID singleton;
@@ -484,8 +464,6 @@ bool FlowSensitive::processStore(const StoreSVFGNode* store) {
         if (weakUpdateOutFromIn(store))
             changed = true;
     }
-    double updateEnd = stat->getClk();
-    updateTime += (updateEnd - updateStart) / TIMEINTERVAL;
 
     return changed;
 }
@@ -518,7 +496,7 @@ bool FlowSensitive::isStrongUpdate(const SVFGNode* node, NodeID& singleton) {
  */
 bool FlowSensitive::updateCallGraph(const CallSiteToFunPtrMap& callsites)
 {
-    double start = stat->getClk();
+    ProfileScope prof("updateCallGraph", &updateCallGraphTime, true);
     CallEdgeMap newEdges;
     onTheFlyCallGraphSolve(callsites, newEdges);
 
@@ -527,8 +505,6 @@ bool FlowSensitive::updateCallGraph(const CallSiteToFunPtrMap& callsites)
 
     updateConnectedNodes(svfgEdges);
 
-    double end = stat->getClk();
-    updateCallGraphTime += (end - start) / TIMEINTERVAL;
     return (!newEdges.empty());
 }
 
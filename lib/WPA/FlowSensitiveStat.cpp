@@ -17,6 +17,7 @@
 #include "WPA/WPAStat.h"
 #include "Util/AnalysisUtil.h"
 #include "WPA/FlowSensitive.h"
+#include "Util/Profiler.h"
 
 using namespace llvm;
 using namespace analysisUtil;
@@ -119,15 +120,18 @@ void FlowSensitiveStat::performStat()
     timeStatMap[TotalAnalysisTime] = (endTime - startTime)/TIMEINTERVAL;
     timeStatMap["SolveTime"] = fspta->solveTime;
     timeStatMap["SCCTime"] = fspta->sccTime;
-    timeStatMap["ProcessTime"] = fspta->processTime;
-    timeStatMap["PropagationTime"] = fspta->propagationTime;
-    timeStatMap["DirectPropaTime"] = fspta->directPropaTime;
-    timeStatMap["IndirectPropaTime"] = fspta->indirectPropaTime;
-    timeStatMap["Strong/WeakUpdTime"] = fspta->updateTime;
-    timeStatMap["AddrTime"] = fspta->addrTime;
-    timeStatMap["CopyGepTime"] = fspta->copyGepTime;
-    timeStatMap["LoadTime"] = fspta->loadTime;
-    timeStatMap["StoreTime"] = fspta->storeTime;
+    /// per-node times are only taken with -profile
+    if (Profiler::isEnabled()) {
+        timeStatMap["ProcessTime"] = fspta->processTime;
+        timeStatMap["PropagationTime"] = fspta->propagationTime;
+        timeStatMap["DirectPropaTime"] = fspta->directPropaTime;
+        timeStatMap["IndirectPropaTime"] = fspta->indirectPropaTime;
+        timeStatMap["Strong/WeakUpdTime"] = fspta->updateTime;
+        timeStatMap["AddrTime"] = fspta->addrTime;
+        timeStatMap["CopyGepTime"] = fspta->copyGepTime;
+        timeStatMap["LoadTime"] = fspta->loadTime;
+        timeStatMap["StoreTime"] = fspta->storeTime;
+    }
     timeStatMap["UpdateCGTime"] = fspta->updateCallGraphTime;
 
     PTNumStatMap[TotalNumOfPointers] = pag->getValueNodeNum() + pag->getFieldValNodeNum();
@@ -426,8 +430,8 @@ void FlowSensitiveStat::calculateAddrVarPts(NodeID pointer, const SVFGNode* svfg
 /*!
  * Print all statistics
  */
-void FlowSensitiveStat::printStat() {
+void FlowSensitiveStat::printStat(std::string statname) {
 
     std::cout << "\n****Flow-Sensitive Pointer Analysis Statistics****\n";
-    PTAStat::printStat();
+    PTAStat::printStat("FlowSensitive");
 }
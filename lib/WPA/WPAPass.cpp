@@ -42,6 +42,7 @@ static cl::bits<PointerAnalysis::PTATY> PASelected(cl::desc("Select pointer anal
             clEnumValN(PointerAnalysis::AndersenLCD_WPA, "lander", "Lazy cycle detection inclusion-based analysis"),
             clEnumValN(PointerAnalysis::AndersenWave_WPA, "wander", "Wave propagation inclusion-based analysis"),
             clEnumValN(PointerAnalysis::AndersenWaveDiff_WPA, "ander", "Diff wave propagation inclusion-based analysis"),
+            clEnumValN(PointerAnalysis::AndersenParallel_WPA, "pander", "Parallel work-stealing inclusion-based analysis"),
             clEnumValN(PointerAnalysis::FSSPARSE_WPA, "fspta", "Sparse flow sensitive pointer analysis"),
             clEnumValEnd));
 
@@ -100,6 +101,9 @@ void WPAPass::runPointerAnalysis(llvm::Module& module, u32_t kind)
     case PointerAnalysis::AndersenWaveDiff_WPA:
         _pta = new AndersenWaveDiff();
         break;
+    case PointerAnalysis::AndersenParallel_WPA:
+        _pta = new AndersenParallel();
+        break;
     case PointerAnalysis::FSSPARSE_WPA:
         _pta = new FlowSensitive();
         break;
@@ -155,3 +159,43 @@ llvm::AliasResult WPAPass::alias(const Value* V1, const Value* V2) {
 
     return result;
 }
+
+/*!
+ * Return alias results of a batch of queries, combined in the same way as a single query
+ */
+void WPAPass::alias(const AliasQueryList& queries, AliasResultList& results) {
+
+    bool veto = (AliasRule.getBits() == 0 || AliasRule.isSet(Veto));
+    results.assign(queries.size(), MayAlias);
+
+    PAG* pag = _pta->getPAG();
+
+    /// Only the queries whose Values both have PAG nodes are answered by the pointer analyses,
+    /// the others are MayAlias (see the single query version)
+    AliasQueryList validQueries;
+    std::vector<u32_t> validIdx;
+    for (u32_t i = 0; i < queries.size(); i++) {
+        if (pag->hasValueNode(queries[i].first) && pag->hasValueNode(queries[i].second)) {
+            validQueries.push_back(queries[i]);
+            validIdx.push_back(i);
+        }
+    }
+    if (validQueries.empty())
+        return;
+
+    /// Veto starts from MayAlias and Conservative starts from NoAlias
+    for (u32_t i = 0; i < validIdx.size(); i++)
+        results[validIdx[i]] = veto ? MayAlias : NoAlias;
+
+    AliasResultList ptaResults;
+    for (PTAVector::const_iterator it = ptaVector.begin(), eit = ptaVector.end();
+            it != eit; ++it) {
+        (*it)->alias(validQueries, ptaResults);
+        for (u32_t i = 0; i < validIdx.size(); i++) {
+            if (veto && ptaResults[i] == NoAlias)
+                results[validIdx[i]] = NoAlias;
+            else if (!veto && ptaResults[i] == MayAlias)
+                results[validIdx[i]] = MayAlias;
+        }
+    }
+}
@@ -0,0 +1,134 @@
+//===- aliasbench.cpp -- Alias query throughput benchmark ---------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===-----------------------------------------------------------------------===//
+
+/*
+ // Run Andersen's analysis on a module, then ask whether every two pointers of
+ // a function alias, the way an optimization pass querying WPAPass does. Report
+ // the throughput of the queries answered from scratch, answered from the cache
+ // of field-expanded points-to sets, and answered by the batch interface, and
+ // check that all of them give the same results.
+ */
+
+#include "WPA/Andersen.h"
+
+#include <llvm/Support/CommandLine.h>	// for cl
+#include <llvm/Support/Signals.h>	// singal for command line
+#include <llvm/IRReader/IRReader.h>	// IR reader for bit file
+#include <llvm/Support/PrettyStackTrace.h> // for pass list
+#include <llvm/IR/LLVMContext.h>		// for llvm LLVMContext
+#include <llvm/IR/InstIterator.h>	// for inst iteration
+#include <llvm/Support/SourceMgr.h> // for SMDiagnostic
+#include <llvm/Support/Format.h>		// for format
+#include <llvm/Support/raw_ostream.h>
+
+using namespace llvm;
+
+static cl::opt<std::string> InputFilename(cl::Positional,
+        cl::desc("<input bitcode>"), cl::init("-"));
+
+static cl::opt<unsigned> MaxPtrsPerFun("ptrs-per-fun", cl::init(64),
+                                      cl::desc("Number of pointers of a function whose pairs are queried"));
+
+static cl::opt<unsigned> Repeat("repeat", cl::init(3),
+                                cl::desc("Number of times the queries are answered"));
+
+/*!
+ * Pairs of pointers of the same function
+ */
+static void collectQueries(Module& module, PAG* pag, PointerAnalysis::AliasQueryList& queries) {
+    for (Module::iterator fit = module.begin(), efit = module.end(); fit != efit; ++fit) {
+        std::vector<const Value*> ptrs;
+        for (inst_iterator it = inst_begin(*fit), eit = inst_end(*fit); it != eit && ptrs.size() < MaxPtrsPerFun; ++it) {
+            const Instruction* inst = &*it;
+            if (inst->getType()->isPointerTy() && pag->hasValueNode(inst))
+                ptrs.push_back(inst);
+        }
+        for (u32_t i = 0; i < ptrs.size(); i++) {
+            for (u32_t j = i + 1; j < ptrs.size(); j++)
+                queries.push_back(std::make_pair(ptrs[i], ptrs[j]));
+        }
+    }
+}
+
+/*!
+ * Answer the queries one by one Repeat times, return the elapsed time in ms
+ */
+static double answer(PointerAnalysis* pta, const PointerAnalysis::AliasQueryList& queries,
+                     PointerAnalysis::AliasResultList& results) {
+    double start = CLOCK_IN_MS();
+    for (unsigned r = 0; r < Repeat; r++) {
+        results.clear();
+        for (PointerAnalysis::AliasQueryList::const_iterator it = queries.begin(), eit = queries.end(); it != eit; ++it)
+            results.push_back(pta->alias(it->first, it->second));
+    }
+    return CLOCK_IN_MS() - start;
+}
+
+/*!
+ * Answer the queries as a batch Repeat times, return the elapsed time in ms
+ */
+static double answerBatch(PointerAnalysis* pta, const PointerAnalysis::AliasQueryList& queries,
+                          PointerAnalysis::AliasResultList& results) {
+    double start = CLOCK_IN_MS();
+    for (unsigned r = 0; r < Repeat; r++)
+        pta->alias(queries, results);
+    return CLOCK_IN_MS() - start;
+}
+
+/// Queries answered per second
+static inline double throughput(size_t num, double time) {
+    return time > 0 ? num * Repeat * 1000.0 / time : 0;
+}
+
+int main(int argc, char ** argv) {
+
+    sys::PrintStackTraceOnErrorSignal();
+    llvm::PrettyStackTraceProgram X(argc, argv);
+
+    LLVMContext &Context = getGlobalContext();
+
+    cl::ParseCommandLineOptions(argc, argv, "Alias Query Throughput Benchmark\n");
+
+    SMDiagnostic Err;
+
+    // Load the input module...
+    std::unique_ptr<Module> M1 = parseIRFile(InputFilename, Err, Context);
+
+    if (!M1) {
+        Err.print(argv[0], errs());
+        return 1;
+    }
+
+    AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(*M1.get());
+
+    PointerAnalysis::AliasQueryList queries;
+    collectQueries(*M1.get(), ander->getPAG(), queries);
+
+    PointerAnalysis::AliasResultList results, cachedResults, batchResults;
+    ander->disableAliasCache();
+    double time = answer(ander, queries, results);
+    ander->enableAliasCache();
+    double cachedTime = answer(ander, queries, cachedResults);
+    ander->enableAliasCache();
+    double batchTime = answerBatch(ander, queries, batchResults);
+
+    outs() << "Queries               " << queries.size() << " x " << Repeat << "\n";
+    outs() << "                      time            queries/s\n";
+    outs() << "Uncached              " << format("%10.2f ms  %12.0f\n", time, throughput(queries.size(), time));
+    outs() << "Cached                " << format("%10.2f ms  %12.0f\n", cachedTime, throughput(queries.size(), cachedTime));
+    outs() << "Batch                 " << format("%10.2f ms  %12.0f\n", batchTime, throughput(queries.size(), batchTime));
+
+    AndersenWaveDiff::releaseAndersenWaveDiff();
+
+    if (results != cachedResults || results != batchResults) {
+        errs() << "Cached alias queries give different results!\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,208 @@
+//===- graphbench.cpp -- Graph edge container micro-benchmark -----------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===-----------------------------------------------------------------------===//
+
+/*
+ // Build a synthetic graph on GenericNode, whose edges are kept in sorted vectors,
+ // and the same graph on nodes keeping their edges in std::set as GenericNode
+ // used to. Report the time of adding the edges, iterating the outgoing edges of
+ // every node (the inner loop of the solvers) and looking edges up, and check
+ // that both layouts visit the same edges in the same order.
+ */
+
+#include "MemoryModel/GenericGraph.h"
+
+#include <llvm/Support/CommandLine.h>	// for cl
+#include <llvm/Support/Signals.h>	// singal for command line
+#include <llvm/Support/PrettyStackTrace.h> // for pass list
+#include <llvm/Support/Format.h>		// for format
+#include <llvm/Support/raw_ostream.h>
+
+using namespace llvm;
+
+static cl::opt<unsigned> NumOfNodes("nodes", cl::init(100000),
+                                    cl::desc("Number of nodes of the graph"));
+
+static cl::opt<unsigned> Degree("degree", cl::init(8),
+                                cl::desc("Number of outgoing edges per node"));
+
+static cl::opt<unsigned> Kinds("kinds", cl::init(4),
+                               cl::desc("Number of edge kinds"));
+
+static cl::opt<unsigned> Repeat("repeat", cl::init(20),
+                                cl::desc("Number of times the edges are iterated and looked up"));
+
+class BenchNode;
+
+/*!
+ * Edge and node of the graph using GenericNode
+ */
+typedef GenericEdge<BenchNode> GenericBenchEdgeTy;
+class BenchEdge : public GenericBenchEdgeTy {
+public:
+    BenchEdge(BenchNode* s, BenchNode* d, GEdgeFlag k) : GenericBenchEdgeTy(s, d, k) {}
+};
+
+typedef GenericNode<BenchNode, BenchEdge> GenericBenchNodeTy;
+class BenchNode : public GenericBenchNodeTy {
+public:
+    BenchNode(NodeID i) : GenericBenchNodeTy(i, 0) {}
+};
+
+/*!
+ * Node keeping its edges in std::set, the layout GenericNode used before
+ */
+struct RefNode {
+    typedef GenericBenchNodeTy::GEdgeSetTy EdgeSetTy;
+    ~RefNode() {
+        for (EdgeSetTy::iterator it = inEdges.begin(), eit = inEdges.end(); it != eit; ++it)
+            delete *it;
+    }
+    EdgeSetTy inEdges;
+    EdgeSetTy outEdges;
+};
+
+/// Random edges are generated by a fixed LCG so that runs are comparable
+static inline u64_t nextRand(u64_t& seed) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return seed >> 33;
+}
+
+/*!
+ * Add the same edges to both graphs, return the elapsed time in ms of each.
+ * The edges of the reference graph connect the nodes of the other graph, only
+ * the containers holding them differ.
+ */
+static void buildGraphs(std::vector<BenchNode*>& nodes, std::vector<RefNode*>& refNodes,
+                        double& time, double& refTime) {
+    for (NodeID i = 0; i < NumOfNodes; i++) {
+        nodes.push_back(new BenchNode(i));
+        refNodes.push_back(new RefNode());
+    }
+
+    u64_t seed = 1;
+    std::vector<BenchEdge*> edges, refEdges;
+    for (NodeID i = 0; i < NumOfNodes; i++) {
+        for (unsigned d = 0; d < Degree; d++) {
+            BenchNode* dst = nodes[nextRand(seed) % NumOfNodes];
+            BenchEdge::GEdgeFlag kind = nextRand(seed) % Kinds;
+            edges.push_back(new BenchEdge(nodes[i], dst, kind));
+            refEdges.push_back(new BenchEdge(nodes[i], dst, kind));
+        }
+    }
+
+    double start = CLOCK_IN_MS();
+    for (std::vector<BenchEdge*>::iterator it = edges.begin(), eit = edges.end(); it != eit; ++it) {
+        BenchEdge* edge = *it;
+        if (edge->getSrcNode()->addOutgoingEdge(edge))
+            edge->getDstNode()->addIncomingEdge(edge);
+    }
+    time = CLOCK_IN_MS() - start;
+
+    start = CLOCK_IN_MS();
+    for (std::vector<BenchEdge*>::iterator it = refEdges.begin(), eit = refEdges.end(); it != eit; ++it) {
+        BenchEdge* edge = *it;
+        if (refNodes[edge->getSrcID()]->outEdges.insert(edge).second)
+            refNodes[edge->getDstID()]->inEdges.insert(edge);
+    }
+    refTime = CLOCK_IN_MS() - start;
+
+    /// duplicated edges are not added
+    for (std::vector<BenchEdge*>::iterator it = edges.begin(), eit = edges.end(); it != eit; ++it) {
+        if ((*it)->getSrcNode()->hasOutgoingEdge(*it) != *it)
+            delete *it;
+    }
+    for (std::vector<BenchEdge*>::iterator it = refEdges.begin(), eit = refEdges.end(); it != eit; ++it) {
+        if (*refNodes[(*it)->getSrcID()]->outEdges.find(*it) != *it)
+            delete *it;
+    }
+}
+
+/*!
+ * Iterate the outgoing edges of every node Repeat times, return the elapsed time in ms
+ */
+template<class NodeTy, class Iterator, Iterator (*Begin)(NodeTy*), Iterator (*End)(NodeTy*)>
+static double iterate(std::vector<NodeTy*>& nodes, u64_t& checksum) {
+    checksum = 0;
+    double start = CLOCK_IN_MS();
+    for (unsigned r = 0; r < Repeat; r++) {
+        for (typename std::vector<NodeTy*>::iterator nit = nodes.begin(), neit = nodes.end(); nit != neit; ++nit) {
+            for (Iterator it = Begin(*nit), eit = End(*nit); it != eit; ++it)
+                checksum = checksum * 31 + (*it)->getDstID();
+        }
+    }
+    return CLOCK_IN_MS() - start;
+}
+
+static inline BenchNode::iterator outBegin(BenchNode* node) {
+    return node->OutEdgeBegin();
+}
+static inline BenchNode::iterator outEnd(BenchNode* node) {
+    return node->OutEdgeEnd();
+}
+static inline RefNode::EdgeSetTy::iterator refOutBegin(RefNode* node) {
+    return node->outEdges.begin();
+}
+static inline RefNode::EdgeSetTy::iterator refOutEnd(RefNode* node) {
+    return node->outEdges.end();
+}
+
+/*!
+ * Look up random edges Repeat times each node, return the elapsed time in ms
+ */
+static double lookup(std::vector<BenchNode*>& nodes, std::vector<RefNode*>& refNodes, bool ref, u64_t& found) {
+    found = 0;
+    u64_t seed = 7;
+    double start = CLOCK_IN_MS();
+    for (unsigned r = 0; r < Repeat; r++) {
+        for (NodeID i = 0; i < NumOfNodes; i++) {
+            BenchEdge probe(nodes[i], nodes[nextRand(seed) % NumOfNodes], nextRand(seed) % Kinds);
+            if (ref)
+                found += refNodes[i]->outEdges.count(&probe);
+            else
+                found += nodes[i]->hasOutgoingEdge(&probe) != NULL;
+        }
+    }
+    return CLOCK_IN_MS() - start;
+}
+
+int main(int argc, char ** argv) {
+
+    sys::PrintStackTraceOnErrorSignal();
+    llvm::PrettyStackTraceProgram X(argc, argv);
+
+    cl::ParseCommandLineOptions(argc, argv, "Graph Edge Container Micro-benchmark\n");
+
+    std::vector<BenchNode*> nodes;
+    std::vector<RefNode*> refNodes;
+    double addTime, refAddTime;
+    buildGraphs(nodes, refNodes, addTime, refAddTime);
+
+    u64_t sum, refSum, found, refFound;
+    double iterTime = iterate<BenchNode, BenchNode::iterator, outBegin, outEnd>(nodes, sum);
+    double refIterTime = iterate<RefNode, RefNode::EdgeSetTy::iterator, refOutBegin, refOutEnd>(refNodes, refSum);
+    double lookupTime = lookup(nodes, refNodes, false, found);
+    double refLookupTime = lookup(nodes, refNodes, true, refFound);
+
+    outs() << "Nodes                 " << NumOfNodes << " x " << Degree << " edges\n";
+    outs() << "                      sorted vector   std::set\n";
+    outs() << "Add edges             " << format("%10.2f ms  %10.2f ms\n", addTime, refAddTime);
+    outs() << "Iterate out edges     " << format("%10.2f ms  %10.2f ms\n", iterTime, refIterTime);
+    outs() << "Look up edges         " << format("%10.2f ms  %10.2f ms\n", lookupTime, refLookupTime);
+
+    for (NodeID i = 0; i < NumOfNodes; i++) {
+        delete refNodes[i];
+        delete nodes[i];
+    }
+
+    if (sum != refSum || found != refFound) {
+        errs() << "Edge containers hold different edges!\n";
+        return 1;
+    }
+    return 0;
+}
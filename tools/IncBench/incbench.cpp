@@ -0,0 +1,145 @@
+//===- incbench.cpp -- Incremental Andersen re-solve benchmark ---------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===-----------------------------------------------------------------------===//
+
+/*
+ // Run Andersen's analysis on a module, then edit its functions one by one the
+ // way an IDE does: remove the PAG edges of all instructions of a function,
+ // re-solve incrementally, add them back and re-solve again. Report the time of
+ // the re-solves against the initial solve, and check that the points-to sets
+ // are the same as the initial ones once every edit has been undone.
+ // With -ander-inc-verify every re-solve is also compared with a solve from
+ // scratch (and its time includes that solve).
+ */
+
+#include "WPA/Andersen.h"
+
+#include <llvm/Support/CommandLine.h>	// for cl
+#include <llvm/Support/Signals.h>	// singal for command line
+#include <llvm/IRReader/IRReader.h>	// IR reader for bit file
+#include <llvm/Support/PrettyStackTrace.h> // for pass list
+#include <llvm/IR/LLVMContext.h>		// for llvm LLVMContext
+#include <llvm/IR/InstIterator.h>	// for inst iteration
+#include <llvm/Support/SourceMgr.h> // for SMDiagnostic
+#include <llvm/Support/Format.h>		// for format
+#include <llvm/Support/raw_ostream.h>
+
+using namespace llvm;
+
+static cl::opt<std::string> InputFilename(cl::Positional,
+        cl::desc("<input bitcode>"), cl::init("-"));
+
+static cl::opt<unsigned> NumOfEdits("edits", cl::init(10),
+                                    cl::desc("Number of functions edited, the ones with the most PAG edges first"));
+
+typedef std::pair<const Function*, PAGEdge::PAGEdgeSetTy> FunEdges;
+
+/*!
+ * PAG edges of the instructions of each function with a body
+ */
+static void collectFunEdges(Module& module, PAG* pag, std::vector<FunEdges>& funEdges) {
+    for (Module::iterator fit = module.begin(), efit = module.end(); fit != efit; ++fit) {
+        const Function* fun = &*fit;
+        PAGEdge::PAGEdgeSetTy edges;
+        for (const_inst_iterator it = inst_begin(fun), eit = inst_end(fun); it != eit; ++it) {
+            const Instruction* inst = &*it;
+            if (!pag->hasPAGEdgeList(inst))
+                continue;
+            PAG::PAGEdgeList& edgeList = pag->getInstPAGEdgeList(inst);
+            for (PAG::PAGEdgeList::const_iterator edgeIt = edgeList.begin(), edgeEit = edgeList.end(); edgeIt != edgeEit; ++edgeIt)
+                edges.insert(const_cast<PAGEdge*>(*edgeIt));
+        }
+        if (!edges.empty())
+            funEdges.push_back(std::make_pair(fun, edges));
+    }
+}
+
+/// Functions with more PAG edges first
+static bool moreEdges(const FunEdges& lhs, const FunEdges& rhs) {
+    return lhs.second.size() > rhs.second.size();
+}
+
+/*!
+ * Remove (add == false) or add back the PAG edges of a function and re-solve, return the elapsed time in ms
+ */
+static double resolve(Andersen* ander, const FunEdges& funEdges, bool add) {
+    Andersen::FunToPAGEdgeDiffMap diffs;
+    Andersen::PAGEdgeDiff& diff = diffs[funEdges.first];
+    if (add)
+        diff.addedEdges = funEdges.second;
+    else
+        diff.removedEdges = funEdges.second;
+
+    double start = CLOCK_IN_MS();
+    ander->solveIncrementally(diffs);
+    return CLOCK_IN_MS() - start;
+}
+
+int main(int argc, char ** argv) {
+
+    sys::PrintStackTraceOnErrorSignal();
+    llvm::PrettyStackTraceProgram X(argc, argv);
+
+    LLVMContext &Context = getGlobalContext();
+
+    cl::ParseCommandLineOptions(argc, argv, "Incremental Andersen Re-solve Benchmark\n");
+
+    SMDiagnostic Err;
+
+    // Load the input module...
+    std::unique_ptr<Module> M1 = parseIRFile(InputFilename, Err, Context);
+
+    if (!M1) {
+        Err.print(argv[0], errs());
+        return 1;
+    }
+
+    Andersen* ander = new Andersen();
+    double start = CLOCK_IN_MS();
+    ander->analyze(*M1.get());
+    double solveTime = CLOCK_IN_MS() - start;
+
+    PAG* pag = ander->getPAG();
+    std::map<NodeID, PointsTo> initialPts;
+    for (PAG::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+        initialPts[it->first] = ander->getConstPts(it->first);
+
+    std::vector<FunEdges> funEdges;
+    collectFunEdges(*M1.get(), pag, funEdges);
+    std::stable_sort(funEdges.begin(), funEdges.end(), moreEdges);
+    if (funEdges.size() > NumOfEdits)
+        funEdges.resize(NumOfEdits);
+
+    outs() << "Initial solve         " << format("%10.2f ms\n", solveTime);
+    outs() << "  edges      remove         add  function\n";
+    double removeTotal = 0;
+    double addTotal = 0;
+    for (std::vector<FunEdges>::const_iterator it = funEdges.begin(), eit = funEdges.end(); it != eit; ++it) {
+        double removeTime = resolve(ander, *it, false);
+        double addTime = resolve(ander, *it, true);
+        removeTotal += removeTime;
+        addTotal += addTime;
+        outs() << format("%7u %8.2f ms %8.2f ms  ", (unsigned)it->second.size(), removeTime, addTime)
+               << it->first->getName() << "\n";
+    }
+    outs() << format("        %8.2f ms %8.2f ms  total\n", removeTotal, addTotal);
+
+    u32_t numOfMismatches = 0;
+    for (std::map<NodeID, PointsTo>::const_iterator it = initialPts.begin(), eit = initialPts.end(); it != eit; ++it) {
+        if (it->second != ander->getConstPts(it->first))
+            numOfMismatches++;
+    }
+
+    delete ander;
+
+    if (numOfMismatches) {
+        errs() << "Points-to sets of " << numOfMismatches << " nodes differ from the initial ones after undoing the edits!\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+//===- mrbench.cpp -- Memory region partitioning benchmark --------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===-----------------------------------------------------------------------===//
+
+/*
+ // Run Andersen's analysis on a module once, then generate its memory regions
+ // with every partitioning strategy of -mempar (and the superset partitioning of
+ // MRGenerator). Report the number of regions, the time of partitioning the
+ // points-to sets and the time of the whole region generation of each strategy.
+ */
+
+#include "MSSA/MemPartition.h"
+#include "WPA/Andersen.h"
+
+#include <llvm/Support/CommandLine.h>	// for cl
+#include <llvm/Support/Signals.h>	// singal for command line
+#include <llvm/IRReader/IRReader.h>	// IR reader for bit file
+#include <llvm/Support/PrettyStackTrace.h> // for pass list
+#include <llvm/IR/LLVMContext.h>		// for llvm LLVMContext
+#include <llvm/Support/SourceMgr.h> // for SMDiagnostic
+#include <llvm/Support/Format.h>		// for format
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+
+using namespace llvm;
+
+static cl::opt<std::string> InputFilename(cl::Positional,
+        cl::desc("<input bitcode>"), cl::init("-"));
+
+static cl::list<std::string> Strategies("strategy", cl::CommaSeparated,
+                                        cl::desc("Partition strategies to run (superset, distinct, intra-disjoint, inter-disjoint), all by default"));
+
+/*!
+ * A region generator recording the time of partitioning regions
+ */
+template<class MRG>
+class TimedMRG : public MRG {
+public:
+    TimedMRG(BVDataPTAImpl* p) : MRG(p), partitionTime(0) {}
+
+    inline double getPartitionTime() const {
+        return partitionTime;
+    }
+
+protected:
+    virtual void partitionMRs() {
+        double start = CLOCK_IN_MS();
+        MRG::partitionMRs();
+        partitionTime = CLOCK_IN_MS() - start;
+    }
+
+private:
+    double partitionTime;
+};
+
+/*!
+ * Generate the regions of a strategy and print one row of the report
+ */
+template<class MRG>
+static void runStrategy(const std::string& name, BVDataPTAImpl* pta) {
+    if (!Strategies.empty() && std::find(Strategies.begin(), Strategies.end(), name) == Strategies.end())
+        return;
+
+    TimedMRG<MRG>* mrGen = new TimedMRG<MRG>(pta);
+    double start = CLOCK_IN_MS();
+    mrGen->generateMRs();
+    double total = CLOCK_IN_MS() - start;
+
+    outs() << format("%-16s %10u %12.2f ms %12.2f ms\n", name.c_str(), (unsigned)mrGen->getMRNum(),
+                     mrGen->getPartitionTime(), total);
+    delete mrGen;
+}
+
+int main(int argc, char ** argv) {
+
+    sys::PrintStackTraceOnErrorSignal();
+    llvm::PrettyStackTraceProgram X(argc, argv);
+
+    LLVMContext &Context = getGlobalContext();
+
+    cl::ParseCommandLineOptions(argc, argv, "Memory Region Partitioning Benchmark\n");
+
+    SMDiagnostic Err;
+
+    // Load the input module...
+    std::unique_ptr<Module> M1 = parseIRFile(InputFilename, Err, Context);
+
+    if (!M1) {
+        Err.print(argv[0], errs());
+        return 1;
+    }
+
+    double start = CLOCK_IN_MS();
+    AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(*M1.get());
+    double anderTime = CLOCK_IN_MS() - start;
+
+    outs() << "Strategy            Regions       Partition        Generate\n";
+    runStrategy<MRGenerator>("superset", ander);
+    runStrategy<DistinctMRG>("distinct", ander);
+    runStrategy<IntraDisjointMRG>("intra-disjoint", ander);
+    runStrategy<InterDisjointMRG>("inter-disjoint", ander);
+    outs() << "Andersen                    " << format("%12.2f ms\n", anderTime);
+
+    AndersenWaveDiff::releaseAndersenWaveDiff();
+    return 0;
+}
@@ -16,6 +16,7 @@
 #include "SABER/LeakChecker.h"
 #include "SABER/FileChecker.h"
 #include "SABER/DoubleFreeChecker.h"
+#include "Util/Profiler.h"
 
 #include <llvm/Support/CommandLine.h>	// for cl
 #include <llvm/Bitcode/BitcodeWriterPass.h>  // for bitcode write
@@ -106,6 +107,8 @@ int main(int argc, char ** argv) {
     Passes.run(*M1.get());
     Out->keep();
 
+    Profiler::report();
+
     return 0;
 
 }
@@ -0,0 +1,178 @@
+//===- sccbench.cpp -- SCC detection micro-benchmark --------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===-----------------------------------------------------------------------===//
+
+/*
+ // Run the iterative SCCDetection and the recursive one it replaced on a
+ // synthetic graph, report the time of each and check that both find the same
+ // reps and topological order.
+ //
+ // A "chain" graph is a path of nodes with a back edge closing every -cycle nodes,
+ // it is as deep as the number of nodes. The recursive detection needs a call stack
+ // deep enough for it (e.g. ulimit -s unlimited), or run with -reference=false.
+ */
+
+#include "Util/BasicTypes.h"
+#include "Util/SCC.h"
+#include "RecursiveSCC.h"
+
+#include <llvm/Support/CommandLine.h>	// for cl
+#include <llvm/Support/Signals.h>	// singal for command line
+#include <llvm/Support/PrettyStackTrace.h> // for pass list
+#include <llvm/Support/Format.h>		// for format
+#include <llvm/Support/raw_ostream.h>
+
+using namespace llvm;
+
+enum BenchGraphKind {
+    ChainGraph,
+    RandomGraph
+};
+
+static cl::opt<BenchGraphKind> GraphKind("graph", cl::init(RandomGraph),
+        cl::desc("Shape of the synthetic graph"),
+        cl::values(
+            clEnumValN(ChainGraph, "chain", "A path with a back edge every -cycle nodes"),
+            clEnumValN(RandomGraph, "random", "Random edges, -degree per node"),
+            clEnumValEnd));
+
+static cl::opt<unsigned> NumOfNodes("nodes", cl::init(100000),
+                                    cl::desc("Number of nodes of the graph"));
+
+static cl::opt<unsigned> Degree("degree", cl::init(2),
+                                cl::desc("Number of outgoing edges per node of a random graph"));
+
+static cl::opt<unsigned> CycleLen("cycle", cl::init(8),
+                                  cl::desc("Number of nodes per cycle of a chain graph"));
+
+static cl::opt<unsigned> Repeat("repeat", cl::init(10),
+                                cl::desc("Number of times the SCCs are detected"));
+
+static cl::opt<bool> Reference("reference", cl::init(true),
+                               cl::desc("Also run the recursive SCC detection"));
+
+/*!
+ * Adjacency list graph
+ */
+struct BenchNode {
+    BenchNode(NodeID i) : id(i) {}
+    NodeID id;
+    std::vector<BenchNode*> succs;
+};
+
+struct BenchGraph {
+    ~BenchGraph() {
+        for (std::vector<BenchNode*>::iterator it = nodes.begin(), eit = nodes.end(); it != eit; ++it)
+            delete *it;
+    }
+    std::vector<BenchNode*> nodes;
+};
+
+namespace llvm {
+template<> struct GraphTraits<BenchGraph*> {
+    typedef BenchNode NodeType;
+    typedef std::vector<BenchNode*>::iterator ChildIteratorType;
+    typedef std::vector<BenchNode*>::iterator nodes_iterator;
+
+    static inline ChildIteratorType direct_child_begin(NodeType* N) {
+        return N->succs.begin();
+    }
+    static inline ChildIteratorType direct_child_end(NodeType* N) {
+        return N->succs.end();
+    }
+    static inline nodes_iterator nodes_begin(BenchGraph* G) {
+        return G->nodes.begin();
+    }
+    static inline nodes_iterator nodes_end(BenchGraph* G) {
+        return G->nodes.end();
+    }
+    static inline NodeType* getNode(BenchGraph* G, NodeID id) {
+        return G->nodes[id];
+    }
+    static inline unsigned getNodeID(NodeType* N) {
+        return N->id;
+    }
+};
+}
+
+/*!
+ * Build the graph, random edges are generated by a fixed LCG so that runs are comparable
+ */
+static void buildGraph(BenchGraph& graph) {
+    for (NodeID i = 0; i < NumOfNodes; i++)
+        graph.nodes.push_back(new BenchNode(i));
+
+    if (GraphKind == ChainGraph) {
+        for (NodeID i = 0; i + 1 < NumOfNodes; i++) {
+            graph.nodes[i]->succs.push_back(graph.nodes[i + 1]);
+            if (CycleLen > 1 && i % CycleLen == CycleLen - 1)
+                graph.nodes[i]->succs.push_back(graph.nodes[i + 1 - CycleLen]);
+        }
+    }
+    else {
+        u64_t seed = 1;
+        for (NodeID i = 0; i < NumOfNodes; i++) {
+            for (unsigned d = 0; d < Degree; d++) {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                graph.nodes[i]->succs.push_back(graph.nodes[(seed >> 33) % NumOfNodes]);
+            }
+        }
+    }
+}
+
+/*!
+ * Detect SCCs Repeat times and return the elapsed time in ms.
+ * The checksum of reps and topological order makes sure both detections agree.
+ */
+template<class SCC>
+static double detect(BenchGraph& graph, u64_t& checksum) {
+    SCC scc(&graph);
+    double start = CLOCK_IN_MS();
+    for (unsigned r = 0; r < Repeat; r++)
+        scc.find();
+    double time = CLOCK_IN_MS() - start;
+
+    checksum = 0;
+    for (NodeID i = 0; i < NumOfNodes; i++)
+        checksum = checksum * 31 + scc.repNode(i);
+    NodeStack& topo = scc.topoNodeStack();
+    while (!topo.empty()) {
+        checksum = checksum * 31 + topo.top();
+        topo.pop();
+    }
+    return time;
+}
+
+int main(int argc, char ** argv) {
+
+    sys::PrintStackTraceOnErrorSignal();
+    llvm::PrettyStackTraceProgram X(argc, argv);
+
+    cl::ParseCommandLineOptions(argc, argv, "SCC Detection Micro-benchmark\n");
+
+    BenchGraph graph;
+    buildGraph(graph);
+
+    u64_t iterSum = 0, recSum = 0;
+    double iterTime = detect<SCCDetection<BenchGraph*> >(graph, iterSum);
+
+    outs() << "Nodes                 " << NumOfNodes << " x " << Repeat << "\n";
+    outs() << "SCCDetection          " << format("%.2f", iterTime) << " ms\n";
+
+    if (!Reference)
+        return 0;
+
+    double recTime = detect<RecursiveSCCDetection<BenchGraph*> >(graph, recSum);
+    outs() << "RecursiveSCCDetection " << format("%.2f", recTime) << " ms\n";
+
+    if (iterSum != recSum) {
+        errs() << "SCC detections found different SCCs!\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+//===- wlbench.cpp -- Worklist micro-benchmark --------------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===-----------------------------------------------------------------------===//
+
+/*
+ // Replay a worklist trace recorded by the constraint solver (-wl-trace)
+ // against FIFOWorkList and DenseFIFOWorkList and report the time of each.
+ //
+ // Trace format: one operation per line, "+ id" for push and "-" for pop.
+ */
+
+#include "Util/BasicTypes.h"
+#include "Util/WorkList.h"
+
+#include <llvm/Support/CommandLine.h>	// for cl
+#include <llvm/Support/MemoryBuffer.h>	// for trace file
+#include <llvm/Support/Signals.h>	// singal for command line
+#include <llvm/Support/PrettyStackTrace.h> // for pass list
+#include <llvm/Support/Format.h>		// for format
+#include <llvm/Support/raw_ostream.h>
+
+using namespace llvm;
+
+static cl::opt<std::string> TraceFilename(cl::Positional,
+        cl::desc("<worklist trace>"), cl::Required);
+
+static cl::opt<unsigned> Repeat("repeat", cl::init(10),
+                                cl::desc("Number of times each trace is replayed"));
+
+/// A trace operation, pushed id or PopOp
+typedef std::vector<NodeID> TraceTy;
+static const NodeID PopOp = ~0U;
+
+/*!
+ * Read the trace file into memory so that parsing is not measured
+ */
+static bool readTrace(StringRef filename, TraceTy& trace) {
+    ErrorOr<std::unique_ptr<MemoryBuffer> > buf = MemoryBuffer::getFile(filename);
+    if (std::error_code ec = buf.getError()) {
+        errs() << "can not open trace file " << filename << ": " << ec.message() << "\n";
+        return false;
+    }
+
+    StringRef content = (*buf)->getBuffer();
+    while (!content.empty()) {
+        std::pair<StringRef, StringRef> split = content.split('\n');
+        StringRef line = split.first.trim();
+        content = split.second;
+        if (line.empty())
+            continue;
+        if (line[0] == '-') {
+            trace.push_back(PopOp);
+        }
+        else if (line[0] == '+') {
+            NodeID id;
+            if (line.drop_front(1).trim().getAsInteger(10, id)) {
+                errs() << "malformed trace line: " << line << "\n";
+                return false;
+            }
+            trace.push_back(id);
+        }
+        else {
+            errs() << "malformed trace line: " << line << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+ * Replay the trace on a worklist and return the elapsed time in ms.
+ * The checksum of popped elements makes sure both worklists pop the same sequence.
+ */
+template<class WorkList>
+static double replay(const TraceTy& trace, u64_t& checksum) {
+    double start = CLOCK_IN_MS();
+    for (unsigned r = 0; r < Repeat; r++) {
+        WorkList worklist;
+        checksum = 0;
+        for (TraceTy::const_iterator it = trace.begin(), eit = trace.end(); it != eit; ++it) {
+            if (*it == PopOp)
+                checksum = checksum * 31 + worklist.pop();
+            else
+                worklist.push(*it);
+        }
+    }
+    return CLOCK_IN_MS() - start;
+}
+
+int main(int argc, char ** argv) {
+
+    sys::PrintStackTraceOnErrorSignal();
+    llvm::PrettyStackTraceProgram X(argc, argv);
+
+    cl::ParseCommandLineOptions(argc, argv, "Worklist Micro-benchmark\n");
+
+    TraceTy trace;
+    if (!readTrace(TraceFilename, trace))
+        return 1;
+
+    u64_t setSum = 0, denseSum = 0;
+    double setTime = replay<FIFOWorkList<NodeID> >(trace, setSum);
+    double denseTime = replay<DenseFIFOWorkList<NodeID> >(trace, denseSum);
+
+    outs() << "Operations        " << trace.size() << " x " << Repeat << "\n";
+    outs() << "FIFOWorkList      " << format("%.2f", setTime) << " ms\n";
+    outs() << "DenseFIFOWorkList " << format("%.2f", denseTime) << " ms\n";
+
+    if (setSum != denseSum) {
+        errs() << "worklists popped different sequences!\n";
+        return 1;
+    }
+    return 0;
+}
@@ -14,6 +14,7 @@
  */
 
 #include "WPA/WPAPass.h"
+#include "Util/Profiler.h"
 
 #include <llvm/Support/CommandLine.h>	// for cl
 #include <llvm/Support/FileSystem.h>	// for sys::fs::F_None
@@ -93,6 +94,8 @@ int main(int argc, char ** argv) {
     Passes.run(*M1.get());
     Out->keep();
 
+    Profiler::report();
+
     return 0;
 
 }